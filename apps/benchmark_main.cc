@@ -0,0 +1,211 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "direction.h"
+#include "memoized_segment_machine.h"
+#include "packed_tape_machine.h"
+#include "run_result.h"
+#include "state.h"
+#include "turing_machine.h"
+
+using namespace turingmachinesimulator;
+
+namespace {
+
+/**
+ * vector storing the names of the halting states of every benchmark machine
+ */
+const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+    "qReject"};
+
+/**
+ * This function returns the state with the given id and name
+ *
+ * @param id an int representing the id of the state
+ * @param name a string representing the name of the state
+ * @return a State with the given id and name
+ */
+State MakeState(int id, const std::string &name) {
+  return State(id, name, glm::vec2(0, 0), 5, kHaltingStateNames);
+}
+
+/**
+ * This function runs the given function and returns how long it took
+ *
+ * @param function a function to time
+ * @return a double representing the number of seconds the function took
+ */
+template <typename Function>
+double TimeInSeconds(Function function) {
+  const std::chrono::steady_clock::time_point kStart =
+      std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()
+      - kStart).count();
+}
+
+/**
+ * This function prints 1 line of the results of a benchmark
+ *
+ * @param way_of_running a string describing how the machine was run
+ * @param num_steps a uint64_t representing the number of steps taken
+ * @param seconds a double representing the number of seconds taken
+ */
+void PrintResult(const std::string &way_of_running, uint64_t num_steps,
+    double seconds) {
+  std::printf("  %-36s %14llu steps %10.4f s %10.3g ns/step\n",
+      way_of_running.c_str(), static_cast<unsigned long long>(num_steps),
+      seconds, num_steps == 0 ? 0.0 : seconds * 1e9
+      / static_cast<double>(num_steps));
+}
+
+/**
+ * This function returns a binary counter: it moves right to the end of the
+ * number, then adds 1 to it moving left, forever
+ *
+ * @return a TuringMachine counting up from 0
+ */
+TuringMachine MakeBinaryCounter() {
+  const State kStateA = MakeState(1, "q1");
+  const State kStateB = MakeState(2, "q2");
+  const std::vector<Direction> kDirections = {
+      Direction('0', '0', 'r', kStateA, kStateA),
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('-', '-', 'l', kStateA, kStateB),
+      Direction('1', '0', 'l', kStateB, kStateB),
+      Direction('0', '1', 'r', kStateB, kStateA),
+      Direction('-', '1', 'r', kStateB, kStateA)};
+  return TuringMachine({kStateA, kStateB}, kDirections, {'0'}, '-',
+      kHaltingStateNames);
+}
+
+/**
+ * This function benchmarks Run against taking the same steps with Update
+ */
+void BenchmarkRun() {
+  const uint64_t kNumSteps = 20000000;
+  std::printf("run: binary counter, %llu steps\n",
+      static_cast<unsigned long long>(kNumSteps));
+  TuringMachine updated_machine = MakeBinaryCounter();
+  PrintResult("TuringMachine::Update", kNumSteps, TimeInSeconds([&]() {
+    for (uint64_t step = 0; step < kNumSteps; step++) {
+      updated_machine.Update();
+    }
+  }));
+  TuringMachine run_machine = MakeBinaryCounter();
+  RunResult result;
+  const double kSeconds = TimeInSeconds([&]() {
+    result = run_machine.Run(kNumSteps);
+  });
+  PrintResult("TuringMachine::Run", result.num_steps, kSeconds);
+}
+
+/**
+ * This function benchmarks MemoizedSegmentMachine against Run on regular
+ * machines (Run takes fewer steps, the time per step is what compares)
+ */
+void BenchmarkSegments() {
+  const State kStateA = MakeState(1, "q1");
+  const TuringMachine kRightMover = TuringMachine({kStateA},
+      {Direction('-', '1', 'r', kStateA, kStateA)}, {}, '-',
+      kHaltingStateNames);
+  const TuringMachine kBinaryCounter = MakeBinaryCounter();
+  const std::vector<std::pair<std::string, const TuringMachine *>>
+      kWorkloads = {{"machine writing right forever", &kRightMover},
+      {"binary counter", &kBinaryCounter}};
+  for (const std::pair<std::string, const TuringMachine *> &kWorkload
+      : kWorkloads) {
+    std::printf("segments: %s\n", kWorkload.first.c_str());
+    TuringMachine run_machine = *kWorkload.second;
+    RunResult result;
+    double seconds = TimeInSeconds([&]() {
+      result = run_machine.Run(20000000);
+    });
+    PrintResult("TuringMachine::Run", result.num_steps, seconds);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        *kWorkload.second);
+    seconds = TimeInSeconds([&]() {
+      result = memoized_segment_machine.Run(1000000000000);
+    });
+    PrintResult("MemoizedSegmentMachine::Run", result.num_steps, seconds);
+  }
+}
+
+/**
+ * This function benchmarks PackedTapeMachine against Run on a machine that
+ * sweeps over long runs of 1 character and on 1 that does not
+ */
+void BenchmarkPacked() {
+  const State kStateA = MakeState(1, "q1");
+  const State kStateB = MakeState(2, "q2");
+  // sweeps back and forth over a block of 1s, adding a 1 at each end
+  const TuringMachine kSweeper = TuringMachine({kStateA, kStateB}, {
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('0', '1', 'l', kStateA, kStateB),
+      Direction('1', '1', 'l', kStateB, kStateB),
+      Direction('0', '1', 'r', kStateB, kStateA)}, {}, '0',
+      kHaltingStateNames);
+  const TuringMachine kBinaryCounter = MakeBinaryCounter();
+  const std::vector<std::pair<std::string, const TuringMachine *>>
+      kWorkloads = {{"sweeper, 100000000 steps", &kSweeper},
+      {"binary counter, 20000000 steps", &kBinaryCounter}};
+  const uint64_t kNumSteps[] = {100000000, 20000000};
+  for (size_t i = 0; i < kWorkloads.size(); i++) {
+    std::printf("packed: %s\n", kWorkloads[i].first.c_str());
+    TuringMachine run_machine = *kWorkloads[i].second;
+    RunResult result;
+    double seconds = TimeInSeconds([&]() {
+      result = run_machine.Run(kNumSteps[i]);
+    });
+    PrintResult("TuringMachine::Run", result.num_steps, seconds);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(
+        *kWorkloads[i].second);
+    seconds = TimeInSeconds([&]() {
+      result = packed_tape_machine.Run(kNumSteps[i]);
+    });
+    PrintResult("PackedTapeMachine::Run", result.num_steps, seconds);
+  }
+}
+
+/**
+ * Struct representing a benchmark that can be picked by name
+ */
+struct Benchmark {
+  const char *name;
+  void (*function)();
+};
+
+/**
+ * array storing every benchmark
+ */
+const Benchmark kBenchmarks[] = {
+    {"run", BenchmarkRun},
+    {"segments", BenchmarkSegments},
+    {"packed", BenchmarkPacked}};
+
+} // namespace
+
+/**
+ * Runs the benchmarks, which time the ways of running a turing machine against
+ * each other on the same workloads, printing the steps taken and the time per
+ * step of each
+ * Usage: turing-machine-simulator-benchmark [name of a benchmark ...] (every
+ * benchmark is run if none are named)
+ */
+int main(int argc, char **argv) {
+  for (const Benchmark &kBenchmark : kBenchmarks) {
+    bool is_picked = argc == 1;
+    for (int i = 1; i < argc; i++) {
+      is_picked = is_picked || std::strcmp(argv[i], kBenchmark.name) == 0;
+    }
+    if (is_picked) {
+      kBenchmark.function();
+    }
+  }
+  return 0;
+}
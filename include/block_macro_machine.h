@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "run_result.h"
+#include "state.h"
+#include "transition_table.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing the effect of running a turing machine inside 1 block
+ * of the tape until the scanner leaves the block, the machine enters a
+ * halting state, or no direction applies
+ */
+struct BlockTransition {
+  /**
+   * uint64_t storing the contents of the block afterwards, packed as in
+   * BlockMacroMachine
+   */
+  uint64_t contents = 0;
+
+  /**
+   * uint64_t storing the number of steps of the turing machine this block
+   * transition stands for
+   */
+  uint64_t num_steps = 0;
+
+  /**
+   * uint32_t storing the index (in the transition table) of the state the
+   * machine is in afterwards
+   */
+  uint32_t state_to_move_to = 0;
+
+  /**
+   * int32_t storing the offset of the scanner from the start of the block
+   * afterwards (-1 if it left the block to the left, the block size if it
+   * left the block to the right)
+   */
+  int32_t scanner_offset = 0;
+
+  /**
+   * int32_t storing the smallest offset from the start of the block that the
+   * scanner reached
+   */
+  int32_t min_scanner_offset = 0;
+
+  /**
+   * int32_t storing the largest offset from the start of the block that the
+   * scanner reached
+   */
+  int32_t max_scanner_offset = 0;
+
+  /**
+   * bool that is true if the simulation of the block ran to completion (it was
+   * not cut short by a step limit) and so can be cached
+   */
+  bool is_complete = false;
+};
+
+/**
+ * Class that runs a turing machine with its tape split into blocks of a fixed
+ * number of cells ("macro characters")
+ * Each cell is stored as a code of as few bits as the characters of the
+ * machine need (the blank character is code 0), so a block is 1 uint64_t;
+ * the effect of running the machine across a block is cached in a flat hash
+ * table keyed by the state the machine enters the block in, where it enters
+ * the block, and the packed block, so sweeping over blocks the machine has
+ * seen before costs 1 probe instead of 1 step per cell
+ * A block transition that enters a block at 1 end and leaves it at the other
+ * in the same state is chained across the run of identical blocks behind it
+ * at once; the tape, state, and step count always match those of the turing
+ * machine run 1 step at a time
+ */
+class BlockMacroMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    BlockMacroMachine() = default;
+
+    /**
+     * This method creates a block macro machine that continues from the
+     * current configuration of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to run
+     * @param block_size a size_t representing the number of cells per block,
+     *     must be at least 1 and small enough for a packed block to fit in 64
+     *     bits (32 cells for 3 or 4 characters, 64 cells for 2)
+     */
+    BlockMacroMachine(const TuringMachine &turing_machine, size_t block_size);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    /**
+     * This method returns the number of block transitions in the cache
+     *
+     * @return a size_t representing the number of cached block transitions
+     */
+    size_t GetNumberOfCachedBlockTransitions() const;
+
+    /**
+     * This method returns true if the block macro machine is empty (created
+     * from an empty turing machine, with a block size of 0 or too large to
+     * pack, or with the default constructor)
+     *
+     * @return a bool that is true if the block macro machine is empty
+     */
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a RunResult describing the run
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * Struct representing a slot of the block transition cache
+     */
+    struct CachedBlockTransition {
+      /**
+       * uint64_t storing the packed contents of the block
+       */
+      uint64_t contents = 0;
+
+      /**
+       * uint64_t storing the state index shifted left by 8 bits, plus the
+       * entry offset, plus 1 (0 if the slot is free)
+       */
+      uint64_t entry = 0;
+
+      /**
+       * BlockTransition storing the effect of the block
+       */
+      BlockTransition block_transition;
+    };
+
+    /**
+     * This method returns the cached block transition for the given entry
+     * and block contents
+     *
+     * @param entry a uint64_t representing the entry, as in
+     *     CachedBlockTransition
+     * @param contents a uint64_t representing the packed block
+     * @return a pointer to the cached BlockTransition, null if there is none
+     */
+    const BlockTransition *FindBlockTransition(uint64_t entry, uint64_t
+        contents) const;
+
+    /**
+     * This method caches the given block transition, growing the cache or
+     * clearing it once it holds kMaxCachedBlockTransitions transitions
+     *
+     * @param entry a uint64_t representing the entry, as in
+     *     CachedBlockTransition
+     * @param contents a uint64_t representing the packed block
+     * @param block_transition a BlockTransition to cache
+     */
+    void CacheBlockTransition(uint64_t entry, uint64_t contents, const
+        BlockTransition &block_transition);
+
+    /**
+     * This method runs the machine 1 step at a time inside the given block
+     * until the scanner leaves the block, the machine enters a halting state,
+     * no direction applies, or the step limit is reached
+     *
+     * @param block a size_t representing the index of the block in blocks_
+     * @param step_limit a uint64_t representing the most steps to take
+     * @return a BlockTransition describing the effect of the steps taken
+     */
+    BlockTransition SimulateBlock(size_t block, uint64_t step_limit) const;
+
+    /**
+     * This method adds blank blocks to the start of blocks_
+     */
+    void GrowLeft();
+
+    /**
+     * This method adds blank blocks to the end of blocks_
+     */
+    void GrowRight();
+
+    /**
+     * TransitionTable storing the directions of the turing machine
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * size_t storing the number of cells per block
+     */
+    size_t block_size_ = 0;
+
+    /**
+     * size_t storing the number of bits of the code of each cell
+     */
+    size_t bits_per_cell_ = 0;
+
+    /**
+     * uint8_t array storing the code of each character of the machine
+     */
+    uint8_t code_by_character_[256] = {};
+
+    /**
+     * vector storing the character of each code
+     */
+    std::vector<char> character_by_code_;
+
+    /**
+     * vector storing the packed blocks of the tape, padded with blanks
+     */
+    std::vector<uint64_t> blocks_;
+
+    /**
+     * size_t storing the index (counting cells of blocks_) of the leftmost
+     * cell of the tape (the cells the turing machine has visited or started
+     * with)
+     */
+    size_t begin_ = 0;
+
+    /**
+     * size_t storing the index after the rightmost cell of the tape
+     */
+    size_t end_ = 0;
+
+    /**
+     * size_t storing the index of the cell the scanner is reading
+     */
+    size_t scanner_ = 0;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * vector storing the slots of the block transition cache, a power of 2 of
+     * them probed linearly from the hash of the entry and contents
+     */
+    std::vector<CachedBlockTransition> block_transition_cache_;
+
+    /**
+     * size_t storing the number of slots of the cache in use
+     */
+    size_t num_cached_block_transitions_ = 0;
+
+    /**
+     * bool that is true if the block macro machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
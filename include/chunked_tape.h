@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing a tape stored as fixed-size chunks of cells that are
+ * shared between copies of the tape
+ * Copying a chunked tape copies only the pointers to its chunks, and a chunk
+ * is copied the first time a copy of the tape writes to it while it is still
+ * shared (copy-on-write), so snapshots and forks of a running machine cost
+ * the chunks they later change instead of the whole tape; the blank headroom
+ * around the tape is 1 all-blank chunk shared by every position it fills
+ * Like Tape, positions on the tape are given either as an index (0 is the
+ * leftmost cell of the tape) or as a signed position (0 is the first cell of
+ * the tape the machine started with); every step calls Read, Write, MoveLeft
+ * and MoveRight, so they are defined in the header
+ * NOTE: a chunked tape is not safe to copy from one thread while another
+ * thread writes to a copy of it
+ */
+class ChunkedTape {
+  public:
+    /**
+     * size_t storing log2 of the number of cells in a chunk
+     */
+    static const size_t kChunkShift = 12;
+
+    /**
+     * size_t storing the number of cells in a chunk
+     */
+    static const size_t kCellsPerChunk = static_cast<size_t>(1) << kChunkShift;
+
+    /**
+     * Default constructor
+     */
+    ChunkedTape() = default;
+
+    /**
+     * This method creates a chunked tape containing the given cells with the
+     * scanner reading the first cell
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     */
+    ChunkedTape(const std::vector<char> &cells, char blank_character);
+
+    /**
+     * This method creates a chunked tape containing the given cells with the
+     * scanner reading the cell at the given index, with the same meaning as
+     * the Tape constructor of the same parameters
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param index_of_scanner a size_t representing the index of the cell the
+     *     scanner is reading
+     * @param position_of_scanner an int64_t representing the position of the
+     *     scanner relative to the first cell of the tape the run started with
+     */
+    ChunkedTape(const std::vector<char> &cells, char blank_character, size_t
+        index_of_scanner, int64_t position_of_scanner);
+
+    /**
+     * This method returns the character the scanner is reading
+     *
+     * @return a char representing the character the scanner is reading
+     */
+    char Read() const {
+      return (*chunks_[scanner_ >> kChunkShift])[scanner_ & kCellMask];
+    }
+
+    /**
+     * This method writes the given character where the scanner is, copying
+     * the chunk of the scanner first if another tape shares it
+     *
+     * @param character a char representing the character to write
+     */
+    void Write(char character) {
+      std::shared_ptr<Chunk> &chunk = chunks_[scanner_ >> kChunkShift];
+      if (chunk.use_count() != 1) {
+        if ((*chunk)[scanner_ & kCellMask] == character) {
+          // writing the character a cell already holds changes nothing, so
+          // the chunk stays shared
+          return;
+        }
+        chunk = std::make_shared<Chunk>(*chunk);
+      }
+      (*chunk)[scanner_ & kCellMask] = character;
+    }
+
+    /**
+     * This method moves the scanner 1 cell left, adding a blank cell to the
+     * start of the tape if the scanner is on the first cell
+     */
+    void MoveLeft() {
+      if (scanner_ == begin_) {
+        if (begin_ == 0) {
+          GrowLeft();
+        }
+        begin_ -= 1;
+      }
+      scanner_ -= 1;
+    }
+
+    /**
+     * This method moves the scanner 1 cell right, adding a blank cell to the
+     * end of the tape if the scanner is on the last cell
+     */
+    void MoveRight() {
+      scanner_ += 1;
+      if (scanner_ == end_) {
+        if (end_ == chunks_.size() << kChunkShift) {
+          GrowRight();
+        }
+        end_ += 1;
+      }
+    }
+
+    /**
+     * This method moves the scanner right past the cells holding the given
+     * character, with the same meaning as Tape::SkipRight
+     *
+     * @param character a char representing the character of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipRight(char character, uint64_t max_cells);
+
+    /**
+     * This method moves the scanner left past the cells holding the given
+     * character, with the same meaning as Tape::SkipLeft
+     *
+     * @param character a char representing the character of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipLeft(char character, uint64_t max_cells);
+
+    /**
+     * This method returns the cells of the tape from left to right
+     *
+     * @return a vector of chars representing the cells of the tape
+     */
+    std::vector<char> GetCells() const;
+
+    /**
+     * This method returns the character in the cell at the given index
+     *
+     * @param index a size_t representing the index of a cell (0 is the
+     *     leftmost cell of the tape)
+     * @return a char representing the character in the cell
+     */
+    char GetCell(size_t index) const;
+
+    size_t GetSize() const;
+
+    size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape the machine started with (negative if the scanner is
+     * to the left of that cell)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    char GetBlankCharacter() const;
+
+    size_t GetNumberOfChunks() const;
+
+    /**
+     * This method returns the number of chunks that no other tape shares
+     * (chunks this tape has written to since it was last copied)
+     *
+     * @return a size_t representing the number of chunks owned by this tape
+     *     alone
+     */
+    size_t GetNumberOfOwnedChunks() const;
+
+  private:
+    /**
+     * Array storing the cells of a chunk
+     */
+    typedef std::array<char, kCellsPerChunk> Chunk;
+
+    /**
+     * size_t storing the mask of the index of a cell within its chunk
+     */
+    static const size_t kCellMask = kCellsPerChunk - 1;
+
+    /**
+     * This method adds blank chunks to the start of the tape
+     */
+    void GrowLeft();
+
+    /**
+     * This method adds blank chunks to the end of the tape
+     */
+    void GrowRight();
+
+    /**
+     * vector storing pointers to the chunks of the tape surrounded by blank
+     * headroom
+     */
+    std::vector<std::shared_ptr<Chunk>> chunks_;
+
+    /**
+     * shared pointer storing the chunk of blank characters that fills the
+     * headroom
+     */
+    std::shared_ptr<Chunk> blank_chunk_;
+
+    /**
+     * size_t storing the index in the chunks of the leftmost cell of the tape
+     */
+    size_t begin_ = 0;
+
+    /**
+     * size_t storing the index in the chunks after the rightmost cell of the
+     * tape
+     */
+    size_t end_ = 0;
+
+    /**
+     * size_t storing the index in the chunks of the cell the scanner is
+     * reading
+     */
+    size_t scanner_ = 0;
+
+    /**
+     * int64_t storing the index in the chunks of the first cell of the tape
+     * the machine started with (outside the chunks if the starting tape was
+     * trimmed from a tape with a blank margin)
+     */
+    int64_t origin_ = 0;
+
+    /**
+     * char storing the blank character of the tape
+     */
+    char blank_character_ = 0;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "chunked_tape.h"
+#include "program.h"
+#include "run_result.h"
+#include "state.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class that runs a turing machine on a ChunkedTape
+ * Copying a chunked tape machine shares its program and the chunks of its
+ * tape with the copy, so snapshots, forks, and checkpoints of a run cost
+ * O(number of chunks) pointers plus the chunks either copy writes to later,
+ * instead of a copy of the whole tape; runs produce the same configurations
+ * as TuringMachine::Run and TuringMachine::RunUntilHalt
+ */
+class ChunkedTapeMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    ChunkedTapeMachine() = default;
+
+    /**
+     * This method creates a chunked tape machine that continues from the
+     * current configuration of the given turing machine, sharing its program
+     *
+     * @param turing_machine a TuringMachine to run on a chunked tape
+     */
+    explicit ChunkedTapeMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    const ChunkedTape &GetChunkedTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    int64_t GetPositionOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * shared pointer storing the program of the machine (shared with the
+     * turing machine it was created from and with every copy)
+     */
+    std::shared_ptr<const Program> program_;
+
+    /**
+     * ChunkedTape storing the tape of the machine
+     */
+    ChunkedTape tape_;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the chunked tape machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+
+#include "state.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * This method returns the configuration of a machine in the format used in
+ * the console: the cells of the tape with the name of the current state
+ * before the cell the scanner is reading
+ * NOTE: works on any tape with GetSize, GetIndexOfScanner, and GetCell, so
+ * every engine formats its configurations the same way
+ *
+ * @param tape a tape of chars
+ * @param current_state a State representing the current state
+ * @return a string representing the configuration
+ */
+template <typename TapeType>
+std::string FormatConfigurationForConsole(const TapeType &tape, const State
+    &current_state) {
+  std::stringstream configuration_stringstream;
+  configuration_stringstream << ';';
+  // cannot use for-each loop here since the index is necessary
+  const size_t kIndexOfScanner = tape.GetIndexOfScanner();
+  for (size_t i = 0; i < tape.GetSize(); i++) {
+    if (i == kIndexOfScanner) {
+      configuration_stringstream << current_state.GetStateName();
+    }
+    configuration_stringstream << tape.GetCell(i);
+  }
+  return configuration_stringstream.str();
+}
+
+/**
+ * This method returns the configuration of a machine in the format used in
+ * markdown files, with the name of the current state as a subscript
+ *
+ * @param tape a tape of chars
+ * @param current_state a State representing the current state
+ * @return a string representing the configuration
+ */
+template <typename TapeType>
+std::string FormatConfigurationForMarkdown(const TapeType &tape, const State
+    &current_state) {
+  std::stringstream configuration_stringstream;
+  configuration_stringstream << ';';
+  // cannot use for-each loop here since index is necessary
+  const size_t kIndexOfScanner = tape.GetIndexOfScanner();
+  for (size_t i = 0; i < tape.GetSize(); i++) {
+    if (i == kIndexOfScanner) {
+      // NOTE: 'q' always precedes the name of the state; we only want the name
+      // of the state in the subscript
+      configuration_stringstream << 'q';
+      const std::string kStateName = current_state.GetStateName();
+      // a state with an empty name has no 'q' to drop
+      const std::string kStateNameWithoutQ = kStateName.empty()
+          ? kStateName : kStateName.substr(1, kStateName.size());
+      // NOTE: <sub> is the markdown subscript tag
+      configuration_stringstream << "<sub>" << kStateNameWithoutQ << "</sub>";
+    }
+    configuration_stringstream << tape.GetCell(i);
+  }
+  return configuration_stringstream.str();
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "program.h"
+#include "run_result.h"
+#include "state.h"
+#include "step_event.h"
+#include "state_layout.h"
+#include "tape.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing 1 run of a Program: the tape, the position of the
+ * scanner, the current state, and the number of steps taken
+ * The program is shared rather than copied, so an execution context is cheap
+ * to create and many of them (on different threads) can run the same program
+ * at once
+ */
+class ExecutionContext {
+  public:
+    /**
+     * Default constructor
+     */
+    ExecutionContext() = default;
+
+    /**
+     * This method creates an execution context that runs the given program on
+     * the given tape, starting in the starting state of the program
+     *
+     * @param program a shared pointer to the Program to run
+     * @param tape a vector of chars representing the starting tape
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     */
+    ExecutionContext(const std::shared_ptr<const Program> &program, const
+        std::vector<char> &tape, char blank_character);
+
+    /**
+     * This method creates an execution context that runs the given program on
+     * the given tape, starting in the starting state of the program
+     *
+     * @param program a shared pointer to the Program to run
+     * @param tape a Tape representing the starting tape and scanner
+     */
+    ExecutionContext(const std::shared_ptr<const Program> &program, const
+        Tape &tape);
+
+    /**
+     * This method creates a copy of the given execution context; the copy
+     * starts with no listeners, since the listeners subscribed to the
+     * original execution context only follow the original
+     *
+     * @param execution_context the ExecutionContext to copy
+     */
+    ExecutionContext(const ExecutionContext &execution_context);
+
+    /**
+     * Move constructor (the listeners move with the execution context)
+     */
+    ExecutionContext(ExecutionContext &&execution_context) = default;
+
+    /**
+     * This method copies the given execution context into this one, dropping
+     * the listeners of this execution context without taking the listeners of
+     * the given one
+     *
+     * @param execution_context the ExecutionContext to copy
+     * @return a reference to this ExecutionContext
+     */
+    ExecutionContext &operator=(const ExecutionContext &execution_context);
+
+    /**
+     * Move assignment operator (the listeners move with the execution context)
+     */
+    ExecutionContext &operator=(ExecutionContext &&execution_context) =
+        default;
+
+    State GetCurrentState() const;
+
+    /**
+     * This method returns the index (in the transition table of the program)
+     * of the current state
+     *
+     * @return a size_t representing the index of the current state
+     */
+    size_t GetCurrentStateIndex() const;
+
+    /**
+     * This method returns the id of the current state without copying the
+     * state
+     *
+     * @return an int representing the id of the current state (-1 if the
+     *     execution context is empty)
+     */
+    int GetCurrentStateId() const;
+
+    std::vector<char> GetTape() const;
+
+    /**
+     * This method returns a view of the tape without copying it
+     *
+     * @return a TapeView of the tape (valid until the next step)
+     */
+    TapeView GetTapeView() const;
+
+    size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape the run started with (the positions used by step
+     * events)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    char GetBlankCharacter() const;
+
+    const std::shared_ptr<const Program> &GetProgram() const;
+
+    /**
+     * This method subscribes the given listener to the step events of this
+     * run; events are delivered in batches, at the latest when the Update,
+     * Run, or RunUntilHalt call that produced them returns
+     * NOTE: runs without listeners do not record events at all
+     *
+     * @param listener a StepEventListener to call with batches of events
+     * @return a size_t representing the id of the subscription
+     */
+    size_t Subscribe(const StepEventListener &listener);
+
+    /**
+     * This method removes the subscription with the given id
+     *
+     * @param subscription_id a size_t representing the id of a subscription
+     */
+    void Unsubscribe(size_t subscription_id);
+
+    /**
+     * This method returns true if any listener is subscribed to the step
+     * events of this run
+     *
+     * @return a bool that is true if there are listeners
+     */
+    bool HasListeners() const;
+
+    /**
+     * This method replaces the configuration of this run with one reached by
+     * another engine running the same program (which cannot record step
+     * events, so this is only used without listeners)
+     *
+     * @param tape a Tape representing the new tape and scanner
+     * @param current_state_index a size_t representing the index (in the
+     *     transition table of the program) of the new current state
+     * @param num_steps a uint64_t representing the new number of steps taken
+     * @param is_halted a bool that is true if the machine is halted
+     */
+    void SetConfiguration(const Tape &tape, size_t current_state_index,
+        uint64_t num_steps, bool is_halted);
+
+    /**
+     * This method sets the blank margin of the tape (see
+     * Tape::SetMaxBlankMargin), which is kept when the configuration is
+     * replaced
+     *
+     * @param max_blank_margin a size_t representing the most cells from the
+     *     scanner a blank end of the tape is kept for, 0 keeps every cell
+     */
+    void SetMaxBlankMargin(size_t max_blank_margin);
+
+    /**
+     * This method returns true if the tape was created from a TapeGenerator,
+     * so GetTape only holds the cells the scanner has reached
+     *
+     * @return a bool that is true if the tape generates its cells
+     */
+    bool IsTapeGenerated() const;
+
+    /**
+     * This method profiles a warm-up run from the current configuration (on a
+     * copy, so the run itself does not move on), then replaces the program
+     * with a copy whose states are renumbered so hot states and their usual
+     * successors have neighbouring rows in the transition table
+     * NOTE: state indices (also in step events) change, states and ids do not
+     *
+     * @param num_warm_up_steps a uint64_t representing the most steps to
+     *     profile
+     * @return a StateLayoutReport of the spread of the profiled table accesses
+     *     before and after renumbering
+     */
+    StateLayoutReport OptimizeStateLayout(uint64_t num_warm_up_steps);
+
+    bool IsHalted() const;
+
+    /**
+     * This method returns true if the execution context is empty (its program
+     * is empty or it was created with the default constructor)
+     *
+     * @return a bool that is true if the execution context is empty
+     */
+    bool IsEmpty() const;
+
+    /**
+     * This method returns the current configuration formatted for the console
+     * (see TuringMachine::GetConfigurationForConsole)
+     *
+     * @return the current configuration formatted for the console
+     */
+    std::string GetConfigurationForConsole() const;
+
+    /**
+     * This method returns the current configuration formatted for a markdown
+     * file (see TuringMachine::GetConfigurationForMarkdown)
+     *
+     * @return the current configuration formatted for a markdown file
+     */
+    std::string GetConfigurationForMarkdown() const;
+
+    /**
+     * This method takes 1 step by following the direction for the current
+     * state and the character being read (if there is one)
+     */
+    void Update();
+
+    /**
+     * This method takes up to the given number of steps, with the same meaning
+     * as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method takes steps until the machine halts, gets stuck, or has
+     * taken the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+  private:
+    /**
+     * This method runs the step loop shared by Update, Run, and RunUntilHalt
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a RunResult describing the run
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method runs the step loop of RunSteps while recording step events
+     * for the listeners (only used when there are listeners), updating the
+     * configuration after every step so listeners always see the state the
+     * events lead to
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @param num_steps_taken a uint64_t to add the number of steps taken to
+     */
+    void RunStepsRecordingEvents(uint64_t max_steps, bool
+        stop_at_halting_state, uint64_t &num_steps_taken);
+
+    /**
+     * This method delivers the recorded events to the listeners
+     */
+    void DeliverEvents();
+
+    /**
+     * shared pointer storing the program being run
+     */
+    std::shared_ptr<const Program> program_;
+
+    /**
+     * Tape storing the tape, its blank character, and the position of the
+     * scanner
+     */
+    Tape tape_;
+
+    /**
+     * size_t storing the index (in the transition table of the program) of the
+     * current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted (true if halted, false
+     * otherwise)
+     */
+    bool is_halted_ = false;
+
+    /**
+     * vector storing the listeners to step events with their subscription ids
+     */
+    std::vector<std::pair<size_t, StepEventListener>> listeners_;
+
+    /**
+     * size_t storing the id of the next subscription
+     */
+    size_t next_subscription_id_ = 0;
+
+    /**
+     * vector storing the step events not yet delivered to the listeners
+     */
+    std::vector<StepEvent> recorded_events_;
+
+    /**
+     * bool that is true if the execution context is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,454 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing the settings of a MappedTape
+ */
+struct MappedTapeOptions {
+  /**
+   * size_t storing log2 of the number of cells in a chunk (raised to the page
+   * size if it is smaller); the default is 2 MiB, the size of a huge page
+   */
+  size_t chunk_shift = 21;
+
+  /**
+   * size_t storing the most chunks mapped into memory at once (at least 1)
+   */
+  size_t max_resident_chunks = 64;
+
+  /**
+   * string storing the directory of the scratch file (TMPDIR or /tmp if
+   * empty)
+   */
+  std::string scratch_directory;
+
+  /**
+   * bool that is true if the chunks mapped into memory should be backed by
+   * huge pages where the platform allows it (madvise)
+   */
+  bool use_huge_pages = false;
+};
+
+/**
+ * Class representing a tape too large to keep in memory
+ * The tape is split into chunks; the chunks near the scanner are mapped into
+ * memory (up to MappedTapeOptions::max_resident_chunks, least recently used
+ * first out) and the others live in a scratch file that is deleted as soon
+ * as it is created, so the tape can grow past the memory of the machine; a
+ * tape can also map a file as its starting cells, reading chunks of it only
+ * when the scanner reaches them (the file itself is never changed)
+ * Like Tape, positions on the tape are given either as an index (0 is the
+ * leftmost cell of the tape) or as a signed position (0 is the first cell of
+ * the tape the machine started with); Read, Write, MoveLeft and MoveRight
+ * are defined in the header so they inline into the step loop, which only
+ * calls out of line to grow the tape or map another chunk
+ * NOTE: memory mapping is only supported on POSIX platforms; elsewhere, and
+ * if the scratch file or the mapping of a chunk fails, the tape reports an
+ * error message
+ */
+class MappedTape {
+  public:
+    /**
+     * Default constructor
+     */
+    MappedTape() = default;
+
+    /**
+     * This method creates a mapped tape containing the given cells with the
+     * scanner reading the first cell
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param options a MappedTapeOptions representing the settings of the tape
+     */
+    MappedTape(const std::vector<char> &cells, char blank_character, const
+        MappedTapeOptions &options);
+
+    /**
+     * This method creates a mapped tape containing the given cells with the
+     * scanner reading the cell at the given index, with the same meaning as
+     * the Tape constructor of the same parameters
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param index_of_scanner a size_t representing the index of the cell the
+     *     scanner is reading
+     * @param position_of_scanner an int64_t representing the position of the
+     *     scanner relative to the first cell of the tape the run started with
+     * @param options a MappedTapeOptions representing the settings of the tape
+     */
+    MappedTape(const std::vector<char> &cells, char blank_character, size_t
+        index_of_scanner, int64_t position_of_scanner, const MappedTapeOptions
+        &options);
+
+    /**
+     * This method creates a mapped tape whose cells are the bytes of the file
+     * at the given path, with the scanner reading the first cell
+     * NOTE: a named method rather than a constructor, since a braced list of
+     * cells could be read as either a vector or a path
+     *
+     * @param input_path a string representing the path of the file, an empty
+     *     file creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param options a MappedTapeOptions representing the settings of the tape
+     * @return a MappedTape of the cells of the file (empty, with an error
+     *     message, if the file cannot be read)
+     */
+    static MappedTape FromFile(const std::string &input_path, char
+        blank_character, const MappedTapeOptions &options);
+
+    /**
+     * Destructor (unmaps the chunks and closes the files)
+     */
+    ~MappedTape();
+
+    /**
+     * A mapped tape owns its mappings and files, so it can be moved but not
+     * copied
+     */
+    MappedTape(const MappedTape &) = delete;
+    MappedTape &operator=(const MappedTape &) = delete;
+    MappedTape(MappedTape &&other);
+    MappedTape &operator=(MappedTape &&other);
+
+    /**
+     * This method returns the character the scanner is reading
+     *
+     * @return a char representing the character the scanner is reading
+     */
+    char Read() const {
+      return current_cells_[scanner_ & cell_mask_];
+    }
+
+    /**
+     * This method writes the given character where the scanner is
+     *
+     * @param character a char representing the character to write
+     */
+    void Write(char character) {
+      current_cells_[scanner_ & cell_mask_] = character;
+      is_current_chunk_written_ = true;
+    }
+
+    /**
+     * This method moves the scanner 1 cell left, adding a blank cell to the
+     * start of the tape if the scanner is on the first cell, and mapping the
+     * chunk it moves into if needed
+     */
+    void MoveLeft() {
+      if (scanner_ == begin_) {
+        if (begin_ == 0) {
+          GrowLeft();
+        }
+        begin_ -= 1;
+      }
+      const bool kIsLeavingChunk = (scanner_ & cell_mask_) == 0;
+      scanner_ -= 1;
+      if (kIsLeavingChunk) {
+        EnterChunk(scanner_ >> chunk_shift_);
+      }
+    }
+
+    /**
+     * This method moves the scanner 1 cell right, adding a blank cell to the
+     * end of the tape if the scanner is on the last cell, and mapping the
+     * chunk it moves into if needed
+     */
+    void MoveRight() {
+      scanner_ += 1;
+      if (scanner_ == end_) {
+        if (end_ == chunks_.size() << chunk_shift_) {
+          GrowRight();
+        }
+        end_ += 1;
+      }
+      if ((scanner_ & cell_mask_) == 0) {
+        EnterChunk(scanner_ >> chunk_shift_);
+      }
+    }
+
+    /**
+     * This method returns the cells of the tape from left to right
+     * NOTE: this reads the whole tape into memory
+     *
+     * @return a vector of chars representing the cells of the tape
+     */
+    std::vector<char> GetCells() const;
+
+    /**
+     * This method returns the character in the cell at the given index,
+     * reading it from the files if its chunk is not mapped
+     *
+     * @param index a size_t representing the index of a cell (0 is the
+     *     leftmost cell of the tape)
+     * @return a char representing the character in the cell
+     */
+    char GetCell(size_t index) const;
+
+    size_t GetSize() const;
+
+    size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape the machine started with (negative if the scanner is
+     * to the left of that cell)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    char GetBlankCharacter() const;
+
+    size_t GetNumberOfChunks() const;
+
+    size_t GetNumberOfResidentChunks() const;
+
+    size_t GetNumberOfCellsPerChunk() const;
+
+    /**
+     * This method returns whether or not the tape could not map the chunk of
+     * the scanner, in which case its cells can no longer be trusted
+     *
+     * @return a bool that is true if a mapping has failed
+     */
+    bool HasFailed() const;
+
+    bool IsEmpty() const;
+
+    std::string GetErrorMessage() const;
+
+  private:
+    /**
+     * Struct representing where the cells of a chunk are
+     */
+    struct ChunkSlot {
+      /**
+       * pointer to the cells of the chunk if it is mapped, and null otherwise
+       */
+      char *cells = nullptr;
+
+      /**
+       * int64_t storing the index of the chunk in the scratch file (-1 if the
+       * chunk has never been stored there)
+       */
+      int64_t scratch_index = -1;
+
+      /**
+       * int64_t storing the offset in the input file of the cells of the
+       * chunk (-1 if the chunk does not come from the input file)
+       */
+      int64_t input_offset = -1;
+
+      /**
+       * bool that is true if the chunk has been written since it was mapped
+       * from the input file (it must be stored in the scratch file before it
+       * is unmapped)
+       */
+      bool is_dirty = false;
+
+      /**
+       * uint64_t storing when the scanner last entered the chunk
+       */
+      uint64_t last_use = 0;
+    };
+
+    /**
+     * This method sets up the chunk size, the blank character, and the
+     * scratch file, returning false if the scratch file cannot be created
+     */
+    bool Initialize(char blank_character, const MappedTapeOptions &options);
+
+    /**
+     * This method maps the file at the given path as the cells of the tape
+     * (whose chunk size and scratch file are set up)
+     *
+     * @param input_path a string representing the path of the file
+     */
+    void MapInputFile(const std::string &input_path);
+
+    /**
+     * This method makes the chunk with the given index the chunk of the
+     * scanner, mapping it (and unmapping the least recently used chunk if
+     * too many are mapped) if needed
+     *
+     * @param chunk_index a size_t representing the index of a chunk
+     */
+    void EnterChunk(size_t chunk_index);
+
+    /**
+     * This method maps the chunk with the given index into memory
+     *
+     * @param chunk_index a size_t representing the index of a chunk
+     * @return a bool that is false if the chunk could not be mapped
+     */
+    bool MapChunk(size_t chunk_index);
+
+    /**
+     * This method unmaps the chunk with the given index, storing it in the
+     * scratch file first if it was changed since it was mapped from the input
+     * file
+     *
+     * @param chunk_index a size_t representing the index of a mapped chunk
+     */
+    void UnmapChunk(size_t chunk_index);
+
+    /**
+     * This method copies the given cells of 1 chunk, reading them from the
+     * files if the chunk is not mapped
+     *
+     * @param first_cell a size_t representing the index in the chunks of the
+     *     first cell to copy
+     * @param num_cells a size_t representing the number of cells to copy (all
+     *     in the chunk of the first cell)
+     * @param cells a pointer to where the cells are copied
+     */
+    void ReadCells(size_t first_cell, size_t num_cells, char *cells) const;
+
+    /**
+     * This method adds a chunk to the end of the scratch file
+     *
+     * @return an int64_t representing the index of the new chunk in the
+     *     scratch file (-1 if the file could not grow)
+     */
+    int64_t AddScratchChunk();
+
+    /**
+     * This method unmaps every chunk and closes the files
+     */
+    void Release();
+
+    /**
+     * This method adds unmapped blank chunks to the start of the tape
+     */
+    void GrowLeft();
+
+    /**
+     * This method adds unmapped blank chunks to the end of the tape
+     */
+    void GrowRight();
+
+    /**
+     * vector storing where the cells of each chunk of the tape (and of the
+     * blank headroom around it) are
+     */
+    std::vector<ChunkSlot> chunks_;
+
+    /**
+     * vector storing the indexes of the mapped chunks
+     */
+    std::vector<size_t> resident_chunks_;
+
+    /**
+     * pointer to the cells of the chunk of the scanner
+     */
+    char *current_cells_ = nullptr;
+
+    /**
+     * size_t storing the index of the chunk of the scanner
+     */
+    size_t current_chunk_ = 0;
+
+    /**
+     * bool that is true if the chunk of the scanner has been written since
+     * the scanner entered it
+     */
+    bool is_current_chunk_written_ = false;
+
+    /**
+     * uint64_t counting the chunks the scanner has entered (the clock of the
+     * least recently used order)
+     */
+    uint64_t num_chunks_entered_ = 0;
+
+    /**
+     * size_t storing log2 of the number of cells in a chunk, and the mask of
+     * the index of a cell within its chunk
+     */
+    size_t chunk_shift_ = 0;
+    size_t cell_mask_ = 0;
+
+    /**
+     * size_t storing the most chunks mapped at once
+     */
+    size_t max_resident_chunks_ = 1;
+
+    /**
+     * bool storing whether or not to ask for huge pages for mapped chunks
+     */
+    bool use_huge_pages_ = false;
+
+    /**
+     * file descriptors of the scratch file and the input file (-1 if closed)
+     */
+    int scratch_file_ = -1;
+    int input_file_ = -1;
+
+    /**
+     * int64_t storing the number of chunks in the scratch file
+     */
+    int64_t num_scratch_chunks_ = 0;
+
+    /**
+     * vector storing the cells given to the scanner when its chunk cannot be
+     * mapped
+     */
+    std::vector<char> failed_cells_;
+
+    /**
+     * size_t storing the index in the chunks of the leftmost cell of the tape
+     */
+    size_t begin_ = 0;
+
+    /**
+     * size_t storing the index in the chunks after the rightmost cell of the
+     * tape
+     */
+    size_t end_ = 0;
+
+    /**
+     * size_t storing the index in the chunks of the cell the scanner is
+     * reading
+     */
+    size_t scanner_ = 0;
+
+    /**
+     * int64_t storing the index in the chunks of the first cell of the tape
+     * the machine started with (outside the chunks if the starting tape was
+     * trimmed from a tape with a blank margin)
+     */
+    int64_t origin_ = 0;
+
+    /**
+     * char storing the blank character of the tape
+     */
+    char blank_character_ = 0;
+
+    /**
+     * bool that is true if a chunk could not be mapped
+     */
+    bool has_failed_ = false;
+
+    /**
+     * bool that is true if the mapped tape is empty
+     */
+    bool is_empty_ = true;
+
+    /**
+     * string storing why the tape is empty or has failed
+     */
+    std::string error_message_;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mapped_tape.h"
+#include "program.h"
+#include "run_result.h"
+#include "state.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class that runs a turing machine on a MappedTape, for tapes that grow past
+ * the memory of the machine or start from a file too large to load
+ * Runs produce the same configurations as TuringMachine::Run and
+ * TuringMachine::RunUntilHalt, and the configurations are formatted the same
+ * way as TuringMachine formats them
+ */
+class MappedTapeMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    MappedTapeMachine() = default;
+
+    /**
+     * This method creates a mapped tape machine that continues from the
+     * current configuration of the given turing machine, copying its tape to
+     * a mapped tape
+     *
+     * @param turing_machine a TuringMachine to run on a mapped tape
+     * @param options a MappedTapeOptions representing the settings of the tape
+     */
+    MappedTapeMachine(const TuringMachine &turing_machine, const
+        MappedTapeOptions &options);
+
+    /**
+     * This method creates a mapped tape machine that runs the program of the
+     * given turing machine, from its current state, on the given tape (for
+     * example a tape mapped from a file) instead of the tape of the machine
+     *
+     * @param turing_machine a TuringMachine whose program and state to run
+     * @param tape a MappedTape to run on
+     */
+    MappedTapeMachine(const TuringMachine &turing_machine, MappedTape &&tape);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    const MappedTape &GetMappedTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    int64_t GetPositionOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+    /**
+     * This method returns why the machine is empty, or why its tape failed
+     * during a run (empty if neither happened)
+     *
+     * @return a string representing the error message
+     */
+    std::string GetErrorMessage() const;
+
+    std::string GetConfigurationForConsole() const;
+
+    std::string GetConfigurationForMarkdown() const;
+
+  private:
+    /**
+     * This method copies the program and state of the given turing machine,
+     * returning false if the machine or the tape is empty
+     */
+    bool Initialize(const TuringMachine &turing_machine);
+
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * shared pointer storing the program of the machine
+     */
+    std::shared_ptr<const Program> program_;
+
+    /**
+     * MappedTape storing the tape of the machine
+     */
+    MappedTape tape_;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the mapped tape machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "run_result.h"
+#include "state.h"
+#include "transition_table.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a segment of the tape: either a single cell (level 0)
+ * or 2 segments of the level below placed side by side, so a segment of level
+ * L has 2^L cells
+ * NOTE: segments are hash-consed, 2 segments with the same contents are
+ * always the same segment
+ */
+struct TapeSegment {
+  /**
+   * uint32_t storing the id of the left half of the segment (unused for
+   * single cells)
+   */
+  uint32_t left = 0;
+
+  /**
+   * uint32_t storing the id of the right half of the segment (unused for
+   * single cells)
+   */
+  uint32_t right = 0;
+
+  /**
+   * uint32_t storing the level of the segment
+   */
+  uint32_t level = 0;
+
+  /**
+   * char storing the character of the cell (only used for single cells)
+   */
+  char character = 0;
+};
+
+/**
+ * Enum representing why the evaluation of a segment stopped
+ */
+enum class SegmentStatus {
+  kExited, // the scanner left the segment
+  kHalted, // the machine entered a halting state
+  kStuck, // no direction applies to the state and the character being read
+  kOutOfSteps // the step budget of the evaluation ran out
+};
+
+/**
+ * Struct representing the effect of running a turing machine inside a segment
+ */
+struct SegmentResult {
+  /**
+   * uint32_t storing the id of the segment afterwards
+   */
+  uint32_t segment = 0;
+
+  /**
+   * uint32_t storing the index (in the transition table) of the state the
+   * machine is in afterwards
+   */
+  uint32_t state = 0;
+
+  /**
+   * int64_t storing the offset of the scanner from the start of the segment
+   * afterwards (-1 or the size of the segment if the scanner left it)
+   */
+  int64_t scanner_offset = 0;
+
+  /**
+   * int64_t storing the smallest offset the scanner reached
+   */
+  int64_t min_scanner_offset = 0;
+
+  /**
+   * int64_t storing the largest offset the scanner reached
+   */
+  int64_t max_scanner_offset = 0;
+
+  /**
+   * uint64_t storing the number of steps taken
+   */
+  uint64_t num_steps = 0;
+
+  /**
+   * SegmentStatus storing why the evaluation stopped
+   */
+  SegmentStatus status = SegmentStatus::kOutOfSteps;
+};
+
+/**
+ * Class that runs a turing machine on a tape stored as a binary tree of
+ * hash-consed segments (in the style of Hashlife)
+ * The effect of entering a segment from its left or right edge in a given
+ * state is memoized, and since identical stretches of tape are the same
+ * segment, a region of tape the machine has evaluated before is replayed with
+ * 1 lookup at whatever scale it repeats; a segment the machine keeps crossing
+ * in a cycle is fast-forwarded by whole periods; step counts, tapes, and
+ * scanner positions always match those of the turing machine run 1 step at a
+ * time
+ * NOTE: memory is bounded by the max table size: the memoized results are
+ * cleared once there are that many of them, and once there are that many
+ * segments (or twice as many as the tape needed at the last collection) the
+ * segments that are no longer part of the tape are collected between
+ * evaluations of the root segment, which also clears the memoized results
+ */
+class MemoizedSegmentMachine {
+  public:
+    /**
+     * size_t storing the default most segments and memoized results kept
+     */
+    static const size_t kDefaultMaxTableSize = 1 << 20;
+
+    /**
+     * Default constructor
+     */
+    MemoizedSegmentMachine() = default;
+
+    /**
+     * This method creates a memoized segment machine that continues from the
+     * current configuration of the given turing machine, keeping up to
+     * kDefaultMaxTableSize segments and memoized results
+     *
+     * @param turing_machine a TuringMachine to run
+     */
+    explicit MemoizedSegmentMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method creates a memoized segment machine that continues from the
+     * current configuration of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to run
+     * @param max_table_size a size_t representing the most segments and
+     *     memoized results kept (at least 1), unless the tape itself needs
+     *     more segments
+     */
+    MemoizedSegmentMachine(const TuringMachine &turing_machine, size_t
+        max_table_size);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    size_t GetNumberOfSegments() const;
+
+    size_t GetNumberOfMemoizedResults() const;
+
+    /**
+     * This method returns true if the memoized segment machine is empty
+     * (created from an empty turing machine or with the default constructor)
+     *
+     * @return a bool that is true if the memoized segment machine is empty
+     */
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a RunResult describing the run
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method runs the machine inside the given segment until the scanner
+     * leaves it, the machine enters a halting state, no direction applies, or
+     * the step budget runs out
+     *
+     * @param segment a uint32_t representing the id of the segment
+     * @param state a uint32_t representing the index of the state to start in
+     * @param scanner_offset an int64_t representing the offset of the scanner
+     *     from the start of the segment
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a SegmentResult describing the effect of the steps taken
+     */
+    SegmentResult Evaluate(uint32_t segment, uint32_t state, int64_t
+        scanner_offset, uint64_t step_budget);
+
+    /**
+     * This method runs the machine on a single cell (the same as Evaluate but
+     * for segments of level 0)
+     */
+    SegmentResult EvaluateCell(uint32_t segment, uint32_t state, uint64_t
+        step_budget);
+
+    /**
+     * This method memoizes the given result, clearing the memoized results
+     * first if there are too many of them
+     *
+     * @param memo_key a uint64_t representing the key of the result
+     * @param result a SegmentResult to memoize
+     */
+    void MemoizeResult(uint64_t memo_key, const SegmentResult &result);
+
+    /**
+     * This method replaces the segments with only those that make up the
+     * root segment, clearing the memoized results
+     */
+    void CollectSegments();
+
+    /**
+     * This method copies the given segment (and its halves) from the given
+     * old segments into the segments
+     *
+     * @param segments a vector storing the old segments by their ids
+     * @param segment a uint32_t representing the old id of the segment
+     * @param new_segment_ids a map storing the new ids of the old segments
+     *     copied so far
+     * @return a uint32_t representing the new id of the segment
+     */
+    uint32_t CopySegment(const std::vector<TapeSegment> &segments, uint32_t
+        segment, std::unordered_map<uint32_t, uint32_t> &new_segment_ids);
+
+    /**
+     * This method returns the id of the single cell segment with the given
+     * character, creating it if needed
+     */
+    uint32_t MakeCell(char character);
+
+    /**
+     * This method returns the id of the segment with the given halves,
+     * creating it if needed
+     */
+    uint32_t MakeSegment(uint32_t left, uint32_t right);
+
+    /**
+     * This method returns the id of the segment of blanks with the given level
+     */
+    uint32_t MakeBlankSegment(uint32_t level);
+
+    /**
+     * This method doubles the size of the root segment by adding a blank
+     * segment to its left or right
+     *
+     * @param add_to_left a bool that is true if the blank segment is added to
+     *     the left of the root segment
+     */
+    void GrowRoot(bool add_to_left);
+
+    /**
+     * This method appends the cells of the given segment that fall in the
+     * range [begin, end) to the given vector
+     */
+    void CollectCells(uint32_t segment, int64_t segment_start, int64_t begin,
+        int64_t end, std::vector<char> &cells) const;
+
+    /**
+     * TransitionTable storing the directions of the turing machine
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * vector storing every segment by its id
+     */
+    std::vector<TapeSegment> segments_;
+
+    /**
+     * map storing the ids of the single cell segments by their character
+     */
+    std::map<char, uint32_t> cell_segment_ids_;
+
+    /**
+     * map storing the ids of the segments of level 1 or higher keyed by the
+     * ids of their halves
+     */
+    std::unordered_map<uint64_t, uint32_t> segment_ids_;
+
+    /**
+     * vector storing the id of the blank segment of each level
+     */
+    std::vector<uint32_t> blank_segment_ids_;
+
+    /**
+     * map storing the results of evaluating segments entered from an edge,
+     * keyed by the segment, the state, and the edge
+     */
+    std::unordered_map<uint64_t, SegmentResult> memoized_results_;
+
+    /**
+     * size_t storing the most segments and memoized results kept
+     */
+    size_t max_table_size_ = kDefaultMaxTableSize;
+
+    /**
+     * size_t storing the number of segments at which the segments are
+     * collected
+     */
+    size_t max_segments_ = kDefaultMaxTableSize;
+
+    /**
+     * uint32_t storing the id of the segment holding the whole tape
+     */
+    uint32_t root_ = 0;
+
+    /**
+     * int64_t storing the offset in the root segment of the leftmost cell of
+     * the tape (the cells the turing machine has visited or started with)
+     */
+    int64_t begin_ = 0;
+
+    /**
+     * int64_t storing the offset in the root segment after the rightmost cell
+     * of the tape
+     */
+    int64_t end_ = 0;
+
+    /**
+     * int64_t storing the offset in the root segment of the scanner
+     */
+    int64_t scanner_ = 0;
+
+    /**
+     * char storing the blank character of the tape
+     */
+    char blank_character_ = 0;
+
+    /**
+     * uint32_t storing the index (in the transition table) of the current
+     * state
+     */
+    uint32_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the memoized segment machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing the table of interned state names shared by every State
+ * A name (or a list of names, such as the possible names of halting states)
+ * is stored once and referred to by a small id, so states only hold ids and
+ * copying a state never copies a string
+ * NOTE: id 0 is always the empty name and the empty list of names
+ * NOTE: the table only grows, names are never removed so ids and the
+ * references returned by GetName stay valid for the whole program; it holds
+ * 1 entry per distinct name ever given to a state (in the app, each distinct
+ * name typed while renaming a state, which is bounded by what a user types)
+ */
+class NameTable {
+  public:
+    /**
+     * This method returns the id of the given name, adding it to the table if
+     * needed
+     *
+     * @param name a string representing a name
+     * @return a uint32_t representing the id of the name
+     */
+    static uint32_t InternName(const std::string &name);
+
+    /**
+     * This method returns the name with the given id without copying it
+     *
+     * @param name_id a uint32_t representing the id of a name
+     * @return a reference to the string held by the table representing the
+     *     name (empty if the id is unknown)
+     */
+    static const std::string &GetName(uint32_t name_id);
+
+    /**
+     * This method returns the id of the given list of names, adding it to the
+     * table if needed (the order and repetition of the names do not matter)
+     *
+     * @param names a vector of strings representing a list of names
+     * @return a uint32_t representing the id of the list of names
+     */
+    static uint32_t InternNameList(const std::vector<std::string> &names);
+
+    /**
+     * This method returns true if the list of names with the given id contains
+     * the name with the given id
+     *
+     * @param name_list_id a uint32_t representing the id of a list of names
+     * @param name_id a uint32_t representing the id of a name
+     * @return a bool that is true if the list contains the name
+     */
+    static bool NameListContains(uint32_t name_list_id, uint32_t name_id);
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution_context.h"
+#include "run_result.h"
+#include "state.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct shared with the compiled code of a native machine, it must match the
+ * struct written at the top of the generated C source
+ */
+struct NativeMachineContext {
+  char *cells;
+  size_t capacity;
+  size_t begin;
+  size_t end;
+  size_t scanner;
+  uint32_t state;
+  uint32_t status;
+  int is_halted;
+  int stop_at_halting_state;
+};
+
+/**
+ * Class that runs a turing machine compiled to native code
+ * The directions of the machine are turned into C source (each state is a
+ * label with a switch over the character being read), compiled into a shared
+ * object with the system compiler, and loaded with dlopen; compiled machines
+ * are cached in a directory keyed by a hash of their source, so a machine is
+ * only compiled once (a cached machine is only loaded if it is owned by and
+ * only writable by the current user, and is not a symbolic link); if there is
+ * no compiler (or loading fails) the machine falls back to running the
+ * interpreter, with the same results
+ */
+class NativeMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    NativeMachine() = default;
+
+    /**
+     * This method creates a native machine that continues from the current
+     * configuration of the given turing machine, compiling it with the
+     * compiler in the CC environment variable (or cc) and caching it in
+     * turing-machine-simulator-native in the user's cache directory
+     * (XDG_CACHE_HOME, or .cache in HOME)
+     *
+     * @param turing_machine a TuringMachine to compile
+     */
+    explicit NativeMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method creates a native machine that continues from the current
+     * configuration of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to compile
+     * @param compiler a string representing the command of the C compiler
+     *     (split into words at whitespace and run without a shell)
+     * @param cache_directory a string representing the directory to store
+     *     compiled machines in (created with its parents if needed, and only
+     *     used if it is owned by and only writable by the current user)
+     */
+    NativeMachine(const TuringMachine &turing_machine, const std::string
+        &compiler, const std::string &cache_directory);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    /**
+     * This method returns true if the machine runs compiled code and false if
+     * it fell back to the interpreter
+     *
+     * @return a bool that is true if the machine runs compiled code
+     */
+    bool IsCompiled() const;
+
+    /**
+     * This method returns the reason the machine fell back to the interpreter
+     * (empty if it is compiled)
+     *
+     * @return a string representing the error message
+     */
+    std::string GetErrorMessage() const;
+
+    /**
+     * This method returns the C source the machine was compiled from
+     *
+     * @return a string representing the generated C source
+     */
+    std::string GetSource() const;
+
+    /**
+     * This method returns the path of the compiled shared object
+     *
+     * @return a string representing the path of the compiled machine
+     */
+    std::string GetArtifactPath() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method creates the native machine (shared by both constructors)
+     */
+    void Initialize(const TuringMachine &turing_machine, const std::string
+        &compiler, const std::string &cache_directory);
+
+    /**
+     * This method generates the C source of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to generate C source for
+     * @return a string representing the C source
+     */
+    std::string GenerateSource(const TuringMachine &turing_machine) const;
+
+    /**
+     * This method compiles the source (unless it is already in the cache) and
+     * loads the compiled machine, setting the error message on failure
+     *
+     * @param compiler a string representing the command of the C compiler
+     * @param cache_directory a string representing the directory to store
+     *     compiled machines in
+     */
+    void CompileAndLoad(const std::string &compiler, const std::string
+        &cache_directory);
+
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method adds blank headroom to both sides of the compiled machine's
+     * tape
+     */
+    void Grow();
+
+    /**
+     * ExecutionContext storing the interpreter the machine falls back to (run
+     * on the program and configuration of the turing machine, without its
+     * listeners) and the program of the machine
+     */
+    ExecutionContext execution_context_;
+
+    /**
+     * string storing the generated C source
+     */
+    std::string source_;
+
+    /**
+     * string storing the path of the compiled shared object
+     */
+    std::string artifact_path_;
+
+    /**
+     * shared pointer holding the handle of the loaded shared object (closed
+     * once the last copy of the machine is destroyed)
+     */
+    std::shared_ptr<void> library_;
+
+    /**
+     * function pointer storing the compiled run function
+     */
+    uint64_t (*run_function_)(NativeMachineContext *, uint64_t) = nullptr;
+
+    /**
+     * vector storing the cells of the compiled machine's tape surrounded by
+     * blank headroom
+     */
+    std::vector<char> cells_;
+
+    /**
+     * NativeMachineContext storing the configuration of the compiled machine
+     * (its cells pointer is only set while running)
+     */
+    NativeMachineContext context_ = NativeMachineContext();
+
+    /**
+     * char storing the blank character of the tape
+     */
+    char blank_character_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * string storing why the machine fell back to the interpreter
+     */
+    std::string error_message_ = "";
+
+    /**
+     * bool that is true if the machine runs compiled code
+     */
+    bool is_compiled_ = false;
+
+    /**
+     * bool that is true if the native machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
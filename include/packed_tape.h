@@ -0,0 +1,299 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing a tape whose cells are packed into 1, 2, 4, or 8 bits
+ * Each character of the alphabet of the tape is given a code (the blank
+ * character is always code 0) and the cells store codes, the fewest bits that
+ * fit every code, in 64 bit words; cells never straddle words, so an alphabet
+ * of 3 characters uses 2 bits per cell and an alphabet of 5 to 16 characters
+ * uses 4 bits per cell
+ * Like Tape, the words are surrounded by blank headroom (words of 0) so the
+ * tape can grow at either end in amortized O(1) time
+ * Read, Write, MoveLeft and MoveRight are only a few shifts and masks, so
+ * they are defined in the header where the step loop can inline them
+ */
+class PackedTape {
+  public:
+    /**
+     * Default constructor
+     */
+    PackedTape() = default;
+
+    /**
+     * This method creates a packed tape containing the given cells with the
+     * scanner reading the first cell
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param alphabet a vector of chars representing the characters that may
+     *     be written on the tape (the blank character and the characters of
+     *     the given cells are always added)
+     */
+    PackedTape(const std::vector<char> &cells, char blank_character, const
+        std::vector<char> &alphabet);
+
+    /**
+     * This method returns the code of the character the scanner is reading
+     *
+     * @return a uint8_t representing the code of the character being read
+     */
+    uint8_t Read() const {
+      return static_cast<uint8_t>((words_[scanner_ >> cells_per_word_shift_]
+          >> GetShiftOfCell(scanner_)) & cell_mask_);
+    }
+
+    /**
+     * This method writes the character with the given code where the scanner
+     * is
+     *
+     * @param code a uint8_t representing the code of the character to write
+     */
+    void Write(uint8_t code) {
+      uint64_t &word = words_[scanner_ >> cells_per_word_shift_];
+      const size_t kShift = GetShiftOfCell(scanner_);
+      word = (word & ~(cell_mask_ << kShift))
+          | (static_cast<uint64_t>(code) << kShift);
+    }
+
+    /**
+     * This method moves the scanner 1 cell left, adding a blank cell to the
+     * start of the tape if the scanner is on the first cell
+     */
+    void MoveLeft() {
+      if (scanner_ == begin_) {
+        if (begin_ == 0) {
+          GrowLeft();
+        }
+        begin_ -= 1;
+      }
+      scanner_ -= 1;
+    }
+
+    /**
+     * This method moves the scanner 1 cell right, adding a blank cell to the
+     * end of the tape if the scanner is on the last cell
+     */
+    void MoveRight() {
+      scanner_ += 1;
+      if (scanner_ == end_) {
+        if (end_ == GetCapacity()) {
+          GrowRight();
+        }
+        end_ += 1;
+      }
+    }
+
+    /**
+     * This method moves the scanner right past the cells holding the given
+     * code, a word at a time, stopping at the first cell holding another code,
+     * after the given number of cells, or on the last cell of the tape
+     * (whichever comes first)
+     * NOTE: this is how a run of steps that reads a code, writes it back, and
+     * moves right (a sweep that does not change a cell) is taken at once
+     *
+     * @param code a uint8_t representing the code of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipRight(uint8_t code, uint64_t max_cells);
+
+    /**
+     * This method moves the scanner left past the cells holding the given
+     * code, with the same meaning as SkipRight (stopping on the first cell of
+     * the tape instead of the last)
+     *
+     * @param code a uint8_t representing the code of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipLeft(uint8_t code, uint64_t max_cells);
+
+    /**
+     * This method returns the code of the given character
+     *
+     * @param character a char in the alphabet of the tape
+     * @return a uint8_t representing the code of the character (0, the code
+     *     of the blank character, if the character is not in the alphabet)
+     */
+    uint8_t GetCode(char character) const {
+      return code_by_character_[static_cast<unsigned char>(character)];
+    }
+
+    /**
+     * This method returns the character with the given code
+     *
+     * @param code a uint8_t representing the code of a character
+     * @return a char representing the character with the code
+     */
+    char GetCharacter(uint8_t code) const {
+      return alphabet_[code];
+    }
+
+    /**
+     * This method returns the characters of the alphabet in the order of their
+     * codes
+     *
+     * @return a vector of chars representing the alphabet of the tape
+     */
+    const std::vector<char> &GetAlphabet() const;
+
+    /**
+     * This method returns the number of bits each cell is packed into
+     *
+     * @return a size_t representing the number of bits per cell (1, 2, 4, or
+     *     8)
+     */
+    size_t GetBitsPerCell() const;
+
+    /**
+     * This method returns the cells of the tape from left to right
+     *
+     * @return a vector of chars representing the cells of the tape
+     */
+    std::vector<char> GetCells() const;
+
+    /**
+     * This method returns the character in the cell at the given index
+     *
+     * @param index a size_t representing the index of a cell (0 is the
+     *     leftmost cell of the tape)
+     * @return a char representing the character in the cell
+     */
+    char GetCell(size_t index) const;
+
+    size_t GetSize() const;
+
+    size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape the machine started with (negative if the scanner is
+     * to the left of that cell)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    char GetBlankCharacter() const;
+
+    /**
+     * This method returns the number of bytes of memory used by the cells of
+     * the tape, including the headroom
+     *
+     * @return a size_t representing the number of bytes used by the cells
+     */
+    size_t GetNumberOfBytes() const;
+
+  private:
+    /**
+     * This method returns the number of bits a word is shifted right by to
+     * move the cell at the given index in the buffer to the lowest bits
+     *
+     * @param index a size_t representing the index of a cell in the buffer
+     * @return a size_t representing the shift of the cell
+     */
+    size_t GetShiftOfCell(size_t index) const {
+      return (index & (cells_per_word_ - 1)) * bits_per_cell_;
+    }
+
+    /**
+     * This method returns the number of cells the buffer can hold
+     *
+     * @return a size_t representing the number of cells in the buffer
+     */
+    size_t GetCapacity() const {
+      return words_.size() << cells_per_word_shift_;
+    }
+
+    /**
+     * This method returns the code of the cell at the given index in the
+     * buffer
+     *
+     * @param index a size_t representing the index of a cell in the buffer
+     * @return a uint8_t representing the code of the cell
+     */
+    uint8_t GetCodeAt(size_t index) const {
+      return static_cast<uint8_t>((words_[index >> cells_per_word_shift_]
+          >> GetShiftOfCell(index)) & cell_mask_);
+    }
+
+    /**
+     * This method reallocates the buffer with more blank headroom at its start
+     */
+    void GrowLeft();
+
+    /**
+     * This method reallocates the buffer with more blank headroom at its end
+     */
+    void GrowRight();
+
+    /**
+     * vector storing the cells of the tape surrounded by blank headroom, packed
+     * into 64 bit words (the cell at index i of the buffer is in word
+     * i / cells per word, starting at bit (i % cells per word) * bits per cell)
+     */
+    std::vector<uint64_t> words_;
+
+    /**
+     * vector storing the characters of the alphabet by their code
+     */
+    std::vector<char> alphabet_;
+
+    /**
+     * array storing the code of each character (by its unsigned value)
+     */
+    std::array<uint8_t, 256> code_by_character_ = {};
+
+    /**
+     * size_t storing the number of bits each cell is packed into
+     */
+    size_t bits_per_cell_ = 8;
+
+    /**
+     * size_t storing the number of cells in a word
+     */
+    size_t cells_per_word_ = 8;
+
+    /**
+     * size_t storing log2 of the number of cells in a word
+     */
+    size_t cells_per_word_shift_ = 3;
+
+    /**
+     * uint64_t storing a mask of the lowest bits_per_cell_ bits
+     */
+    uint64_t cell_mask_ = 0xff;
+
+    /**
+     * size_t storing the index in the buffer of the leftmost cell of the tape
+     */
+    size_t begin_ = 0;
+
+    /**
+     * size_t storing the index in the buffer after the rightmost cell of the
+     * tape
+     */
+    size_t end_ = 0;
+
+    /**
+     * size_t storing the index in the buffer of the cell the scanner is reading
+     */
+    size_t scanner_ = 0;
+
+    /**
+     * int64_t storing the index in the buffer of the first cell of the tape
+     * the machine started with
+     */
+    int64_t origin_ = 0;
+};
+
+} // namespace turingmachinesimulator
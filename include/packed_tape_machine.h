@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "packed_tape.h"
+#include "run_result.h"
+#include "state.h"
+#include "transition_table.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a transition of a packed tape machine, which reads and
+ * writes codes of the alphabet of the tape instead of characters
+ */
+struct PackedTransition {
+  /**
+   * uint32_t storing the index (in the transition table) of the state to move
+   * to
+   */
+  uint32_t state_to_move_to = 0;
+
+  /**
+   * uint8_t storing the code of the character to write on the tape
+   */
+  uint8_t write = 0;
+
+  /**
+   * int8_t storing how far the scanner moves: -1 (left), 0 (no movement), or
+   * 1 (right)
+   */
+  int8_t scanner_offset = 0;
+
+  /**
+   * bool that is true if a direction exists for the state and read code of
+   * this transition, and false otherwise
+   */
+  bool is_defined = false;
+
+  /**
+   * bool that is true if the transition is a sweep: it writes the code it
+   * reads, moves the scanner, and stays in the same (non-halting) state, so a
+   * run of cells holding the code can be skipped at once
+   */
+  bool is_sweep = false;
+};
+
+/**
+ * Class that runs a turing machine on a PackedTape
+ * Machines with small alphabets (most use 2 to 4 characters) pack each cell
+ * into 1 or 2 bits, so long tapes use 4 to 8 times less memory and more of
+ * the tape fits in the cache; sweeps over cells that are not changed move the
+ * scanner a word of cells at a time; runs produce the same configurations as
+ * TuringMachine::Run and TuringMachine::RunUntilHalt
+ */
+class PackedTapeMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    PackedTapeMachine() = default;
+
+    /**
+     * This method creates a packed tape machine that continues from the
+     * current configuration of the given turing machine, with the alphabet of
+     * its tape made of the blank character and the characters read or
+     * written by its directions
+     *
+     * @param turing_machine a TuringMachine to run on a packed tape
+     */
+    explicit PackedTapeMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    const PackedTape &GetPackedTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * TransitionTable storing the states of the machine by their index
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * vector storing the transitions of the machine indexed by (state index *
+     * size of the alphabet + code read)
+     */
+    std::vector<PackedTransition> transitions_;
+
+    /**
+     * size_t storing the number of characters in the alphabet of the tape
+     */
+    size_t alphabet_size_ = 0;
+
+    /**
+     * PackedTape storing the tape of the machine
+     */
+    PackedTape tape_;
+
+    /**
+     * uint32_t storing the index (in the transition table) of the current
+     * state
+     */
+    uint32_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the packed tape machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "direction.h"
+#include "state.h"
+#include "transition_table.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing the compiled rules of a turing machine: its states,
+ * directions, and transition table, validated once when it is created
+ * A program never changes after it is created, so 1 program can be shared
+ * (for example through a std::shared_ptr<const Program>) by any number of
+ * ExecutionContexts running on any number of threads
+ */
+class Program {
+  public:
+    /**
+     * Default constructor
+     */
+    Program() = default;
+
+    /**
+     * This method creates a program from the given states and directions
+     *
+     * @param states a vector of States representing the states of the turing
+     *     machine
+     * @param directions a vector of Directions representing the directions for
+     *     the turing machine
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    Program(const std::vector<State> &states, const std::vector<Direction>
+        &directions, const std::vector<std::string> &halting_state_names);
+
+    /**
+     * This method creates a copy of the given program whose transition table
+     * has its states reordered (see TransitionTable::ReorderStates)
+     *
+     * @param program a Program to copy
+     * @param state_order a vector of size_ts representing the index in the
+     *     table of the given program of the state to put at each new index
+     */
+    Program(const Program &program, const std::vector<size_t> &state_order);
+
+    const std::vector<State> &GetHaltingStates() const;
+
+    const std::map<State, std::vector<Direction>> &GetDirectionsByStateMap()
+        const;
+
+    /**
+     * This method returns the compiled transition table of the program
+     *
+     * @return a reference to the TransitionTable of the program
+     */
+    const TransitionTable &GetTransitionTable() const;
+
+    /**
+     * This method returns the index (in the transition table) of the starting
+     * state
+     *
+     * @return a size_t representing the index of the starting state
+     */
+    size_t GetStartingStateIndex() const;
+
+    /**
+     * This method returns the starting state, which is kept even if the
+     * program is empty because a later check (such as on the directions)
+     * failed
+     *
+     * @return a State representing the starting state (empty if there is no
+     *     starting state)
+     */
+    State GetStartingState() const;
+
+    std::string GetErrorMessage() const;
+
+    /**
+     * This method returns true if the program is empty (encountered
+     * initialization error or was created with the default constructor)
+     *
+     * @return a bool that is true if the program is empty
+     */
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * vector of states storing the halting states of the program
+     */
+    std::vector<State> halting_states_;
+
+    /**
+     * map storing states of the program as the keys and vectors of directions
+     * that move from the key state as the values
+     */
+    std::map<State, std::vector<Direction>> directions_by_state_map_;
+
+    /**
+     * TransitionTable storing the directions of the program compiled for fast
+     * lookup by state index and read character
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * size_t storing the index (in the transition table) of the starting state
+     */
+    size_t starting_state_index_ = 0;
+
+    /**
+     * State storing the starting state
+     */
+    State starting_state_;
+
+    /**
+     * string storing the error message of the program
+     */
+    std::string error_message_ = "";
+
+    /**
+     * bool that is true if the program is not successfully initialized or was
+     * initialized with the default constructor
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
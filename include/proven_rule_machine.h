@@ -0,0 +1,396 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "run_length_tape.h"
+#include "run_result.h"
+#include "state.h"
+#include "step_count.h"
+#include "transition_table.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * This method returns the given number of steps written in decimal
+ *
+ * @param step_count a StepCount representing a number of steps
+ * @return a string representing the number of steps in decimal
+ */
+std::string StepCountToString(StepCount step_count);
+
+/**
+ * Struct representing a linear expression c + a0 * x0 + a1 * x1 + ... in the
+ * variables of a ProvenRule
+ */
+struct LinearExpression {
+  /**
+   * int64_t storing the constant term of the expression
+   */
+  int64_t constant = 0;
+
+  /**
+   * vector storing the coefficient of each variable (by variable index)
+   */
+  std::vector<int64_t> coefficients;
+};
+
+/**
+ * Struct representing a rule proven about a shape of the tape: from a
+ * configuration with that shape (the current state, the character being read,
+ * and the characters of the runs) and the same lengths of the runs that are
+ * not variables, a fixed number of iterations reaches the same shape again
+ * with the lengths of the other runs (the variables of the rule) changed by
+ * constants
+ * NOTE: the rule holds for any lengths at least the minimums of the variables,
+ * so it can be applied n times at once
+ */
+struct ProvenRule {
+  /**
+   * vector storing the lengths of the runs to the left of the scanner when
+   * the rule was proven (the runs that are not variables must have these
+   * lengths)
+   */
+  std::vector<uint64_t> num_cells_by_left_run;
+
+  /**
+   * vector storing the lengths of the runs to the right of the scanner when
+   * the rule was proven
+   */
+  std::vector<uint64_t> num_cells_by_right_run;
+
+  /**
+   * vector storing the variable of each run to the left of the scanner (-1
+   * for runs whose lengths never change)
+   */
+  std::vector<int> variable_by_left_run;
+
+  /**
+   * vector storing the variable of each run to the right of the scanner (-1
+   * for runs whose lengths never change)
+   */
+  std::vector<int> variable_by_right_run;
+
+  /**
+   * vector storing the smallest value of each variable the rule holds for
+   */
+  std::vector<uint64_t> minimum_by_variable;
+
+  /**
+   * vector storing how much each application of the rule changes each
+   * variable
+   */
+  std::vector<int64_t> change_by_variable;
+
+  /**
+   * LinearExpression storing the number of steps of 1 application of the rule
+   * in terms of the variables at its start
+   */
+  LinearExpression num_steps;
+
+  /**
+   * LinearExpression storing how far 1 application of the rule moves the
+   * scanner (negative for left) in terms of the variables at its start
+   */
+  LinearExpression scanner_offset;
+
+  /**
+   * uint64_t storing the number of iterations (steps or chain steps) of 1
+   * application of the rule
+   */
+  uint64_t num_iterations = 0;
+};
+
+/**
+ * Class that runs a turing machine on a RunLengthTape, proving and applying
+ * rules for counter-like behavior
+ * Like RunLengthMachine, runs of steps that loop on a state are taken as
+ * chain steps; in addition, whenever the tape returns to a shape it had
+ * before with only the lengths of some runs changed, the machine tries to
+ * prove (by running the iterations in between on symbolic run lengths) that
+ * the change happens again from any lengths, and then applies the rule as
+ * many times as the lengths and the step budget allow at once, with the
+ * number of steps computed in closed form (shapes are only taken in windows
+ * of iterations that grow further apart while no rule applies); machines
+ * that take 10^12 steps or more counting up and down in unary finish in
+ * milliseconds
+ * Runs produce the same configurations and step counts as TuringMachine::Run
+ * and TuringMachine::RunUntilHalt, and the number of steps is counted in 128
+ * bits
+ */
+class ProvenRuleMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    ProvenRuleMachine() = default;
+
+    /**
+     * This method creates a proven rule machine that continues from the
+     * current configuration of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to run with proven rules
+     */
+    explicit ProvenRuleMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    const RunLengthTape &GetRunLengthTape() const;
+
+    uint64_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape of the turing machine the machine was created from
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    State GetCurrentState() const;
+
+    /**
+     * This method returns the number of steps taken since the turing machine
+     * the machine was created from started
+     *
+     * @return a StepCount representing the number of steps taken
+     */
+    StepCount GetNumberOfSteps() const;
+
+    /**
+     * This method returns the number of rules proven so far
+     *
+     * @return a size_t representing the number of rules proven
+     */
+    size_t GetNumberOfProvenRules() const;
+
+    /**
+     * This method returns the number of times proven rules were applied (a
+     * rule applied n times at once counts n times)
+     *
+     * @return a uint64_t representing the number of rule applications
+     */
+    uint64_t GetNumberOfRuleApplications() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * Struct representing the lengths of the runs of the tape the last time
+     * it had a shape
+     */
+    struct RunLengths {
+      /**
+       * uint64_t storing the number of iterations taken when the lengths
+       * were recorded
+       */
+      uint64_t iteration = 0;
+
+      /**
+       * vector storing the lengths of the runs to the left of the scanner
+       */
+      std::vector<uint64_t> num_cells_by_left_run;
+
+      /**
+       * vector storing the lengths of the runs to the right of the scanner
+       */
+      std::vector<uint64_t> num_cells_by_right_run;
+
+      /**
+       * size_t storing the number of failed attempts to prove a rule for the
+       * shape
+       */
+      size_t num_failed_proofs = 0;
+    };
+
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     *
+     * @param max_steps a StepCount representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a StepCount representing the number of steps taken
+     */
+    StepCount RunSteps(StepCount max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method returns true if the current iteration is in a window of
+     * iterations whose shapes are taken; a window ends after
+     * kShapeWindow iterations or once its proofs have run
+     * kMaxProofIterationsPerWindow iterations, and after a window in which
+     * no rule was applied, the next window starts twice as many iterations
+     * later as the last 1 did (up to kMaxShapeSkip), since taking shapes and
+     * proving rules costs far more than the iterations of a machine that
+     * never counts
+     *
+     * @return a bool that is true if the shape should be taken
+     */
+    bool IsTakingShapes();
+
+    /**
+     * This method writes the shape of the tape into shape_: the current
+     * state, the number of runs to the left of the scanner, the character
+     * being read, and the characters of the runs
+     * NOTE: the shape is written over the last 1, so taking it does not
+     * allocate once shape_ is long enough
+     */
+    void UpdateShape();
+
+    /**
+     * This method returns a rule proven for the current shape of the tape
+     * that applies to the lengths of its runs
+     *
+     * @param shape a string representing the current shape of the tape
+     * @return a pointer to the rule (null if there is none)
+     */
+    const ProvenRule *FindRule(const std::string &shape) const;
+
+    /**
+     * This method records the lengths of the runs of the current shape of the
+     * tape, first trying to prove a rule from the lengths recorded the last
+     * time the tape had that shape
+     *
+     * @param shape a string representing the current shape of the tape
+     * @return a pointer to the rule proven (null if none was)
+     */
+    const ProvenRule *LearnRule(const std::string &shape);
+
+    /**
+     * This method tries to prove a rule from the current configuration,
+     * whose run lengths differ from the given earlier lengths of the same
+     * shape
+     *
+     * @param earlier_run_lengths a RunLengths representing the lengths of the
+     *     runs the last time the tape had the current shape
+     * @param rule a ProvenRule to store the rule in if it is proven
+     * @return a bool that is true if a rule was proven
+     */
+    bool ProveRule(const RunLengths &earlier_run_lengths, ProvenRule &rule)
+        const;
+
+    /**
+     * This method applies the given rule (proven for the current shape) as
+     * many times as its minimums and the given number of steps allow
+     *
+     * @param rule a ProvenRule proven for the current shape of the tape
+     * @param max_steps a StepCount representing the most steps to take
+     * @return a StepCount representing the number of steps taken (0 if the
+     *     rule was not applied)
+     */
+    StepCount ApplyRule(const ProvenRule &rule, StepCount max_steps);
+
+    /**
+     * TransitionTable storing the compiled directions of the machine
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * RunLengthTape storing the tape of the machine
+     */
+    RunLengthTape tape_;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * StepCount storing the number of steps the machine has taken
+     */
+    StepCount num_steps_ = 0;
+
+    /**
+     * int64_t storing the position of the scanner
+     */
+    int64_t position_of_scanner_ = 0;
+
+    /**
+     * uint64_t storing the number of iterations (steps, chain steps, or
+     * iterations inside rule applications) taken
+     */
+    uint64_t num_iterations_ = 0;
+
+    /**
+     * uint64_ts storing the iterations the current window of shapes starts
+     * and ends at, and the number of iterations skipped before it
+     */
+    uint64_t shape_window_start_ = 0;
+    uint64_t shape_window_end_ = 0;
+    uint64_t num_iterations_skipped_ = 0;
+
+    /**
+     * uint64_t storing the number of rule applications when the current
+     * window of shapes started
+     */
+    uint64_t num_rule_applications_at_window_start_ = 0;
+
+    /**
+     * uint64_t storing the number of iterations the proofs of the current
+     * window of shapes have run
+     */
+    uint64_t num_proof_iterations_in_window_ = 0;
+
+    /**
+     * string storing the shape of the tape the last time it was taken
+     */
+    std::string shape_;
+
+    /**
+     * unordered map storing the last run lengths seen for each shape of the
+     * tape
+     */
+    std::unordered_map<std::string, RunLengths> run_lengths_by_shape_;
+
+    /**
+     * unordered map storing the rules proven for each shape of the tape
+     */
+    std::unordered_map<std::string, std::vector<ProvenRule>> rules_by_shape_;
+
+    /**
+     * size_t storing the number of rules proven
+     */
+    size_t num_proven_rules_ = 0;
+
+    /**
+     * uint64_t storing the number of times proven rules were applied
+     */
+    uint64_t num_rule_applications_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the proven rule machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "run_length_tape.h"
+#include "run_result.h"
+#include "state.h"
+#include "transition_table.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class that runs a turing machine on a RunLengthTape
+ * Whenever the direction being followed loops on its state while moving the
+ * scanner, every cell of the run being read gets the same direction, so the
+ * whole run is rewritten and crossed in 1 chain step; machines that build
+ * long unary or binary blocks run in time proportional to the number of runs
+ * they cross rather than the number of cells; runs produce the same
+ * configurations and step counts as TuringMachine::Run and
+ * TuringMachine::RunUntilHalt
+ */
+class RunLengthMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    RunLengthMachine() = default;
+
+    /**
+     * This method creates a run length machine that continues from the
+     * current configuration of the given turing machine
+     *
+     * @param turing_machine a TuringMachine to run on a run length tape
+     */
+    explicit RunLengthMachine(const TuringMachine &turing_machine);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    const RunLengthTape &GetRunLengthTape() const;
+
+    uint64_t GetIndexOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    /**
+     * This method returns the number of chain steps taken (each of which
+     * counts as the number of cells it crossed in the number of steps)
+     *
+     * @return a uint64_t representing the number of chain steps taken
+     */
+    uint64_t GetNumberOfChainSteps() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * TransitionTable storing the compiled directions of the machine
+     */
+    TransitionTable transition_table_;
+
+    /**
+     * RunLengthTape storing the tape of the machine
+     */
+    RunLengthTape tape_;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * uint64_t storing the number of chain steps the machine has taken
+     */
+    uint64_t num_chain_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the run length machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
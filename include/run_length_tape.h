@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a run of cells holding the same character
+ */
+struct TapeRun {
+  /**
+   * char storing the character of every cell of the run
+   */
+  char character = 0;
+
+  /**
+   * uint64_t storing the number of cells in the run
+   */
+  uint64_t num_cells = 0;
+};
+
+/**
+ * Class representing a tape stored as runs of equal cells rather than as
+ * single cells
+ * The runs to the left and to the right of the scanner are kept on 2 stacks
+ * whose tops are next to the scanner, so moving the scanner, and rewriting a
+ * whole run while moving across it (a chain step), take O(1) time; the cells
+ * the scanner has never reached beyond either end of the tape are blank and
+ * are not stored
+ */
+class RunLengthTape {
+  public:
+    /**
+     * Default constructor
+     */
+    RunLengthTape() = default;
+
+    /**
+     * This method creates a run length tape containing the given cells with
+     * the scanner reading the cell at the given index
+     *
+     * @param cells a vector of chars representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a char representing the blank character of the
+     *     tape
+     * @param index_of_scanner a size_t representing the index of the cell the
+     *     scanner is reading
+     */
+    RunLengthTape(const std::vector<char> &cells, char blank_character, size_t
+        index_of_scanner);
+
+    /**
+     * This method returns the character the scanner is reading
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @return a char representing the character the scanner is reading
+     */
+    char Read() const {
+      return scanned_character_;
+    }
+
+    /**
+     * This method writes the given character where the scanner is
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param character a char representing the character to write
+     */
+    void Write(char character) {
+      scanned_character_ = character;
+    }
+
+    /**
+     * This method moves the scanner 1 cell left, adding a blank cell to the
+     * start of the tape if the scanner is on the first cell
+     */
+    void MoveLeft();
+
+    /**
+     * This method moves the scanner 1 cell right, adding a blank cell to the
+     * end of the tape if the scanner is on the last cell
+     */
+    void MoveRight();
+
+    /**
+     * This method takes a chain step to the right: the run of cells holding
+     * the character being read, starting at the scanner, is rewritten with the
+     * given character and the scanner moves past it, as if each of its cells
+     * were read, written, and moved right from 1 step at a time
+     * NOTE: a run of blanks that reaches past the end of the tape never ends,
+     * so at most the given number of cells is taken
+     *
+     * @param character a char representing the character to write
+     * @param max_cells a uint64_t representing the most cells to take (at
+     *     least 1)
+     * @return a uint64_t representing the number of cells taken
+     */
+    uint64_t ChainRight(char character, uint64_t max_cells);
+
+    /**
+     * This method takes a chain step to the left, with the same meaning as
+     * ChainRight
+     *
+     * @param character a char representing the character to write
+     * @param max_cells a uint64_t representing the most cells to take (at
+     *     least 1)
+     * @return a uint64_t representing the number of cells taken
+     */
+    uint64_t ChainLeft(char character, uint64_t max_cells);
+
+    /**
+     * This method returns the cells of the tape from left to right
+     *
+     * @return a vector of chars representing the cells of the tape
+     */
+    std::vector<char> GetCells() const;
+
+    uint64_t GetSize() const;
+
+    uint64_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the number of runs stored for the tape (the cells
+     * to either side of the scanner, not counting the cell being read)
+     *
+     * @return a size_t representing the number of runs
+     */
+    size_t GetNumberOfRuns() const;
+
+    /**
+     * This method returns the runs to the left of the scanner
+     *
+     * @return a reference to the runs, the back is the run next to the
+     *     scanner
+     */
+    const std::vector<TapeRun> &GetLeftRuns() const;
+
+    /**
+     * This method returns the runs to the right of the scanner
+     *
+     * @return a reference to the runs, the back is the run next to the
+     *     scanner
+     */
+    const std::vector<TapeRun> &GetRightRuns() const;
+
+    /**
+     * This method changes the number of cells in each run without changing
+     * the characters of the runs (so the tape keeps its shape)
+     *
+     * @param num_cells_by_left_run a vector of uint64_ts representing the new
+     *     number of cells of each run to the left of the scanner (at least 1)
+     * @param num_cells_by_right_run a vector of uint64_ts representing the new
+     *     number of cells of each run to the right of the scanner (at least 1)
+     */
+    void SetNumbersOfCells(const std::vector<uint64_t> &num_cells_by_left_run,
+        const std::vector<uint64_t> &num_cells_by_right_run);
+
+    char GetBlankCharacter() const;
+
+  private:
+    /**
+     * This method takes the given number of cells of the given character from
+     * the top of the given stack of runs, where the character is known to fill
+     * them (cells past the bottom of the stack are blank)
+     *
+     * @param runs a vector of TapeRuns to take the cells from
+     * @param num_cells a uint64_t representing the number of cells to take
+     */
+    static void TakeCells(std::vector<TapeRun> &runs, uint64_t num_cells);
+
+    /**
+     * This method returns the character of the cell on top of the given stack
+     * of runs, taking the cell from the stack
+     *
+     * @param runs a vector of TapeRuns to take the cell from
+     * @return a char representing the character of the cell
+     */
+    char TakeCell(std::vector<TapeRun> &runs);
+
+    /**
+     * This method adds the given number of cells of the given character to
+     * the top of the given stack of runs, merging them into the top run if it
+     * holds the same character
+     *
+     * @param runs a vector of TapeRuns to add the cells to
+     * @param character a char representing the character of the cells
+     * @param num_cells a uint64_t representing the number of cells to add
+     */
+    static void AddCells(std::vector<TapeRun> &runs, char character, uint64_t
+        num_cells);
+
+    /**
+     * This method returns the number of cells in the run of the given
+     * character on top of the given stack, or 0 if the top run holds another
+     * character; if the run reaches past the end of the tape (the character
+     * is blank and nothing else is on the stack), the run never ends and
+     * UINT64_MAX is returned
+     *
+     * @param runs a vector of TapeRuns
+     * @param character a char representing the character of the run
+     * @return a uint64_t representing the number of cells in the run
+     */
+    uint64_t GetLengthOfTopRun(const std::vector<TapeRun> &runs, char
+        character) const;
+
+    /**
+     * vector storing the runs to the left of the scanner, the back is the run
+     * next to the scanner
+     */
+    std::vector<TapeRun> left_runs_;
+
+    /**
+     * vector storing the runs to the right of the scanner, the back is the
+     * run next to the scanner
+     */
+    std::vector<TapeRun> right_runs_;
+
+    /**
+     * char storing the character of the cell the scanner is reading
+     */
+    char scanned_character_ = 0;
+
+    /**
+     * uint64_t storing the number of cells to the left of the scanner
+     */
+    uint64_t num_cells_left_of_scanner_ = 0;
+
+    /**
+     * uint64_t storing the number of cells to the right of the scanner
+     */
+    uint64_t num_cells_right_of_scanner_ = 0;
+
+    /**
+     * char storing the blank character of the tape
+     */
+    char blank_character_ = 0;
+
+    /**
+     * bool that is true if the tape was created with the default constructor
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace turingmachinesimulator {
+
+/**
+ * Enum representing how TuringMachine::Run and TuringMachine::RunUntilHalt
+ * take their steps (every mode reaches the same configurations and step
+ * counts)
+ */
+enum class RunMode : uint8_t {
+  kStepByStep, // the steps are taken 1 at a time (runs of sweeps at once)
+  kProvenRules // the steps are taken by a ProvenRuleMachine, which applies
+               // proven rules many times at once
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing the outcome of running a turing machine for a batch of
+ * steps
+ */
+struct RunResult {
+  /**
+   * uint64_t storing the number of steps taken during the run
+   */
+  uint64_t num_steps = 0;
+
+  /**
+   * bool that is true if the machine is in a halting state at the end of the
+   * run
+   */
+  bool is_halted = false;
+
+  /**
+   * int storing the id of the state the machine is in at the end of the run
+   */
+  int final_state_id = 0;
+
+  /**
+   * size_t storing the index of the tape the scanner is reading at the end of
+   * the run
+   */
+  size_t index_of_scanner = 0;
+};
+
+} // namespace turingmachinesimulator
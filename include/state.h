@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "cinder/gl/gl.h"
+#include "name_table.h"
 
 namespace turingmachinesimulator {
 
 /**
  * Class representing a State of a Turing Machine
+ * NOTE: names are interned in the NameTable, so a state only stores ids and
+ * numbers and copying it never copies a string
  */
 class State {
   public: 
@@ -37,7 +41,13 @@ class State {
     
     void SetStateName(const std::string &state_name);
     
-    std::string GetStateName() const;
+    /**
+     * This method returns the name of the state without copying it
+     *
+     * @return a reference to the name held by the NameTable (valid for the
+     *     whole program)
+     */
+    const std::string &GetStateName() const;
     
     void SetStateLocation(const glm::vec2 &state_location);
 
@@ -113,7 +123,10 @@ class State {
     
     int id_; // an int storing the unique id of the state
     
-    std::string state_name_; // a string storing the name of the the state
+    /**
+     * a uint32_t storing the id of the name of the state in the NameTable
+     */
+    uint32_t state_name_id_ = 0;
     
     /**
      * a vec2 storing the location of the center of the state in the simulator
@@ -133,9 +146,10 @@ class State {
     bool is_empty_ = true;
     
     /**
-     * a vector storing the possible names for halting states
+     * a uint32_t storing the id of the list of possible names for halting
+     * states in the NameTable
      */
-    std::vector<std::string> possible_halting_state_names_;
+    uint32_t possible_halting_state_names_id_ = 0;
 };
 
 } // namespace turingmachinesimulator
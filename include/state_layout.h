@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "program.h"
+#include "tape.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing how spread out the transition table accesses of a
+ * warm-up run are before and after the states are reordered, a proxy for the
+ * cache misses of running the machine
+ */
+struct StateLayoutReport {
+  /**
+   * uint64_t storing the number of steps of the warm-up run
+   */
+  uint64_t num_steps_profiled = 0;
+
+  /**
+   * double storing the mean distance in bytes between the table entries of
+   * successive steps with the states in their original order
+   */
+  double mean_access_distance_before = 0;
+
+  /**
+   * double storing the mean distance in bytes between the table entries of
+   * successive steps with the states reordered
+   */
+  double mean_access_distance_after = 0;
+
+  /**
+   * double storing the fraction of successive steps whose table entries are
+   * at least a cache line apart with the states in their original order
+   */
+  double far_access_rate_before = 0;
+
+  /**
+   * double storing the fraction of successive steps whose table entries are
+   * at least a cache line apart with the states reordered
+   */
+  double far_access_rate_after = 0;
+};
+
+/**
+ * Class representing a profile of which transitions a warm-up run of a
+ * program takes, used to renumber the states so that hot states and the
+ * states that usually follow them have neighbouring rows in the transition
+ * table
+ * The order is built greedily: starting from the hottest state not placed
+ * yet, each state is followed by its most frequent successor not placed yet;
+ * states the warm-up never reached keep their order at the end
+ */
+class StateLayoutProfiler {
+  public:
+    /**
+     * This method creates a profiler of the given program
+     *
+     * @param program a shared pointer to the Program to profile
+     */
+    explicit StateLayoutProfiler(const std::shared_ptr<const Program>
+        &program);
+
+    /**
+     * This method runs the program on a copy of the given tape, step by step,
+     * counting the transitions it takes until it halts, has no direction to
+     * follow, or has taken the given number of steps
+     *
+     * @param tape a Tape representing the tape to start from
+     * @param state_index a size_t representing the index of the state to start
+     *     in
+     * @param max_steps a uint64_t representing the most steps to take
+     */
+    void Profile(const Tape &tape, size_t state_index, uint64_t max_steps);
+
+    /**
+     * This method returns the order to put the states of the program in, to
+     * give to TransitionTable::ReorderStates
+     *
+     * @return a vector of size_ts representing the current index of the state
+     *     to put at each new index
+     */
+    std::vector<size_t> GetStateOrder() const;
+
+    /**
+     * This method returns the spread of the table accesses of the profiled
+     * steps with the states in their original order and in GetStateOrder
+     *
+     * @return a StateLayoutReport of the profiled steps
+     */
+    StateLayoutReport GetReport() const;
+
+  private:
+    /**
+     * This method adds up the distances between the table entries of
+     * successive profiled steps with the states at the given indices
+     *
+     * @param new_index_by_index a vector of size_ts representing the index of
+     *     each state
+     * @param mean_access_distance a reference to the double to store the mean
+     *     distance in bytes in
+     * @param far_access_rate a reference to the double to store the fraction
+     *     of distances of at least a cache line in
+     */
+    void MeasureSpread(const std::vector<size_t> &new_index_by_index, double
+        &mean_access_distance, double &far_access_rate) const;
+
+    /**
+     * shared pointer storing the program being profiled
+     */
+    std::shared_ptr<const Program> program_;
+
+    /**
+     * vector storing the number of profiled steps taken from each state
+     */
+    std::vector<uint64_t> num_steps_by_state_;
+
+    /**
+     * unordered map storing the number of times each pair of table entries
+     * was used by 2 successive steps, keyed by first entry * number of entries
+     * + second entry
+     */
+    std::unordered_map<uint64_t, uint64_t> num_steps_by_entry_pair_;
+
+    /**
+     * uint64_t storing the number of steps profiled
+     */
+    uint64_t num_steps_profiled_ = 0;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "configuration_formatter.h"
+#include "run_result.h"
+#include "state.h"
+#include "tape.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a direction known at compile time: in the state with
+ * the id from_state_id, reading the character read, write the character write,
+ * move the scanner (l = left, r = right, n = no move), and move to the state
+ * with the id to_state_id
+ */
+template <int from_state_id, char read, char write, char scanner_movement,
+    int to_state_id>
+struct StaticDirection {
+  static constexpr int kFromStateId = from_state_id;
+  static constexpr char kRead = read;
+  static constexpr char kWrite = write;
+  static constexpr bool kMovesLeft = scanner_movement == 'l'
+      || scanner_movement == 'L';
+  static constexpr bool kMovesRight = scanner_movement == 'r'
+      || scanner_movement == 'R';
+  static constexpr int kToStateId = to_state_id;
+};
+
+/**
+ * Struct listing the ids of the halting states of a static turing machine
+ */
+template <int... halting_state_ids>
+struct StaticHaltingStates;
+
+template <>
+struct StaticHaltingStates<> {
+  static constexpr bool Contains(int) {
+    return false;
+  }
+};
+
+template <int first_halting_state_id, int... halting_state_ids>
+struct StaticHaltingStates<first_halting_state_id, halting_state_ids...> {
+  static constexpr bool Contains(int state_id) {
+    return state_id == first_halting_state_id
+        || StaticHaltingStates<halting_state_ids...>::Contains(state_id);
+  }
+};
+
+/**
+ * Class that runs a turing machine whose directions are known at compile time
+ * Every state is its own function with its directions compiled into a chain of
+ * comparisons against constants, and a state that loops back to itself keeps
+ * running in its function, so the current state is held in the program
+ * counter rather than looked up in a table; runs produce the same
+ * configurations as TuringMachine::Run and TuringMachine::RunUntilHalt
+ * NOTE: if 2 directions leave the same state reading the same character, the
+ * first one is used
+ *
+ * Example (a machine that writes 1s to the right until it reads a 0):
+ *   StaticTuringMachine<StaticHaltingStates<2>,
+ *       StaticDirection<1, '1', '1', 'r', 1>,
+ *       StaticDirection<1, '0', '1', 'n', 2>>
+ */
+template <typename HaltingStates, typename... Directions>
+class StaticTuringMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    StaticTuringMachine() = default;
+
+    /**
+     * This method creates a static turing machine
+     *
+     * @param starting_state_id an int representing the id of the state to
+     *     start in
+     * @param tape a vector of characters representing the starting tape
+     * @param blank_character a char representing a blank cell of the tape
+     */
+    StaticTuringMachine(int starting_state_id, const std::vector<char> &tape,
+        char blank_character) {
+      tape_ = Tape(tape, blank_character);
+      current_.function = FindStateFunction<Directions...>::Find(
+          starting_state_id);
+      current_.state_id = starting_state_id;
+      current_.is_halting_state = HaltingStates::Contains(starting_state_id);
+    }
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps) {
+      return RunSteps(max_steps, false);
+    }
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget) {
+      return RunSteps(step_budget, true);
+    }
+
+    std::vector<char> GetTape() const {
+      return tape_.GetCells();
+    }
+
+    size_t GetIndexOfScanner() const {
+      return tape_.GetIndexOfScanner();
+    }
+
+    int GetCurrentStateId() const {
+      return current_.state_id;
+    }
+
+    uint64_t GetNumberOfSteps() const {
+      return num_steps_;
+    }
+
+    bool IsHalted() const {
+      return is_halted_;
+    }
+
+    /**
+     * This method returns the current configuration of the machine formatted
+     * for the console, in the format of
+     * TuringMachine::GetConfigurationForConsole
+     * NOTE: the machine only knows the ids of its states, so the name of the
+     * current state is taken from the given states
+     *
+     * @param states a vector of States with the ids used by the directions
+     * @return the current configuration formatted for the console
+     */
+    std::string GetConfigurationForConsole(const std::vector<State> &states)
+        const {
+      return FormatConfigurationForConsole(tape_, FindCurrentState(states));
+    }
+
+    /**
+     * This method returns the current configuration of the machine formatted
+     * for a markdown file, in the format of
+     * TuringMachine::GetConfigurationForMarkdown
+     *
+     * @param states a vector of States with the ids used by the directions
+     * @return the current configuration formatted for a markdown file
+     */
+    std::string GetConfigurationForMarkdown(const std::vector<State> &states)
+        const {
+      return FormatConfigurationForMarkdown(tape_, FindCurrentState(states));
+    }
+
+  private:
+    struct StateStep;
+
+    /**
+     * This method returns the state of the given states with the id of the
+     * current state
+     *
+     * @param states a vector of States with the ids used by the directions
+     * @return a State representing the current state (empty if none of the
+     *     given states has its id)
+     */
+    State FindCurrentState(const std::vector<State> &states) const {
+      for (const State &kState : states) {
+        if (kState.GetId() == current_.state_id) {
+          return kState;
+        }
+      }
+      return State();
+    }
+
+    /**
+     * Function running a state: it takes steps until the machine moves to
+     * another state (or a halting state) or the step budget runs out, storing
+     * the state moved to in the given StateStep, and returns false if no
+     * direction applies
+     */
+    typedef bool (*StateFunction)(Tape &tape, uint64_t max_steps, uint64_t
+        &num_steps_taken, StateStep &state_step);
+
+    /**
+     * Struct representing the state a static turing machine is in
+     */
+    struct StateStep {
+      /**
+       * StateFunction storing the function of the state (nullptr if no
+       * direction leaves the state)
+       */
+      StateFunction function = nullptr;
+
+      /**
+       * int storing the id of the state
+       */
+      int state_id = 0;
+
+      /**
+       * bool that is true if the state is a halting state
+       */
+      bool is_halting_state = false;
+    };
+
+    /**
+     * Struct that executes the first of the given directions leaving the
+     * state with the id state_id and reading the given character
+     */
+    template <int state_id, typename... RemainingDirections>
+    struct ApplyDirection {
+      static bool Apply(Tape &, char, StateStep &) {
+        return false;
+      }
+    };
+
+    template <int state_id, typename FirstDirection, typename...
+        RemainingDirections>
+    struct ApplyDirection<state_id, FirstDirection, RemainingDirections...> {
+      static bool Apply(Tape &tape, char read, StateStep &state_step) {
+        if (FirstDirection::kFromStateId != state_id
+            || FirstDirection::kRead != read) {
+          return ApplyDirection<state_id, RemainingDirections...>::Apply(tape,
+              read, state_step);
+        }
+        tape.Write(FirstDirection::kWrite);
+        if (FirstDirection::kMovesLeft) {
+          tape.MoveLeft();
+        } else if (FirstDirection::kMovesRight) {
+          tape.MoveRight();
+        }
+        state_step.function = &RunState<FirstDirection::kToStateId>;
+        state_step.state_id = FirstDirection::kToStateId;
+        state_step.is_halting_state = HaltingStates::Contains(
+            FirstDirection::kToStateId);
+        return true;
+      }
+    };
+
+    /**
+     * Struct that finds the function of the state with the given id (nullptr
+     * if no direction leaves it)
+     */
+    template <typename... RemainingDirections>
+    struct FindStateFunction {
+      static StateFunction Find(int) {
+        return nullptr;
+      }
+    };
+
+    template <typename FirstDirection, typename... RemainingDirections>
+    struct FindStateFunction<FirstDirection, RemainingDirections...> {
+      static StateFunction Find(int state_id) {
+        if (FirstDirection::kFromStateId == state_id) {
+          return &RunState<FirstDirection::kFromStateId>;
+        }
+        return FindStateFunction<RemainingDirections...>::Find(state_id);
+      }
+    };
+
+    /**
+     * This method is the StateFunction of the state with the id state_id
+     */
+    template <int state_id>
+    static bool RunState(Tape &tape, uint64_t max_steps, uint64_t
+        &num_steps_taken, StateStep &state_step) {
+      while (num_steps_taken < max_steps) {
+        if (!ApplyDirection<state_id, Directions...>::Apply(tape, tape.Read(),
+            state_step)) {
+          return false;
+        }
+        num_steps_taken += 1;
+        // only return to the run loop once the state changes or the machine
+        // halts
+        if (state_step.state_id != state_id || state_step.is_halting_state) {
+          return true;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state) {
+      uint64_t num_steps_taken = 0;
+      while (num_steps_taken < max_steps) {
+        if (stop_at_halting_state && is_halted_) {
+          break;
+        }
+        if (current_.function == nullptr || !current_.function(tape_,
+            max_steps, num_steps_taken, current_)) {
+          break;
+        }
+        is_halted_ = is_halted_ || current_.is_halting_state;
+      }
+      num_steps_ += num_steps_taken;
+
+      RunResult result;
+      result.num_steps = num_steps_taken;
+      result.is_halted = is_halted_;
+      result.final_state_id = current_.state_id;
+      result.index_of_scanner = tape_.GetIndexOfScanner();
+      return result;
+    }
+
+    /**
+     * Tape storing the tape of the machine
+     */
+    Tape tape_;
+
+    /**
+     * StateStep storing the current state
+     */
+    StateStep current_;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace turingmachinesimulator {
+
+/**
+ * Unsigned integer type storing numbers of steps too large for 64 bits
+ * NOTE: __int128 is a compiler extension, so compilers without it count steps
+ * in 64 bits
+ */
+#if defined(__GNUC__)
+__extension__ typedef unsigned __int128 StepCount;
+#else
+typedef uint64_t StepCount;
+#endif
+
+} // namespace turingmachinesimulator
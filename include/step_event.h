@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Enum representing what a step event describes
+ */
+enum class StepEventType : uint8_t {
+  kWrite, // a cell was written with a different character
+  kMove, // the scanner moved
+  kStateChange, // the machine moved to a different state
+  kHalt // the machine halted
+};
+
+/**
+ * Struct representing 1 change a step made to a turing machine
+ * Steps only produce events for what they change (writing the character that
+ * was read, not moving, or staying in the same state produce no events)
+ */
+struct StepEvent {
+  /**
+   * uint64_t storing the number of the step that made the change (the first
+   * step of the machine is step 1)
+   */
+  uint64_t step = 0;
+
+  /**
+   * int64_t storing the position of the cell written (kWrite) or the new
+   * position of the scanner (kMove), relative to the first cell of the tape
+   * the machine started with
+   */
+  int64_t position = 0;
+
+  /**
+   * uint32_t storing the index (in the transition table) of the new state
+   * (kStateChange and kHalt)
+   */
+  uint32_t state_index = 0;
+
+  /**
+   * char storing the character written (kWrite)
+   */
+  char character = 0;
+
+  /**
+   * StepEventType storing what the event describes
+   */
+  StepEventType type = StepEventType::kWrite;
+};
+
+/**
+ * Function called with batches of step events, in the order of the changes
+ */
+typedef std::function<void(const std::vector<StepEvent> &)> StepEventListener;
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "program.h"
+#include "run_result.h"
+#include "state.h"
+#include "tape.h"
+#include "turing_machine.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a group of states that makes up a subroutine (a gadget
+ * like copy, increment, or compare): it is called by moving into its entry
+ * state and returns by moving into 1 of its exit states (or a halting state)
+ */
+struct Subroutine {
+  /**
+   * State storing the state the subroutine starts in
+   */
+  State entry_state;
+
+  /**
+   * vector storing the states of the subroutine (the entry state is always
+   * 1 of them)
+   */
+  std::vector<State> states;
+
+  /**
+   * vector storing the states outside the subroutine that it returns to
+   */
+  std::vector<State> exit_states;
+
+  /**
+   * size_t storing how many cells on each side of the scanner a call may
+   * read for its effect to be memoized
+   */
+  size_t window_radius = 16;
+};
+
+/**
+ * Class that runs a turing machine whose subroutines have their effects
+ * memoized: the first call of a subroutine on some cells is run on the tape
+ * while the cells it reads are recorded, and its effect (the cells it wrote,
+ * where it left the scanner, the state it returned to, and its number of
+ * steps) is cached keyed by only those cells, so a later call that reads the
+ * same cells is replayed with 1 table lookup per cell read
+ * The effects of each subroutine are kept in a trie of the cells its calls
+ * read (a call is deterministic, so the cells read so far decide which cell
+ * it reads next); the trie is cleared once its table of children holds
+ * kMaxCallTrieEntries entries, which bounds its memory on calls that rarely
+ * repeat
+ * Calls that read a cell past the window radius, get stuck, take too many
+ * steps, or return to a state that is not an exit state are not memoized and
+ * simply run step by step; runs produce the same configurations as
+ * TuringMachine::Run and TuringMachine::RunUntilHalt
+ */
+class SubroutineMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    SubroutineMachine() = default;
+
+    /**
+     * This method creates a subroutine machine that continues from the
+     * current configuration of the given turing machine, sharing its program
+     * NOTE: subroutines whose entry state is not a non-halting state of the
+     * machine are ignored, as is a subroutine with the same entry state as an
+     * earlier 1
+     *
+     * @param turing_machine a TuringMachine to run
+     * @param subroutines a vector of Subroutines of the turing machine
+     */
+    SubroutineMachine(const TuringMachine &turing_machine, const
+        std::vector<Subroutine> &subroutines);
+
+    /**
+     * This method runs the machine for up to the given number of steps, with
+     * the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method runs the machine until it halts, gets stuck, or has taken
+     * the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+    std::vector<char> GetTape() const;
+
+    size_t GetIndexOfScanner() const;
+
+    int64_t GetPositionOfScanner() const;
+
+    State GetCurrentState() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    /**
+     * This method returns the number of subroutine calls that were replayed
+     * from a memoized effect
+     *
+     * @return a uint64_t representing the number of replayed calls
+     */
+    uint64_t GetNumberOfReplayedCalls() const;
+
+    /**
+     * This method returns the number of calls whose effect is memoized, over
+     * every subroutine
+     *
+     * @return a size_t representing the number of memoized effects
+     */
+    size_t GetNumberOfMemoizedEffects() const;
+
+    bool IsHalted() const;
+
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * Struct representing the effect of a call of a subroutine
+     */
+    struct CallEffect {
+      /**
+       * string storing the cells from the leftmost to the rightmost cell the
+       * call read, as the call left them
+       */
+      std::string cells;
+
+      /**
+       * int64_t storing the offset from the scanner of the leftmost cell the
+       * call read
+       */
+      int64_t first_offset = 0;
+
+      /**
+       * int64_t storing the offset of the scanner at the end of the call
+       * from where it started (it may be 1 cell past the cells read)
+       */
+      int64_t scanner_offset = 0;
+
+      /**
+       * uint64_t storing the number of steps the call takes
+       */
+      uint64_t num_steps = 0;
+
+      /**
+       * size_t storing the index (in the transition table) of the state the
+       * call returns to
+       */
+      size_t state_index = 0;
+    };
+
+    /**
+     * Struct representing a node of the trie of the cells calls of a
+     * subroutine read: either the offset of the next cell a call reads, or
+     * the effect of the calls that read the cells on the path to it
+     */
+    struct CallNode {
+      /**
+       * int64_t storing the offset from the scanner of the cell read at this
+       * node
+       */
+      int64_t read_offset = 0;
+
+      /**
+       * size_t storing the index in effects of the effect at this node (the
+       * largest size_t if the node reads a cell instead)
+       */
+      size_t effect_index = static_cast<size_t>(-1);
+    };
+
+    /**
+     * Struct representing a subroutine with its states looked up in the
+     * transition table and its memoized effects
+     */
+    struct CompiledSubroutine {
+      /**
+       * vector storing a 1 for each state index in the subroutine
+       */
+      std::vector<char> is_in_subroutine_by_state_index;
+
+      /**
+       * vector storing a 1 for each state index the subroutine returns to
+       */
+      std::vector<char> is_exit_by_state_index;
+
+      /**
+       * size_t storing the window radius of the subroutine
+       */
+      size_t window_radius = 0;
+
+      /**
+       * vector storing the nodes of the trie of the cells calls read (the
+       * first node, if any, is the root, which reads the scanner's cell)
+       */
+      std::vector<CallNode> nodes;
+
+      /**
+       * vector storing, at the index of a node times the number of columns
+       * of the transition table plus the column of a character, the index of
+       * the node reached by reading the character there (0 if no call has
+       * read it, since the root is never reached by a read)
+       */
+      std::vector<size_t> child_by_read;
+
+      /**
+       * vector storing the memoized effects of the subroutine
+       */
+      std::vector<CallEffect> effects;
+
+      /**
+       * vector storing a 1 for each offset in the window the current call
+       * has read (offset 0 is in the middle)
+       */
+      std::vector<char> is_read_by_offset;
+    };
+
+    /**
+     * This method runs the step loop shared by Run and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method replays the call of the given subroutine at the scanner if
+     * the cells it reads have a memoized effect that fits in the steps left
+     *
+     * @param subroutine a reference to the CompiledSubroutine being called
+     * @param max_steps a uint64_t representing the most steps the call may
+     *     take
+     * @param state_index a reference to the index of the current state, set
+     *     to the state the call returns to
+     * @return a uint64_t representing the number of steps replayed, 0 if the
+     *     call was not replayed
+     */
+    uint64_t ReplayCall(CompiledSubroutine &subroutine, uint64_t max_steps,
+        size_t &state_index);
+
+    /**
+     * This method runs the call of the given subroutine at the scanner 1 step
+     * at a time, recording the cells it reads, and memoizes its effect if it
+     * stays in the window and returns to an exit state; it stops early (with
+     * the machine in a state of the subroutine) once the call cannot be
+     * memoized, so the rest of the call runs in the step loop
+     *
+     * @param subroutine a reference to the CompiledSubroutine being called
+     * @param max_steps a uint64_t representing the most steps the call may
+     *     take
+     * @param state_index a reference to the index of the current state, set
+     *     to the state the machine is in afterwards
+     * @return a uint64_t representing the number of steps taken
+     */
+    uint64_t RunCall(CompiledSubroutine &subroutine, uint64_t max_steps,
+        size_t &state_index);
+
+    /**
+     * This method adds the effect of a call that read the cells in reads_ to
+     * the trie of the given subroutine, clearing the trie first if it is full
+     *
+     * @param subroutine a reference to the CompiledSubroutine that was called
+     * @param effect a CallEffect of the call
+     */
+    void MemoizeCall(CompiledSubroutine &subroutine, const CallEffect &effect);
+
+    /**
+     * shared pointer storing the program of the machine (shared with the
+     * turing machine it was created from)
+     */
+    std::shared_ptr<const Program> program_;
+
+    /**
+     * Tape storing the tape of the machine
+     */
+    Tape tape_;
+
+    /**
+     * vector storing the subroutines of the machine
+     */
+    std::vector<CompiledSubroutine> subroutines_;
+
+    /**
+     * vector storing the index in subroutines_ of the subroutine each state
+     * index is the entry state of (the largest size_t if none)
+     */
+    std::vector<size_t> subroutine_by_state_index_;
+
+    /**
+     * size_t storing the index (in the transition table) of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps the machine has taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * vector storing the offsets and characters of the cells the current call
+     * has read, in the order it read them
+     */
+    std::vector<std::pair<int64_t, char>> reads_;
+
+    /**
+     * uint64_t storing the number of subroutine calls that were replayed
+     * from a memoized effect
+     */
+    uint64_t num_replayed_calls_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * bool that is true if the subroutine machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Dense id of a tape symbol interned in a SymbolTable
+ */
+typedef uint32_t SymbolId;
+
+/**
+ * Dense id of a tape symbol stored in 2 bytes, used by tapes whose alphabet
+ * has at most 65536 symbols
+ */
+typedef uint16_t NarrowSymbolId;
+
+/**
+ * Class representing the alphabet of a machine whose symbols are strings
+ * rather than chars (for example machines generated from multi-track or
+ * compiled programs, which need more than 256 symbols)
+ * Each symbol is given the next dense id when it is first interned, so tapes
+ * and transition tables can store ids and be sized to the alphabet; symbols
+ * are only needed again when printing
+ * NOTE: unlike NameTable, every machine has its own symbol table
+ */
+class SymbolTable {
+  public:
+    /**
+     * Default constructor
+     */
+    SymbolTable() = default;
+
+    /**
+     * This method returns the id of the given symbol, adding it to the table
+     * if needed
+     *
+     * @param symbol a string representing a symbol
+     * @return a SymbolId representing the id of the symbol
+     */
+    SymbolId Intern(const std::string &symbol);
+
+    /**
+     * This method returns the id of the given symbol, or the size of the table
+     * if the symbol is not in the table
+     *
+     * @param symbol a string representing a symbol
+     * @return a SymbolId representing the id of the symbol
+     */
+    SymbolId GetId(const std::string &symbol) const;
+
+    /**
+     * This method returns the symbol with the given id
+     *
+     * @param symbol_id a SymbolId representing the id of a symbol in the table
+     * @return a reference to the string representing the symbol
+     */
+    const std::string &GetSymbol(SymbolId symbol_id) const;
+
+    /**
+     * This method returns the number of symbols in the table
+     *
+     * @return a size_t representing the number of symbols
+     */
+    size_t GetSize() const;
+
+  private:
+    /**
+     * vector storing the symbols by their id
+     */
+    std::vector<std::string> symbols_;
+
+    /**
+     * map storing the id of each symbol
+     */
+    std::map<std::string, SymbolId> id_by_symbol_;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tape_generator.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing a read-only view of the cells of a tape (like a span),
+ * so the tape can be inspected without copying it
+ * NOTE: a view is only valid until the tape it views is next changed
+ */
+template <typename Cell>
+class BasicTapeView {
+  public:
+    /**
+     * Default constructor
+     */
+    BasicTapeView() = default;
+
+    /**
+     * This method creates a view of the given cells
+     *
+     * @param cells a pointer to the leftmost cell of the tape
+     * @param size a size_t representing the number of cells of the tape
+     * @param index_of_scanner a size_t representing the index of the cell the
+     *     scanner is reading
+     */
+    BasicTapeView(const Cell *cells, size_t size, size_t index_of_scanner)
+        : cells_(cells), size_(size), index_of_scanner_(index_of_scanner) {
+    }
+
+    const Cell *begin() const {
+      return cells_;
+    }
+
+    const Cell *end() const {
+      return cells_ + size_;
+    }
+
+    Cell operator[](size_t index) const {
+      return cells_[index];
+    }
+
+    size_t GetSize() const {
+      return size_;
+    }
+
+    size_t GetIndexOfScanner() const {
+      return index_of_scanner_;
+    }
+
+    bool IsEmpty() const {
+      return size_ == 0;
+    }
+
+  private:
+    /**
+     * pointer to the leftmost cell of the tape
+     */
+    const Cell *cells_ = nullptr;
+
+    /**
+     * size_t storing the number of cells of the tape
+     */
+    size_t size_ = 0;
+
+    /**
+     * size_t storing the index of the cell the scanner is reading
+     */
+    size_t index_of_scanner_ = 0;
+};
+
+/**
+ * View of a tape of chars
+ */
+typedef BasicTapeView<char> TapeView;
+
+/**
+ * Class representing the tape of a turing machine
+ * The cells are stored in a buffer with blank headroom on both sides, so the
+ * tape can grow at either end in amortized O(1) time; positions on the tape
+ * are given either as an index (0 is the leftmost cell of the tape) or as a
+ * signed position (0 is the first cell of the tape the machine started with)
+ * With a blank margin set, the blank cells more than that many cells from the
+ * scanner are dropped from the ends of the tape whenever it would grow, so a
+ * machine that drifts away from what it wrote runs in bounded memory; signed
+ * positions are unchanged by dropping cells, indexes are not
+ * NOTE: cells are chars (Tape) or interned symbol ids (see SymbolTable), the
+ * methods are defined in tape.cc for those cell types only
+ */
+template <typename Cell>
+class BasicTape {
+  public:
+    /**
+     * Default constructor
+     */
+    BasicTape() = default;
+
+    /**
+     * This method creates a tape containing the given cells with the scanner
+     * reading the first cell
+     *
+     * @param cells a vector of Cells representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a Cell representing the blank character of the
+     *     tape
+     */
+    BasicTape(const std::vector<Cell> &cells, Cell blank_character);
+
+    /**
+     * This method creates a tape containing the given cells with the scanner
+     * reading the cell at the given index, for continuing a run that another
+     * engine has taken over
+     *
+     * @param cells a vector of Cells representing the cells of the tape, an
+     *     empty vector creates a tape of 1 blank character
+     * @param blank_character a Cell representing the blank character of the
+     *     tape
+     * @param index_of_scanner a size_t representing the index of the cell the
+     *     scanner is reading
+     * @param position_of_scanner an int64_t representing the position of the
+     *     scanner relative to the first cell of the tape the run started with
+     */
+    BasicTape(const std::vector<Cell> &cells, Cell blank_character, size_t
+        index_of_scanner, int64_t position_of_scanner);
+
+    /**
+     * This method creates a tape whose cells are given by the generator with
+     * the scanner reading the first cell; a cell is only generated once the
+     * tape grows to reach it, so the tape (and GetCells) holds the cells
+     * reached so far rather than every cell of the generator
+     *
+     * @param tape_generator a TapeGenerator describing the cells of the tape,
+     *     followed by blank characters
+     * @param blank_character a Cell representing the blank character of the
+     *     tape
+     */
+    BasicTape(const BasicTapeGenerator<Cell> &tape_generator, Cell
+        blank_character);
+
+    /**
+     * This method returns the character the scanner is reading
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @return a Cell representing the character the scanner is reading
+     */
+    Cell Read() const {
+      return cells_[scanner_];
+    }
+
+    /**
+     * This method writes the given character where the scanner is
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param character a Cell representing the character to write
+     */
+    void Write(Cell character) {
+      cells_[scanner_] = character;
+    }
+
+    /**
+     * This method moves the scanner 1 cell left, adding a blank cell to the
+     * start of the tape if the scanner is on the first cell
+     * NOTE: defined in the header since it is called on every step
+     */
+    void MoveLeft() {
+      if (scanner_ == begin_) {
+        if (begin_ == 0) {
+          GrowLeft();
+        }
+        begin_ -= 1;
+      }
+      scanner_ -= 1;
+    }
+
+    /**
+     * This method moves the scanner 1 cell right, adding a blank cell to the
+     * end of the tape if the scanner is on the last cell
+     * NOTE: defined in the header since it is called on every step
+     */
+    void MoveRight() {
+      scanner_ += 1;
+      if (scanner_ == end_) {
+        if (end_ == cells_.size()) {
+          GrowRight();
+        }
+        end_ += 1;
+      }
+    }
+
+    /**
+     * This method moves the scanner right past the cells holding the given
+     * character, stopping at the first cell holding another character, after
+     * the given number of cells, or on the last cell of the tape (whichever
+     * comes first); tapes of chars compare 16 or 32 cells at once with SSE2
+     * or AVX2 when the compiler targets them
+     * NOTE: this is how a run of sweep steps (see Transition::is_sweep) is
+     * taken at once
+     *
+     * @param character a Cell representing the character of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipRight(Cell character, uint64_t max_cells);
+
+    /**
+     * This method moves the scanner left past the cells holding the given
+     * character, with the same meaning as SkipRight (stopping on the first
+     * cell of the tape instead of the last)
+     *
+     * @param character a Cell representing the character of the cells to skip
+     * @param max_cells a uint64_t representing the most cells to skip
+     * @return a uint64_t representing the number of cells skipped
+     */
+    uint64_t SkipLeft(Cell character, uint64_t max_cells);
+
+    /**
+     * This method returns the cells of the tape from left to right
+     *
+     * @return a vector of Cells representing the cells of the tape
+     */
+    std::vector<Cell> GetCells() const;
+
+    /**
+     * This method returns a view of the cells of the tape from left to right
+     * without copying them
+     *
+     * @return a TapeView of the cells of the tape (valid until the tape is
+     *     next changed)
+     */
+    BasicTapeView<Cell> GetView() const;
+
+    /**
+     * This method returns the character in the cell at the given index
+     *
+     * @param index a size_t representing the index of a cell (0 is the
+     *     leftmost cell of the tape)
+     * @return a Cell representing the character in the cell
+     */
+    Cell GetCell(size_t index) const;
+
+    size_t GetSize() const;
+
+    size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the tape the machine started with (negative if the scanner is
+     * to the left of that cell)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    /**
+     * This method returns the position of the leftmost cell of the tape
+     * relative to the first cell of the tape the machine started with, so the
+     * cell at index i is at position GetPositionOfFirstCell() + i
+     *
+     * @return an int64_t representing the signed position of the leftmost cell
+     */
+    int64_t GetPositionOfFirstCell() const;
+
+    Cell GetBlankCharacter() const;
+
+    /**
+     * This method sets how far from the scanner blank cells are kept at the
+     * ends of the tape; blank cells further away are dropped the next time
+     * the tape would grow, and the buffer is reallocated to fit what is left
+     *
+     * @param max_blank_margin a size_t representing the most cells from the
+     *     scanner a blank end of the tape is kept for, 0 keeps every cell
+     *     (the default)
+     */
+    void SetMaxBlankMargin(size_t max_blank_margin);
+
+    size_t GetMaxBlankMargin() const;
+
+    /**
+     * This method returns true if the tape was created from a TapeGenerator
+     *
+     * @return a bool that is true if the tape generates its cells
+     */
+    bool IsGenerated() const;
+
+  private:
+    /**
+     * This method reallocates the buffer with more blank headroom at its start
+     */
+    void GrowLeft();
+
+    /**
+     * This method reallocates the buffer with more blank headroom at its end
+     */
+    void GrowRight();
+
+    /**
+     * This method drops the blank cells beyond the blank margin from both ends
+     * of the tape and reallocates the buffer with blank headroom on both sides
+     * as large as the cells that are left
+     */
+    void TrimBlankMargins();
+
+    /**
+     * This method overwrites the blank cells of the buffer from the given
+     * index to its end with the cells of the generator the tape has not
+     * reached yet
+     *
+     * @param first_index a size_t representing the index in the buffer of the
+     *     first cell to generate
+     */
+    void GenerateCells(size_t first_index);
+
+    /**
+     * vector storing the cells of the tape surrounded by blank headroom
+     */
+    std::vector<Cell> cells_;
+
+    /**
+     * size_t storing the index in the buffer of the leftmost cell of the tape
+     */
+    size_t begin_ = 0;
+
+    /**
+     * size_t storing the index in the buffer after the rightmost cell of the
+     * tape
+     */
+    size_t end_ = 0;
+
+    /**
+     * size_t storing the index in the buffer of the cell the scanner is reading
+     */
+    size_t scanner_ = 0;
+
+    /**
+     * int64_t storing the index in the buffer of the first cell of the tape
+     * the machine started with (outside the buffer once that cell is dropped)
+     */
+    int64_t origin_ = 0;
+
+    /**
+     * size_t storing the most cells from the scanner a blank end of the tape
+     * is kept for, 0 if every cell is kept
+     */
+    size_t max_blank_margin_ = 0;
+
+    /**
+     * shared pointer storing the generator of the cells of the tape, null if
+     * the tape was created from its cells
+     */
+    std::shared_ptr<const BasicTapeGenerator<Cell>> tape_generator_;
+
+    /**
+     * int64_t storing the position after the rightmost cell the tape has ever
+     * reached, the cells from there on are still given by the generator
+     */
+    int64_t position_of_generated_cells_ = 0;
+
+    /**
+     * Cell storing the blank character of the tape
+     */
+    Cell blank_character_ = 0;
+};
+
+/**
+ * Tape of chars
+ */
+typedef BasicTape<char> Tape;
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a pattern of cells repeated a number of times, a piece
+ * of a tape given by a TapeGenerator
+ * NOTE: "1^n 0 1^m" is the patterns {{'1'}, n}, {{'0'}, 1}, and {{'1'}, m}
+ */
+template <typename Cell>
+struct BasicTapePattern {
+  /**
+   * vector storing the cells of the pattern
+   */
+  std::vector<Cell> pattern;
+
+  /**
+   * uint64_t storing the number of times the pattern is repeated
+   */
+  uint64_t num_repetitions;
+};
+
+/**
+ * Pattern of a tape of chars
+ */
+typedef BasicTapePattern<char> TapePattern;
+
+/**
+ * Class representing a starting tape that is described instead of stored,
+ * either as repeated patterns or as a function of the position of each cell
+ * A tape created from a generator only stores the cells the scanner has
+ * reached, so huge but regular tapes cost no memory or time to set up
+ * NOTE: cells are chars or interned symbol ids (see SymbolTable), like Tape
+ */
+template <typename Cell>
+class BasicTapeGenerator {
+  public:
+    /**
+     * This method creates a generator of the tape made of the given patterns
+     * from left to right
+     *
+     * @param patterns a vector of TapePatterns representing the tape
+     */
+    BasicTapeGenerator(const std::vector<BasicTapePattern<Cell>> &patterns);
+
+    /**
+     * This method creates a generator of the tape whose cells are given by a
+     * function of their position
+     *
+     * @param cell_at_position a function returning the Cell at the given
+     *     position (0 is the first cell of the tape)
+     * @param num_cells a uint64_t representing the number of cells of the tape
+     */
+    BasicTapeGenerator(const std::function<Cell(uint64_t)> &cell_at_position,
+        uint64_t num_cells);
+
+    /**
+     * This method writes the cells of the tape starting at the given position
+     * into the given buffer
+     *
+     * @param position a uint64_t representing the position of the first cell
+     * @param num_cells a size_t representing the number of cells to write,
+     *     which must not go past the end of the tape
+     * @param cells a pointer to the buffer to write the cells into
+     */
+    void Generate(uint64_t position, size_t num_cells, Cell *cells) const;
+
+    uint64_t GetNumberOfCells() const;
+
+  private:
+    /**
+     * vector storing the patterns of the tape, leaving out the ones that are
+     * empty or repeated 0 times
+     */
+    std::vector<BasicTapePattern<Cell>> patterns_;
+
+    /**
+     * vector storing the position of the first cell of each repeated pattern
+     */
+    std::vector<uint64_t> position_by_pattern_;
+
+    /**
+     * function returning the cell at a position, empty for tapes made of
+     * patterns
+     */
+    std::function<Cell(uint64_t)> cell_at_position_;
+
+    /**
+     * uint64_t storing the number of cells of the tape
+     */
+    uint64_t num_cells_ = 0;
+};
+
+/**
+ * Generator of tapes of chars
+ */
+typedef BasicTapeGenerator<char> TapeGenerator;
+
+} // namespace turingmachinesimulator
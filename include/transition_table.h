@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "direction.h"
+#include "state.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a compiled direction: everything needed to execute a
+ * direction packed into 8 bytes so that a step of the machine only needs to
+ * load 1 of these
+ */
+struct Transition {
+  /**
+   * uint32_t storing the index (in the transition table) of the state to move
+   * to
+   */
+  uint32_t state_to_move_to = 0;
+
+  /**
+   * char storing the character to write on the tape
+   */
+  char write = 0;
+
+  /**
+   * int8_t storing how far the scanner moves: -1 (left), 0 (no movement), or
+   * 1 (right)
+   */
+  int8_t scanner_offset = 0;
+
+  /**
+   * bool that is true if a direction exists for the state and read character
+   * of this transition, and false otherwise
+   */
+  bool is_defined = false;
+
+  /**
+   * bool that is true if the transition is a sweep: it writes the character
+   * it reads, moves the scanner, and stays in the same (non-halting) state,
+   * so a run of cells holding that character can be skipped at once
+   */
+  bool is_sweep = false;
+};
+
+/**
+ * Struct representing a chain of transitions fused into 1 superinstruction:
+ * the transitions that do not move the scanner are followed into the next
+ * transition (whose read character is the character just written), and
+ * after a move, the states that go to the same state on every character
+ * without changing anything (jump states) are stepped through
+ */
+struct FusedTransition {
+  /**
+   * Transition storing the combined effect of the chain: the last character
+   * written, the only move, and the last state moved to
+   */
+  Transition transition;
+
+  /**
+   * uint32_t storing the number of steps the chain takes
+   */
+  uint32_t num_steps = 0;
+
+  /**
+   * uint32_t storing the number of steps the chain takes before the jump
+   * states, the only steps taken if the scanner moves onto a character that
+   * no direction reads (which stops the machine in the first jump state)
+   */
+  uint32_t num_steps_before_jumps = 0;
+
+  /**
+   * uint32_t storing the index of the first jump state stepped through
+   */
+  uint32_t first_jump_state = 0;
+};
+
+/**
+ * Class representing the directions of a turing machine compiled into a flat
+ * table indexed by (state index, character read)
+ * States are given dense indices (0 to number of states - 1) and characters
+ * that are read by some direction are given dense columns; column 0 is
+ * reserved for characters that no direction reads
+ */
+class TransitionTable {
+  public:
+    /**
+     * Default constructor
+     */
+    TransitionTable() = default;
+
+    /**
+     * This method compiles the given states and directions into a transition
+     * table
+     * NOTE: the directions are expected to be valid (no 2 directions from the
+     * same state with the same read condition), the turing machine validates
+     * this before creating its table
+     *
+     * @param states a vector of States representing the states of the turing
+     *     machine
+     * @param directions a vector of Directions representing the directions of
+     *     the turing machine
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    TransitionTable(const std::vector<State> &states, const
+        std::vector<Direction> &directions, const std::vector<std::string>
+        &halting_state_names);
+
+    /**
+     * This method returns the transition for the given state index and read
+     * character (the returned transition is not defined if there is no
+     * direction for the state and character)
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param state_index a size_t representing the index of a state in the
+     *     table
+     * @param read a char representing the character being read
+     * @return a reference to the Transition for the state and character
+     */
+    const Transition &GetTransition(size_t state_index, char read) const {
+      return transitions_[state_index * num_columns_
+          + column_by_character_[static_cast<unsigned char>(read)]];
+    }
+
+    /**
+     * This method returns the fused transition starting with the transition
+     * for the given state index and read character (see FusedTransition)
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param state_index a size_t representing the index of a state in the
+     *     table
+     * @param read a char representing the character being read
+     * @return a reference to the FusedTransition for the state and character
+     */
+    const FusedTransition &GetFusedTransition(size_t state_index, char read)
+        const {
+      return fused_transitions_[state_index * num_columns_
+          + column_by_character_[static_cast<unsigned char>(read)]];
+    }
+
+    /**
+     * This method returns true if at least 1 direction reads the given
+     * character
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param character a char to look up
+     * @return a bool that is true if the character has a column
+     */
+    bool IsReadCharacter(char character) const {
+      return column_by_character_[static_cast<unsigned char>(character)] != 0;
+    }
+
+    /**
+     * This method returns the column of the given character, so the
+     * transition for a state index and character is entry
+     * state_index * GetNumberOfColumns() + GetColumn(character) of the table
+     *
+     * @param character a char to look up
+     * @return a size_t representing the column of the character (0 if no
+     *     direction reads it)
+     */
+    size_t GetColumn(char character) const {
+      return column_by_character_[static_cast<unsigned char>(character)];
+    }
+
+    size_t GetNumberOfColumns() const;
+
+    /**
+     * This method returns true if the state at the given index is a halting
+     * state
+     * NOTE: defined in the header since it is called on every step
+     *
+     * @param state_index a size_t representing the index of a state in the
+     *     table
+     * @return a bool that is true if the state is a halting state
+     */
+    bool IsHaltingState(size_t state_index) const {
+      return is_halting_by_state_index_[state_index] != 0;
+    }
+
+    /**
+     * This method returns the index of the given state in the table, or the
+     * number of states in the table if the state is not in the table
+     *
+     * @param state a State to find in the table
+     * @return a size_t representing the index of the state
+     */
+    size_t GetStateIndex(const State &state) const;
+
+    const State &GetState(size_t state_index) const;
+
+    size_t GetNumberOfStates() const;
+
+    /**
+     * This method returns the characters that are read by at least 1 direction
+     * in the order of their columns (column 1 onward)
+     *
+     * @return a vector of chars representing the characters read by directions
+     */
+    const std::vector<char> &GetReadCharacters() const;
+
+    /**
+     * This method returns true if there are no states in the table
+     *
+     * @return a bool that is true if the table is empty
+     */
+    bool IsEmpty() const;
+
+    /**
+     * This method gives the states of the table new indices, moving their rows
+     * so that the state at index state_order[i] is at index i; the states
+     * that are run one after another can then be put next to each other
+     * NOTE: the table is left unchanged if the order is not a permutation of
+     * the state indices
+     *
+     * @param state_order a vector of size_ts representing the current index of
+     *     the state to put at each new index
+     */
+    void ReorderStates(const std::vector<size_t> &state_order);
+
+  private:
+    /**
+     * This method adds the given state to the table if a state with the same
+     * id is not in the table yet
+     *
+     * @param state a State to add to the table
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    void AddState(const State &state, const std::vector<std::string>
+        &halting_state_names);
+
+    /**
+     * This method fills in the fused transitions from the transitions
+     */
+    void FuseTransitions();
+
+    /**
+     * This method returns true if the state at the given index is a jump
+     * state: a non-halting state that on every read character writes it back,
+     * does not move, and goes to the same other state
+     *
+     * @param state_index a size_t representing the index of a state in the
+     *     table
+     * @return a bool that is true if the state is a jump state
+     */
+    bool IsJumpState(size_t state_index) const;
+
+    /**
+     * vector storing the states of the table by their index
+     */
+    std::vector<State> states_;
+
+    /**
+     * map storing the ids of the states as keys and their indices in the table
+     * as values (only used while building the table and for lookups by State)
+     */
+    std::map<int, size_t> state_index_by_id_;
+
+    /**
+     * vector storing a 1 for each state index that is a halting state and a 0
+     * otherwise
+     */
+    std::vector<char> is_halting_by_state_index_;
+
+    /**
+     * vector storing the characters that are read by directions, the character
+     * at index i has column i + 1
+     */
+    std::vector<char> read_characters_;
+
+    /**
+     * array storing the column of each possible character (0 for characters
+     * that are not read by any direction)
+     */
+    uint16_t column_by_character_[256] = {};
+
+    /**
+     * size_t storing the number of columns in each row of the table
+     */
+    size_t num_columns_ = 1;
+
+    /**
+     * vector storing the transitions of the table row by row (1 row per state)
+     */
+    std::vector<Transition> transitions_;
+
+    /**
+     * vector storing the fused transitions of the table, in the same order as
+     * the transitions
+     */
+    std::vector<FusedTransition> fused_transitions_;
+};
+
+} // namespace turingmachinesimulator
@@ -2,14 +2,28 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 
 #include "direction.h"
+#include "execution_context.h"
+#include "program.h"
+#include "run_mode.h"
+#include "run_result.h"
 #include "state.h"
+#include "step_count.h"
+#include "step_event.h"
+#include "transition_table.h"
 
 namespace turingmachinesimulator {
 
+class ProvenRuleMachine;
+
 /**
  * This class represents a turing machine
+ * NOTE: a turing machine is a Program (its rules) together with 1
+ * ExecutionContext (its tape, scanner, and current state); to run the same
+ * rules on many tapes, create the Program once and give each tape its own
+ * ExecutionContext
  */
 class TuringMachine {
   public:
@@ -35,19 +49,165 @@ class TuringMachine {
     TuringMachine(const std::vector<State> &states, const std::vector<Direction>
         &directions, const std::vector<char> &tape, char blank_character, const 
         std::vector<std::string> &halting_state_names);
+
+    /**
+     * This method creates a turing machine that runs the given program on the
+     * given tape
+     *
+     * @param program a shared pointer to the Program to run
+     * @param tape a vector of chars representing the tape of the turing machine
+     * @param blank_character a char representing the blank character for the
+     *     turing machine
+     */
+    TuringMachine(const std::shared_ptr<const Program> &program, const
+        std::vector<char> &tape, char blank_character);
+
+    /**
+     * This method creates a turing machine containing the given states and
+     * following the given directions on a tape given by the generator, whose
+     * cells are only generated once the scanner reaches them (so GetTape only
+     * holds the cells reached so far)
+     *
+     * @param states a vector of States representing the states of the turing
+     *     machine
+     * @param directions a vector of Directions representing the directions for
+     *     the turing machine
+     * @param tape_generator a TapeGenerator describing the starting tape
+     * @param blank_character a char representing the blank character for the
+     *     turing machine
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    TuringMachine(const std::vector<State> &states, const std::vector<Direction>
+        &directions, const TapeGenerator &tape_generator, char blank_character,
+        const std::vector<std::string> &halting_state_names);
+
+    /**
+     * This method creates a turing machine that runs the given program on the
+     * tape given by the generator
+     *
+     * @param program a shared pointer to the Program to run
+     * @param tape_generator a TapeGenerator describing the starting tape
+     * @param blank_character a char representing the blank character for the
+     *     turing machine
+     */
+    TuringMachine(const std::shared_ptr<const Program> &program, const
+        TapeGenerator &tape_generator, char blank_character);
     
     State GetCurrentState() const;
+
+    /**
+     * This method returns the id of the current state without copying the
+     * state
+     *
+     * @return an int representing the id of the current state (-1 if the
+     *     turing machine is empty)
+     */
+    int GetCurrentStateId() const;
     
     std::vector<State> GetHaltingStates() const;
 
+    /**
+     * This method returns the halting states without copying them
+     *
+     * @return a reference to the halting states (valid as long as the program
+     *     of the turing machine)
+     */
+    const std::vector<State> &GetHaltingStatesView() const;
+
     std::map<State, std::vector<Direction>> GetDirectionsByStateMap() const;
+
+    /**
+     * This method returns the directions by state map without copying it
+     *
+     * @return a reference to the directions by state map (valid as long as the
+     *     program of the turing machine)
+     */
+    const std::map<State, std::vector<Direction>> &GetDirectionsByStateMapView()
+        const;
     
     std::vector<char> GetTape() const;
 
+    /**
+     * This method returns a view of the tape without copying it, for drawing
+     * or logging a running machine
+     *
+     * @return a TapeView of the tape (valid until the turing machine next
+     *     takes a step)
+     */
+    TapeView GetTapeView() const;
+
     size_t GetIndexOfScanner() const;
+
+    /**
+     * This method returns the position of the scanner relative to the first
+     * cell of the starting tape (the positions used by step events)
+     *
+     * @return an int64_t representing the signed position of the scanner
+     */
+    int64_t GetPositionOfScanner() const;
+
+    /**
+     * This method subscribes the given listener to batches of the changes
+     * (writes, scanner moves, state changes, and halts) made by the steps of
+     * the turing machine, so the machine can be followed without copying it
+     * after every step; the batches are delivered by the time Update, Run, or
+     * RunUntilHalt returns
+     * NOTE: a turing machine without listeners does not record any changes
+     *
+     * @param listener a StepEventListener to call with batches of events
+     * @return a size_t representing the id of the subscription
+     */
+    size_t Subscribe(const StepEventListener &listener);
+
+    /**
+     * This method removes the subscription with the given id
+     *
+     * @param subscription_id a size_t representing the id of a subscription
+     */
+    void Unsubscribe(size_t subscription_id);
+
+    /**
+     * This method returns the number of steps the turing machine has taken
+     * since it was created
+     * NOTE: runs with proven rules can take more steps than a uint64_t holds,
+     * in which case this returns the largest uint64_t; GetExactNumberOfSteps
+     * returns the full count
+     *
+     * @return a uint64_t representing the number of steps taken
+     */
+    uint64_t GetNumberOfSteps() const;
+
+    /**
+     * This method returns the number of steps the turing machine has taken
+     * since it was created, counted in 128 bits while it runs with proven
+     * rules
+     *
+     * @return a StepCount representing the number of steps taken
+     */
+    StepCount GetExactNumberOfSteps() const;
     
     std::string GetErrorMessage() const;
 
+    char GetBlankCharacter() const;
+
+    /**
+     * This method returns the compiled transition table of the turing machine
+     * so that other engines can run the machine without recompiling it
+     *
+     * @return a reference to the TransitionTable of the turing machine
+     */
+    const TransitionTable &GetTransitionTable() const;
+
+    /**
+     * This method returns the program of the turing machine, which can be
+     * shared with other turing machines and execution contexts
+     *
+     * @return a shared pointer to the Program of the turing machine (null for
+     *     a turing machine made with the default constructor)
+     */
+    const std::shared_ptr<const Program> &GetProgram() const;
+
     bool IsHalted() const;
     
     /**
@@ -86,66 +246,136 @@ class TuringMachine {
     * directions for the current state of the turing machine
     */
     void Update();
-    
-  private:
+
     /**
-     * This method executes the given direction
+     * This method sets how Run and RunUntilHalt take their steps; with
+     * RunMode::kProvenRules, machines that count in unary (busy beavers and
+     * the like) can take 10^12 steps or more at once
+     * NOTE: the ProvenRuleMachine (and the rules it proved) is kept from 1 run
+     * to the next, and the configuration is only copied back from it when it
+     * is next read, so many short runs cost no more than 1 long run; taking
+     * steps any other way starts a new ProvenRuleMachine on the next run
+     * NOTE: step events are only recorded step by step, so a turing machine
+     * with listeners always runs in RunMode::kStepByStep, as does a turing
+     * machine on a generated tape (whose unreached cells other engines cannot
+     * take over)
+     *
+     * @param run_mode a RunMode representing how to take steps
      */
-     void ExecuteDirection(const Direction &direction);
-     
+    void SetRunMode(RunMode run_mode);
+
+    RunMode GetRunMode() const;
+
     /**
-     * State storing the current state of the turing machine
+     * This method sets how far from the scanner blank cells are kept at the
+     * ends of the tape; machines that drift away from what they wrote (like
+     * translated cyclers) then run in bounded memory, at the cost of GetTape
+     * no longer holding every cell visited
+     * NOTE: positions of the scanner and of step events are unchanged, but the
+     * index of the scanner moves when cells are dropped from the left
+     *
+     * @param max_blank_margin a size_t representing the most cells from the
+     *     scanner a blank end of the tape is kept for, 0 keeps every cell
+     *     (the default)
      */
-    State current_state_ = State();
-    
+    void SetMaxBlankMargin(size_t max_blank_margin);
+
     /**
-     * vector of states storing the halting states of the turing machine
+     * This method runs a warm-up of the given number of steps on a copy of the
+     * turing machine, counting the transitions it takes, then renumbers the
+     * states so that hot states and the states that usually follow them have
+     * neighbouring rows in the transition table (which helps machines with
+     * thousands of states); the turing machine behaves the same afterward
+     * NOTE: the program is no longer shared with other turing machines, and
+     * the indices of states in the transition table change
+     *
+     * @param num_warm_up_steps a uint64_t representing the most steps of the
+     *     warm-up
+     * @return a StateLayoutReport of the spread of the table accesses of the
+     *     warm-up before and after renumbering
      */
-    std::vector<State> halting_states_;
+    StateLayoutReport OptimizeStateLayout(uint64_t num_warm_up_steps);
 
     /**
-     * map storing states of the turing machine as the keys and vectors of 
-     * directions that move from the key state as the values
+     * This method updates the Turing Machine by up to the given number of steps
+     * (the same as calling Update that many times) without copying the tape 
+     * or the current state between steps; the run stops early if there is no
+     * direction for the current state and the character being read
+     * NOTE: like Update, this keeps following directions out of halting states
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final 
+     *     configuration of the machine
      */
-    std::map<State, std::vector<Direction>> directions_by_state_map_;
-    
+    RunResult Run(uint64_t max_steps);
+
     /**
-     * vector of chars storing the tape of the turing machine
+     * This method updates the Turing Machine until it halts, gets stuck (there
+     * is no direction for the current state and the character being read), or
+     * has taken the given number of steps
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
      */
-    std::vector<char> tape_;
+    RunResult RunUntilHalt(uint64_t step_budget);
     
+  private:
     /**
-     * char storing the turing machine's blank character
+     * This method runs the turing machine on its ProvenRuleMachine, creating
+     * it from the current configuration if there is none (or copying it if
+     * it is shared with a copy of the turing machine)
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a RunResult describing the run
      */
-     char blank_character_;
+    RunResult RunWithProvenRules(uint64_t max_steps, bool
+        stop_at_halting_state);
 
     /**
-     * size_ storing the index of the tape that the scanner is reading
+     * This method copies the configuration of the ProvenRuleMachine into the
+     * execution context if it has run since it was last copied
      */
-    size_t index_of_scanner_ = 0;
+    void SyncWithProvenRuleMachine() const;
 
     /**
-     * a vector of strings storing the the names of halting states
+     * This method copies the configuration of the ProvenRuleMachine into the
+     * execution context and then drops the ProvenRuleMachine, before the
+     * configuration is changed any other way
      */
-    std::vector<std::string> halting_state_names_;
+    void DropProvenRuleMachine();
 
     /**
-     * string storing the error message of the turing machine
+     * shared pointer storing the program of the turing machine
      */
-    std::string error_message_ = "";
+    std::shared_ptr<const Program> program_;
 
     /**
-     * bool storing whether or not the machine is halted (true if halted, false
-     * otherwise)
+     * ExecutionContext storing the tape, scanner, current state, and number of
+     * steps of the turing machine (mutable since it is brought up to date
+     * with the ProvenRuleMachine when it is read)
      */
-    bool is_halted_ = false;
-    
+    mutable ExecutionContext execution_context_;
+
+    /**
+     * shared pointer storing the ProvenRuleMachine of RunMode::kProvenRules
+     * (null until the first run in that mode, shared by copies of the turing
+     * machine until 1 of them runs)
+     */
+    std::shared_ptr<ProvenRuleMachine> proven_rule_machine_;
+
+    /**
+     * bool that is true if the ProvenRuleMachine has run since its
+     * configuration was last copied into the execution context
+     */
+    mutable bool is_execution_context_behind_ = false;
+
     /**
-     * bool that is true if the turing machine object is not successfully 
-     * initialized or if the turing machine object was initialized with the
-     * default constructor, and false otherwise
+     * RunMode storing how Run and RunUntilHalt take their steps
      */
-    bool is_empty_ = true;
+    RunMode run_mode_ = RunMode::kStepByStep;
 };
 
 } // namespace turingmachinesimulator
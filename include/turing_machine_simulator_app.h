@@ -9,6 +9,7 @@
 #include "cinder/gl/gl.h"
 #include "direction.h"
 #include "state.h"
+#include "tape.h"
 #include "turing_machine.h"
 #include "turing_machine_simulator_helper.h"
 
@@ -132,6 +133,14 @@ class TuringMachineSimulatorApp : public ci::app::App {
      */
     void StartSimulation();
     
+    /**
+     * This method updates the simulated tape and scanner shown in the app with
+     * the changes made by steps of the turing machine
+     *
+     * @param events a vector of StepEvents describing the changes
+     */
+    void ApplyStepEvents(const std::vector<StepEvent> &events);
+
     /**
      * This method stops the simulation
      */
@@ -277,6 +286,14 @@ class TuringMachineSimulatorApp : public ci::app::App {
      */
     size_t index_of_character_being_read_ = 0;
 
+    /**
+     * Tape storing the tape (and scanner) during a simulation, which follows
+     * the step events of the turing machine and grows in either direction
+     * without shifting its cells (copied back to tape_ once the simulation
+     * stops)
+     */
+    Tape simulated_tape_;
+
     /**
      * Vector of strings storing:
      * the read input at index 0, 
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+
+#include "direction.h"
+#include "state.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Class representing a Direction for a WideTuringMachine, whose read and
+ * write symbols are strings rather than chars
+ */
+class WideDirection {
+  public:
+    /**
+     * Default constructor
+     */
+    WideDirection() = default;
+
+    /**
+     * This method creates a WideDirection Object from read and write symbols
+     * and a scanner movement char as well as a state to move from and a state
+     * to move to
+     *
+     * @param read a string representing the symbol to be read in order for
+     *     the direction to apply (must not be empty)
+     * @param write a string representing the symbol for the scanner to write
+     *     (must not be empty)
+     * @param move a char representing the direction for the scanner to move in;
+     *     should be l (left), r (right), or n (no movement)
+     * @param state_to_move_from a State representing the state to move from
+     * @param state_to_move_to a State representing the state to move to
+     */
+    WideDirection(const std::string &read, const std::string &write, char
+        move, const State &state_to_move_from, const State &state_to_move_to);
+
+    /**
+     * This method creates a WideDirection Object with the same meaning as the
+     * given Direction (its read and write characters become 1 char symbols)
+     *
+     * @param direction a Direction to widen
+     */
+    explicit WideDirection(const Direction &direction);
+
+    /**
+     * This method returns true if the WideDirection Object is empty
+     * (encountered initialization error or was created with default
+     * constructor)
+     *
+     * @return a bool that is true if the WideDirection is empty
+     */
+    bool IsEmpty() const;
+
+    const std::string &GetRead() const;
+
+    const std::string &GetWrite() const;
+
+    char GetScannerMovement() const;
+
+    State GetStateToMoveFrom() const;
+
+    State GetStateToMoveTo() const;
+
+  private:
+    /**
+     * string representing the symbol that must be read for this direction to
+     * apply
+     */
+    std::string read_;
+
+    /**
+     * string representing the symbol to write on the tape given that the read
+     * condition is met
+     */
+    std::string write_;
+
+    /**
+     * Character representing how the scanner should move:
+     * l for left
+     * r for right
+     * n for no movement
+     */
+    char scanner_movement_ = 'n';
+
+    /**
+     * State representing the state the machine must be in in order for the
+     * direction to apply
+     */
+    State state_to_move_from_;
+
+    /**
+     * State representing the state to move to after the direction is executed
+     */
+    State state_to_move_to_;
+
+    /**
+     * bool that is true if the direction object is empty (encountered
+     * initialization error or was created with default constructor)
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "run_result.h"
+#include "state.h"
+#include "symbol_table.h"
+#include "tape.h"
+#include "wide_direction.h"
+
+namespace turingmachinesimulator {
+
+/**
+ * Struct representing a compiled wide direction, like Transition but writing
+ * an interned symbol id instead of a char
+ */
+struct WideTransition {
+  /**
+   * uint32_t storing the index of the state to move to
+   */
+  uint32_t state_to_move_to = 0;
+
+  /**
+   * SymbolId storing the id of the symbol to write on the tape
+   */
+  SymbolId write = 0;
+
+  /**
+   * int8_t storing how far the scanner moves: -1 (left), 0 (no movement), or
+   * 1 (right)
+   */
+  int8_t scanner_offset = 0;
+
+  /**
+   * bool that is true if a direction exists for the state and read symbol of
+   * this transition, and false otherwise
+   */
+  bool is_defined = false;
+};
+
+/**
+ * Class representing a turing machine whose tape symbols are strings, so it
+ * is not limited to the 256 chars of TuringMachine
+ * Every symbol (the blank symbol, the symbols of the directions, and the
+ * symbols of the starting tape) is interned to a dense SymbolId when the
+ * machine is created; the tape stores ids and the transition table has 1
+ * column per symbol of the alphabet, so steps never touch a string and
+ * symbols are only looked up again when the machine is printed
+ * NOTE: the cells of the tape are sized to the alphabet, they are
+ * NarrowSymbolIds while the alphabet has at most 65536 symbols and SymbolIds
+ * otherwise
+ */
+class WideTuringMachine {
+  public:
+    /**
+     * Default constructor
+     */
+    WideTuringMachine() = default;
+
+    /**
+     * This method creates a wide turing machine containing the given states
+     * and tape and following the given directions
+     *
+     * @param states a vector of States representing the states of the turing
+     *     machine
+     * @param directions a vector of WideDirections representing the directions
+     *     for the turing machine
+     * @param tape a vector of strings representing the symbols of the tape of
+     *     the turing machine
+     * @param blank_symbol a string representing the blank symbol for the
+     *     turing machine
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    WideTuringMachine(const std::vector<State> &states, const
+        std::vector<WideDirection> &directions, const std::vector<std::string>
+        &tape, const std::string &blank_symbol, const std::vector<std::string>
+        &halting_state_names);
+
+    State GetCurrentState() const;
+
+    /**
+     * This method returns the symbols of the tape from left to right
+     *
+     * @return a vector of strings representing the symbols of the tape
+     */
+    std::vector<std::string> GetTape() const;
+
+    /**
+     * This method returns a view of the ids of the symbols of the tape without
+     * copying them, if the cells of the tape are SymbolIds
+     *
+     * @return a BasicTapeView of SymbolIds (valid until the machine next takes
+     *     a step, empty if the tape is narrow)
+     */
+    BasicTapeView<SymbolId> GetTapeView() const;
+
+    /**
+     * This method returns a view of the ids of the symbols of the tape without
+     * copying them, if the cells of the tape are NarrowSymbolIds
+     *
+     * @return a BasicTapeView of NarrowSymbolIds (valid until the machine next
+     *     takes a step, empty if the tape is not narrow)
+     */
+    BasicTapeView<NarrowSymbolId> GetNarrowTapeView() const;
+
+    /**
+     * This method returns true if the cells of the tape are NarrowSymbolIds
+     * (the alphabet has at most 65536 symbols), so the tape is read with
+     * GetNarrowTapeView rather than GetTapeView
+     *
+     * @return a bool that is true if the tape is narrow
+     */
+    bool IsTapeNarrow() const;
+
+    /**
+     * This method returns the symbol table of the machine, which maps the ids
+     * on the tape back to their symbols
+     *
+     * @return a reference to the SymbolTable of the machine
+     */
+    const SymbolTable &GetSymbolTable() const;
+
+    size_t GetIndexOfScanner() const;
+
+    uint64_t GetNumberOfSteps() const;
+
+    std::string GetErrorMessage() const;
+
+    std::string GetBlankSymbol() const;
+
+    bool IsHalted() const;
+
+    /**
+     * This method returns true if the wide turing machine is empty
+     * (encountered initialization error or was created with the default
+     * constructor)
+     *
+     * @return a bool that is true if the wide turing machine is empty
+     */
+    bool IsEmpty() const;
+
+    /**
+     * This method returns the current configuration of the machine formatted
+     * for the console, in the format of
+     * TuringMachine::GetConfigurationForConsole
+     *
+     * @return the current configuration formatted for the console
+     */
+    std::string GetConfigurationForConsole() const;
+
+    /**
+     * This method returns the current configuration of the machine formatted
+     * for a markdown file, in the format of
+     * TuringMachine::GetConfigurationForMarkdown
+     *
+     * @return the current configuration formatted for a markdown file
+     */
+    std::string GetConfigurationForMarkdown() const;
+
+    /**
+     * This method updates the machine by 1 step by following the directions
+     * for the current state
+     */
+    void Update();
+
+    /**
+     * This method updates the machine by up to the given number of steps,
+     * with the same meaning as TuringMachine::Run
+     *
+     * @param max_steps a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult Run(uint64_t max_steps);
+
+    /**
+     * This method updates the machine until it halts, gets stuck, or has
+     * taken the given number of steps, with the same meaning as
+     * TuringMachine::RunUntilHalt
+     *
+     * @param step_budget a uint64_t representing the most steps to take
+     * @return a RunResult describing the steps taken and the final
+     *     configuration of the machine
+     */
+    RunResult RunUntilHalt(uint64_t step_budget);
+
+  private:
+    /**
+     * This method gives the given state the next index if a state with the
+     * same id does not have an index yet
+     *
+     * @param state a State to add to the machine
+     * @param halting_state_names a vector of strings representing the possible
+     *     names for halting states
+     */
+    void AddState(const State &state, const std::vector<std::string>
+        &halting_state_names);
+
+    /**
+     * This method returns the index of the given state
+     *
+     * @param state a State of the machine
+     * @return a size_t representing the index of the state
+     */
+    size_t GetStateIndex(const State &state) const;
+
+    /**
+     * This method runs the step loop shared by Update, Run, and RunUntilHalt
+     */
+    RunResult RunSteps(uint64_t max_steps, bool stop_at_halting_state);
+
+    /**
+     * This method runs the step loop of RunSteps on the given tape, which is
+     * the tape of the machine with cells of the given width
+     *
+     * @param tape the BasicTape of the machine
+     * @param max_steps a uint64_t representing the most steps to take
+     * @param stop_at_halting_state a bool that is true if the run should stop
+     *     once the machine is halted
+     * @return a RunResult describing the run
+     */
+    template <typename Cell>
+    RunResult RunStepsOnTape(BasicTape<Cell> &tape, uint64_t max_steps, bool
+        stop_at_halting_state);
+
+    /**
+     * SymbolTable storing the symbols of the alphabet of the machine, the
+     * blank symbol is always id 0
+     */
+    SymbolTable symbol_table_;
+
+    /**
+     * vector storing the states of the machine by their index
+     */
+    std::vector<State> states_;
+
+    /**
+     * map storing the index of each state by its id
+     */
+    std::map<int, size_t> state_index_by_id_;
+
+    /**
+     * vector storing 1 for each halting state and 0 for the others, by index
+     */
+    std::vector<uint8_t> is_halting_by_state_index_;
+
+    /**
+     * vector storing the transitions indexed by (state index * size of the
+     * alphabet + id of the symbol read)
+     */
+    std::vector<WideTransition> transitions_;
+
+    /**
+     * size_t storing the number of symbols in the alphabet
+     */
+    size_t alphabet_size_ = 0;
+
+    /**
+     * BasicTape storing the ids of the symbols of the tape if the alphabet has
+     * at most 65536 symbols
+     */
+    BasicTape<NarrowSymbolId> narrow_tape_;
+
+    /**
+     * BasicTape storing the ids of the symbols of the tape if the alphabet has
+     * more than 65536 symbols
+     */
+    BasicTape<SymbolId> tape_;
+
+    /**
+     * bool that is true if the tape of the machine is narrow_tape_ rather than
+     * tape_
+     */
+    bool is_tape_narrow_ = false;
+
+    /**
+     * size_t storing the index of the current state
+     */
+    size_t current_state_index_ = 0;
+
+    /**
+     * uint64_t storing the number of steps taken
+     */
+    uint64_t num_steps_ = 0;
+
+    /**
+     * bool storing whether or not the machine is halted
+     */
+    bool is_halted_ = false;
+
+    /**
+     * string storing the error message (if there is one)
+     */
+    std::string error_message_;
+
+    /**
+     * bool that is true if the wide turing machine is empty
+     */
+    bool is_empty_ = true;
+};
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,375 @@
+#include "block_macro_machine.h"
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * size_t storing the most steps simulated for 1 block before control returns
+ * to the run loop; this bounds the work spent on a machine that loops forever
+ * inside a block
+ */
+const size_t kMaxStepsPerBlockSimulation = 1 << 16;
+
+/**
+ * size_t storing the most block transitions kept in the cache before it is
+ * cleared
+ */
+const size_t kMaxCachedBlockTransitions = 1 << 20;
+
+/**
+ * size_t storing the number of slots the cache starts with
+ */
+const size_t kMinCacheSlots = 1 << 10;
+
+/**
+ * This function returns the slot of the cache that probing for the given
+ * entry and block contents starts at
+ *
+ * @param entry a uint64_t representing the entry of the block
+ * @param contents a uint64_t representing the packed block
+ * @param num_slots a size_t representing the number of slots (a power of 2)
+ * @return a size_t representing the index of the slot
+ */
+size_t GetFirstSlot(uint64_t entry, uint64_t contents, size_t num_slots) {
+  uint64_t hash = contents ^ (entry * 0x9E3779B97F4A7C15ULL);
+  hash ^= hash >> 29;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 32;
+  return static_cast<size_t>(hash) & (num_slots - 1);
+}
+
+} // namespace
+
+BlockMacroMachine::BlockMacroMachine(const TuringMachine &turing_machine,
+    size_t block_size) {
+  if (turing_machine.IsEmpty() || block_size == 0) {
+    // do not create a non-empty block macro machine if there is nothing to
+    // run or the blocks would have no cells
+    return;
+  }
+  transition_table_ = turing_machine.GetTransitionTable();
+  const std::vector<char> kCells = turing_machine.GetTape();
+
+  // the blank character is code 0, so blank blocks are 0; the codes cover
+  // every character on the tape or written by a direction
+  std::vector<char> characters(1, turing_machine.GetBlankCharacter());
+  characters.insert(characters.end(), kCells.begin(), kCells.end());
+  const std::vector<char> &kReadCharacters =
+      transition_table_.GetReadCharacters();
+  characters.insert(characters.end(), kReadCharacters.begin(),
+      kReadCharacters.end());
+  for (size_t state_index = 0; state_index
+      < transition_table_.GetNumberOfStates(); state_index++) {
+    for (char read : kReadCharacters) {
+      const Transition &kTransition = transition_table_.GetTransition(
+          state_index, read);
+      if (kTransition.is_defined) {
+        characters.push_back(kTransition.write);
+      }
+    }
+  }
+  bool is_coded[256] = {};
+  for (char character : characters) {
+    const unsigned char kIndex = static_cast<unsigned char>(character);
+    if (!is_coded[kIndex]) {
+      is_coded[kIndex] = true;
+      code_by_character_[kIndex] = static_cast<uint8_t>(
+          character_by_code_.size());
+      character_by_code_.push_back(character);
+    }
+  }
+  bits_per_cell_ = 1;
+  while ((static_cast<size_t>(1) << bits_per_cell_)
+      < character_by_code_.size()) {
+    bits_per_cell_ += 1;
+  }
+  if (block_size * bits_per_cell_ > 64) {
+    // a block has to fit in 1 uint64_t
+    character_by_code_.clear();
+    return;
+  }
+
+  block_size_ = block_size;
+  current_state_index_ = transition_table_.GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+
+  // pad the tape with blanks to a whole number of blocks
+  blocks_.assign((kCells.size() + block_size_ - 1) / block_size_, 0);
+  for (size_t cell = 0; cell < kCells.size(); cell++) {
+    blocks_[cell / block_size_] |= static_cast<uint64_t>(code_by_character_[
+        static_cast<unsigned char>(kCells[cell])]) << (cell % block_size_
+        * bits_per_cell_);
+  }
+  begin_ = 0;
+  end_ = kCells.size();
+  scanner_ = turing_machine.GetIndexOfScanner();
+  block_transition_cache_.resize(kMinCacheSlots);
+  is_empty_ = false;
+}
+
+RunResult BlockMacroMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult BlockMacroMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> BlockMacroMachine::GetTape() const {
+  std::vector<char> cells;
+  cells.reserve(end_ - begin_);
+  const uint64_t kMask = (static_cast<uint64_t>(1) << bits_per_cell_) - 1;
+  for (size_t cell = begin_; cell < end_; cell++) {
+    cells.push_back(character_by_code_[(blocks_[cell / block_size_] >> (cell
+        % block_size_ * bits_per_cell_)) & kMask]);
+  }
+  return cells;
+}
+
+size_t BlockMacroMachine::GetIndexOfScanner() const {
+  return scanner_ - begin_;
+}
+
+State BlockMacroMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return transition_table_.GetState(current_state_index_);
+}
+
+uint64_t BlockMacroMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+bool BlockMacroMachine::IsHalted() const {
+  return is_halted_;
+}
+
+size_t BlockMacroMachine::GetNumberOfCachedBlockTransitions() const {
+  return num_cached_block_transitions_;
+}
+
+bool BlockMacroMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult BlockMacroMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty block macro machine has nothing to run
+    return result;
+  }
+
+  const int64_t kBlockSize = static_cast<int64_t>(block_size_);
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted_) {
+      break;
+    }
+    const size_t kBlock = scanner_ / block_size_;
+    const size_t kEntryOffset = scanner_ % block_size_;
+    const uint64_t kContents = blocks_[kBlock];
+    const uint64_t kEntry = ((static_cast<uint64_t>(current_state_index_)
+        << 8) | kEntryOffset) + 1;
+    const uint64_t kRemainingSteps = max_steps - num_steps_taken;
+
+    // use the cached block transition if there is one that fits in the steps
+    // left, otherwise simulate the block 1 step at a time
+    BlockTransition simulated_block_transition;
+    const BlockTransition *block_transition = FindBlockTransition(kEntry,
+        kContents);
+    if (block_transition == nullptr
+        || block_transition->num_steps > kRemainingSteps) {
+      simulated_block_transition = SimulateBlock(kBlock, kRemainingSteps);
+      if (simulated_block_transition.is_complete) {
+        CacheBlockTransition(kEntry, kContents, simulated_block_transition);
+      }
+      block_transition = &simulated_block_transition;
+    }
+
+    if (block_transition->num_steps == 0) {
+      // no direction applies to the current state and character
+      break;
+    }
+
+    // apply the block transition
+    const size_t kEntryStateIndex = current_state_index_;
+    blocks_[kBlock] = block_transition->contents;
+    current_state_index_ = block_transition->state_to_move_to;
+    num_steps_taken += block_transition->num_steps;
+    if (transition_table_.IsHaltingState(current_state_index_)) {
+      is_halted_ = true;
+    }
+    const int64_t kBlockStart = static_cast<int64_t>(kBlock) * kBlockSize;
+    int64_t min_scanner_index = kBlockStart
+        + block_transition->min_scanner_offset;
+    int64_t max_scanner_index = kBlockStart
+        + block_transition->max_scanner_offset;
+    int64_t scanner_index = kBlockStart + block_transition->scanner_offset;
+
+    // a block crossed from 1 end to the other in the state it was entered in
+    // crosses every identical block behind it the same way
+    const bool kIsChainRight = block_transition->scanner_offset == kBlockSize
+        && kEntryOffset == 0;
+    const bool kIsChainLeft = block_transition->scanner_offset == -1
+        && static_cast<int64_t>(kEntryOffset) == kBlockSize - 1;
+    if ((kIsChainRight || kIsChainLeft) && current_state_index_
+        == kEntryStateIndex && !is_halted_) {
+      const uint64_t kNumStepsPerBlock = block_transition->num_steps;
+      const int64_t kDirection = kIsChainRight ? 1 : -1;
+      int64_t next_block = static_cast<int64_t>(kBlock) + kDirection;
+      while (next_block >= 0 && next_block < static_cast<int64_t>(
+          blocks_.size()) && blocks_[static_cast<size_t>(next_block)]
+          == kContents && max_steps - num_steps_taken >= kNumStepsPerBlock) {
+        blocks_[static_cast<size_t>(next_block)] = block_transition->contents;
+        num_steps_taken += kNumStepsPerBlock;
+        scanner_index += kDirection * kBlockSize;
+        next_block += kDirection;
+      }
+      min_scanner_index = std::min(min_scanner_index, scanner_index);
+      max_scanner_index = std::max(max_scanner_index, scanner_index);
+    }
+
+    // the scanner may have left the block into a cell that is not stored yet
+    int64_t shift = 0;
+    if (scanner_index < 0) {
+      const size_t kNumBlocksBeforeGrowing = blocks_.size();
+      GrowLeft();
+      shift = static_cast<int64_t>(blocks_.size() - kNumBlocksBeforeGrowing)
+          * kBlockSize;
+      begin_ += static_cast<size_t>(shift);
+      end_ += static_cast<size_t>(shift);
+    } else if (static_cast<size_t>(scanner_index) == blocks_.size()
+        * block_size_) {
+      GrowRight();
+    }
+    scanner_ = static_cast<size_t>(scanner_index + shift);
+    begin_ = std::min(begin_, static_cast<size_t>(min_scanner_index + shift));
+    end_ = std::max(end_, static_cast<size_t>(max_scanner_index + shift + 1));
+  }
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = GetIndexOfScanner();
+  return result;
+}
+
+const BlockTransition *BlockMacroMachine::FindBlockTransition(uint64_t entry,
+    uint64_t contents) const {
+  const size_t kMask = block_transition_cache_.size() - 1;
+  for (size_t slot = GetFirstSlot(entry, contents,
+      block_transition_cache_.size()); ; slot = (slot + 1) & kMask) {
+    const CachedBlockTransition &kSlot = block_transition_cache_[slot];
+    if (kSlot.entry == 0) {
+      return nullptr;
+    }
+    if (kSlot.entry == entry && kSlot.contents == contents) {
+      return &kSlot.block_transition;
+    }
+  }
+}
+
+void BlockMacroMachine::CacheBlockTransition(uint64_t entry, uint64_t
+    contents, const BlockTransition &block_transition) {
+  // keep at least half of the slots free so probes stay short
+  if (2 * (num_cached_block_transitions_ + 1)
+      > block_transition_cache_.size()) {
+    std::vector<CachedBlockTransition> slots;
+    if (num_cached_block_transitions_ < kMaxCachedBlockTransitions) {
+      slots.swap(block_transition_cache_);
+    }
+    block_transition_cache_.assign(std::max(kMinCacheSlots, 2 * slots.size()),
+        CachedBlockTransition());
+    num_cached_block_transitions_ = 0;
+    for (const CachedBlockTransition &kSlot : slots) {
+      if (kSlot.entry != 0) {
+        CacheBlockTransition(kSlot.entry, kSlot.contents,
+            kSlot.block_transition);
+      }
+    }
+  }
+  const size_t kMask = block_transition_cache_.size() - 1;
+  size_t slot = GetFirstSlot(entry, contents, block_transition_cache_.size());
+  while (block_transition_cache_[slot].entry != 0) {
+    slot = (slot + 1) & kMask;
+  }
+  block_transition_cache_[slot].entry = entry;
+  block_transition_cache_[slot].contents = contents;
+  block_transition_cache_[slot].block_transition = block_transition;
+  num_cached_block_transitions_ += 1;
+}
+
+BlockTransition BlockMacroMachine::SimulateBlock(size_t block, uint64_t
+    step_limit) const {
+  // unpack the block into 1 code per cell
+  uint8_t codes[64];
+  const uint64_t kMask = (static_cast<uint64_t>(1) << bits_per_cell_) - 1;
+  for (size_t cell = 0; cell < block_size_; cell++) {
+    codes[cell] = static_cast<uint8_t>((blocks_[block] >> (cell
+        * bits_per_cell_)) & kMask);
+  }
+
+  BlockTransition block_transition;
+  size_t state_index = current_state_index_;
+  int64_t scanner_offset = static_cast<int64_t>(scanner_ % block_size_);
+  block_transition.min_scanner_offset = static_cast<int32_t>(scanner_offset);
+  block_transition.max_scanner_offset = static_cast<int32_t>(scanner_offset);
+
+  const int64_t kBlockSize = static_cast<int64_t>(block_size_);
+  const uint64_t kStepLimit = std::min<uint64_t>(step_limit,
+      kMaxStepsPerBlockSimulation);
+  while (true) {
+    const Transition &kTransition = transition_table_.GetTransition(
+        state_index, character_by_code_[codes[scanner_offset]]);
+    if (!kTransition.is_defined) {
+      block_transition.is_complete = true;
+      break;
+    }
+    codes[scanner_offset] = code_by_character_[static_cast<unsigned char>(
+        kTransition.write)];
+    scanner_offset += kTransition.scanner_offset;
+    state_index = kTransition.state_to_move_to;
+    block_transition.num_steps += 1;
+    block_transition.min_scanner_offset = std::min(
+        block_transition.min_scanner_offset, static_cast<int32_t>(
+        scanner_offset));
+    block_transition.max_scanner_offset = std::max(
+        block_transition.max_scanner_offset, static_cast<int32_t>(
+        scanner_offset));
+    if (scanner_offset < 0 || scanner_offset >= kBlockSize
+        || transition_table_.IsHaltingState(state_index)) {
+      block_transition.is_complete = true;
+      break;
+    }
+    if (block_transition.num_steps >= kStepLimit) {
+      break;
+    }
+  }
+
+  for (size_t cell = 0; cell < block_size_; cell++) {
+    block_transition.contents |= static_cast<uint64_t>(codes[cell]) << (cell
+        * bits_per_cell_);
+  }
+  block_transition.state_to_move_to = static_cast<uint32_t>(state_index);
+  block_transition.scanner_offset = static_cast<int32_t>(scanner_offset);
+  return block_transition;
+}
+
+void BlockMacroMachine::GrowLeft() {
+  // doubling the number of blocks keeps the total cost of growing the tape
+  // linear in its final length
+  blocks_.insert(blocks_.begin(), blocks_.size(), 0);
+}
+
+void BlockMacroMachine::GrowRight() {
+  blocks_.resize(blocks_.size() * 2, 0);
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,138 @@
+#include "chunked_tape.h"
+
+#include <algorithm>
+
+namespace turingmachinesimulator {
+
+const size_t ChunkedTape::kChunkShift;
+const size_t ChunkedTape::kCellsPerChunk;
+const size_t ChunkedTape::kCellMask;
+
+ChunkedTape::ChunkedTape(const std::vector<char> &cells, char
+    blank_character)
+    : blank_character_(blank_character) {
+  // if the given tape is empty, set it to 1 blank character (same thing as
+  // an empty tape)
+  const std::vector<char> kCells = cells.empty()
+      ? std::vector<char>{blank_character} : cells;
+  blank_chunk_ = std::make_shared<Chunk>();
+  blank_chunk_->fill(blank_character);
+  for (size_t first_cell = 0; first_cell < kCells.size(); first_cell
+      += kCellsPerChunk) {
+    std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(*blank_chunk_);
+    const size_t kNumCells = std::min(kCellsPerChunk, kCells.size()
+        - first_cell);
+    std::copy(kCells.begin() + first_cell, kCells.begin() + first_cell
+        + kNumCells, chunk->begin());
+    chunks_.push_back(chunk);
+  }
+  begin_ = 0;
+  end_ = kCells.size();
+  scanner_ = 0;
+  origin_ = 0;
+}
+
+ChunkedTape::ChunkedTape(const std::vector<char> &cells, char
+    blank_character, size_t index_of_scanner, int64_t position_of_scanner)
+    : ChunkedTape(cells, blank_character) {
+  scanner_ = std::min(index_of_scanner, end_ - 1);
+  // the first cell of the starting tape is left of the given cells if they
+  // were trimmed from a tape with a blank margin
+  origin_ = static_cast<int64_t>(scanner_) - position_of_scanner;
+}
+
+uint64_t ChunkedTape::SkipRight(char character, uint64_t max_cells) {
+  if (chunks_.empty()) {
+    return 0;
+  }
+  // the last cell is left to a normal step, which grows the tape if needed
+  const size_t kLastCell = scanner_ + static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(end_ - 1 - scanner_)));
+  const size_t kFirstCell = scanner_;
+  while (scanner_ < kLastCell && (*chunks_[scanner_ >> kChunkShift])[
+      scanner_ & kCellMask] == character) {
+    scanner_ += 1;
+  }
+  return scanner_ - kFirstCell;
+}
+
+uint64_t ChunkedTape::SkipLeft(char character, uint64_t max_cells) {
+  if (chunks_.empty()) {
+    return 0;
+  }
+  // the first cell is left to a normal step, which grows the tape if needed
+  const size_t kLastCell = scanner_ - static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(scanner_ - begin_)));
+  const size_t kFirstCell = scanner_;
+  while (scanner_ > kLastCell && (*chunks_[scanner_ >> kChunkShift])[
+      scanner_ & kCellMask] == character) {
+    scanner_ -= 1;
+  }
+  return kFirstCell - scanner_;
+}
+
+std::vector<char> ChunkedTape::GetCells() const {
+  std::vector<char> cells;
+  cells.reserve(end_ - begin_);
+  size_t cell = begin_;
+  while (cell < end_) {
+    // copy the cells up to the end of each chunk at once
+    const Chunk &kChunk = *chunks_[cell >> kChunkShift];
+    const size_t kEndOfChunk = std::min(end_, (cell | kCellMask) + 1);
+    cells.insert(cells.end(), kChunk.begin() + (cell & kCellMask),
+        kChunk.begin() + (kEndOfChunk - (cell & ~kCellMask)));
+    cell = kEndOfChunk;
+  }
+  return cells;
+}
+
+char ChunkedTape::GetCell(size_t index) const {
+  const size_t kCell = begin_ + index;
+  return chunks_.at(kCell >> kChunkShift)->at(kCell & kCellMask);
+}
+
+size_t ChunkedTape::GetSize() const {
+  return end_ - begin_;
+}
+
+size_t ChunkedTape::GetIndexOfScanner() const {
+  return scanner_ - begin_;
+}
+
+int64_t ChunkedTape::GetPositionOfScanner() const {
+  return static_cast<int64_t>(scanner_) - origin_;
+}
+
+char ChunkedTape::GetBlankCharacter() const {
+  return blank_character_;
+}
+
+size_t ChunkedTape::GetNumberOfChunks() const {
+  return chunks_.size();
+}
+
+size_t ChunkedTape::GetNumberOfOwnedChunks() const {
+  size_t num_owned_chunks = 0;
+  for (const std::shared_ptr<Chunk> &kChunk : chunks_) {
+    num_owned_chunks += kChunk.use_count() == 1 ? 1 : 0;
+  }
+  return num_owned_chunks;
+}
+
+void ChunkedTape::GrowLeft() {
+  // every chunk of headroom is the shared blank chunk, so it costs no cells
+  // until it is written to
+  const size_t kHeadroom = std::max<size_t>(1, chunks_.size());
+  chunks_.insert(chunks_.begin(), kHeadroom, blank_chunk_);
+  begin_ += kHeadroom << kChunkShift;
+  end_ += kHeadroom << kChunkShift;
+  scanner_ += kHeadroom << kChunkShift;
+  origin_ += static_cast<int64_t>(kHeadroom << kChunkShift);
+}
+
+void ChunkedTape::GrowRight() {
+  const size_t kHeadroom = std::max<size_t>(1, chunks_.size());
+  chunks_.resize(chunks_.size() + kHeadroom, blank_chunk_);
+}
+
+} // namespace turingmachinesimulator
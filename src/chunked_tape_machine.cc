@@ -0,0 +1,119 @@
+#include "chunked_tape_machine.h"
+
+namespace turingmachinesimulator {
+
+ChunkedTapeMachine::ChunkedTapeMachine(const TuringMachine &turing_machine) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty chunked tape machine if there is nothing to
+    // run
+    return;
+  }
+  program_ = turing_machine.GetProgram();
+  tape_ = ChunkedTape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), turing_machine.GetIndexOfScanner(),
+      turing_machine.GetPositionOfScanner());
+  current_state_index_ = program_->GetTransitionTable().GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+  is_empty_ = false;
+}
+
+RunResult ChunkedTapeMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult ChunkedTapeMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> ChunkedTapeMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+const ChunkedTape &ChunkedTapeMachine::GetChunkedTape() const {
+  return tape_;
+}
+
+size_t ChunkedTapeMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+int64_t ChunkedTapeMachine::GetPositionOfScanner() const {
+  return tape_.GetPositionOfScanner();
+}
+
+State ChunkedTapeMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return program_->GetTransitionTable().GetState(current_state_index_);
+}
+
+uint64_t ChunkedTapeMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+bool ChunkedTapeMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool ChunkedTapeMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult ChunkedTapeMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty chunked tape machine has nothing to run
+    return result;
+  }
+
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  size_t state_index = current_state_index_;
+  bool is_halted = is_halted_;
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted) {
+      break;
+    }
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        state_index, tape_.Read());
+    if (!kTransition.is_defined) {
+      break;
+    }
+    if (kTransition.is_sweep) {
+      // each skipped cell is 1 step that changes nothing but the scanner (and
+      // leaves the chunks it passes shared)
+      const uint64_t kNumCellsSkipped = kTransition.scanner_offset > 0
+          ? tape_.SkipRight(kTransition.write, max_steps - num_steps_taken)
+          : tape_.SkipLeft(kTransition.write, max_steps - num_steps_taken);
+      if (kNumCellsSkipped > 0) {
+        num_steps_taken += kNumCellsSkipped;
+        continue;
+      }
+    }
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+    num_steps_taken += 1;
+  }
+  current_state_index_ = state_index;
+  is_halted_ = is_halted;
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = kTransitionTable.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = tape_.GetIndexOfScanner();
+  return result;
+}
+
+} // namespace turingmachinesimulator
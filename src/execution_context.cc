@@ -0,0 +1,344 @@
+#include "execution_context.h"
+
+#include "configuration_formatter.h"
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * size_t storing the most step events delivered to the listeners at once
+ */
+const size_t kMaxEventsPerBatch = 4096;
+
+} // namespace
+
+ExecutionContext::ExecutionContext(const std::shared_ptr<const Program>
+    &program, const std::vector<char> &tape, char blank_character)
+    // NOTE: the tape treats an empty tape as 1 blank character
+    : ExecutionContext(program, Tape(tape, blank_character)) {
+}
+
+ExecutionContext::ExecutionContext(const std::shared_ptr<const Program>
+    &program, const Tape &tape)
+    : program_(program),
+      tape_(tape) {
+  if (program_ == nullptr || program_->IsEmpty()) {
+    // an empty program has nothing to run
+    return;
+  }
+  current_state_index_ = program_->GetStartingStateIndex();
+  is_empty_ = false;
+}
+
+ExecutionContext::ExecutionContext(const ExecutionContext &execution_context)
+    : program_(execution_context.program_),
+      tape_(execution_context.tape_),
+      current_state_index_(execution_context.current_state_index_),
+      num_steps_(execution_context.num_steps_),
+      is_halted_(execution_context.is_halted_),
+      is_empty_(execution_context.is_empty_) {
+}
+
+ExecutionContext &ExecutionContext::operator=(const ExecutionContext
+    &execution_context) {
+  if (this == &execution_context) {
+    return *this;
+  }
+  program_ = execution_context.program_;
+  tape_ = execution_context.tape_;
+  current_state_index_ = execution_context.current_state_index_;
+  num_steps_ = execution_context.num_steps_;
+  is_halted_ = execution_context.is_halted_;
+  listeners_.clear();
+  next_subscription_id_ = 0;
+  recorded_events_.clear();
+  is_empty_ = execution_context.is_empty_;
+  return *this;
+}
+
+State ExecutionContext::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return program_->GetTransitionTable().GetState(current_state_index_);
+}
+
+size_t ExecutionContext::GetCurrentStateIndex() const {
+  return current_state_index_;
+}
+
+int ExecutionContext::GetCurrentStateId() const {
+  if (is_empty_) {
+    return -1;
+  }
+  return program_->GetTransitionTable().GetState(current_state_index_).GetId();
+}
+
+std::vector<char> ExecutionContext::GetTape() const {
+  return tape_.GetCells();
+}
+
+TapeView ExecutionContext::GetTapeView() const {
+  return tape_.GetView();
+}
+
+size_t ExecutionContext::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+int64_t ExecutionContext::GetPositionOfScanner() const {
+  return tape_.GetPositionOfScanner();
+}
+
+uint64_t ExecutionContext::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+char ExecutionContext::GetBlankCharacter() const {
+  return tape_.GetBlankCharacter();
+}
+
+const std::shared_ptr<const Program> &ExecutionContext::GetProgram() const {
+  return program_;
+}
+
+size_t ExecutionContext::Subscribe(const StepEventListener &listener) {
+  const size_t kSubscriptionId = next_subscription_id_;
+  next_subscription_id_ += 1;
+  listeners_.push_back(std::make_pair(kSubscriptionId, listener));
+  return kSubscriptionId;
+}
+
+void ExecutionContext::Unsubscribe(size_t subscription_id) {
+  for (size_t i = 0; i < listeners_.size(); i++) {
+    if (listeners_[i].first == subscription_id) {
+      listeners_.erase(listeners_.begin() + i);
+      return;
+    }
+  }
+}
+
+bool ExecutionContext::HasListeners() const {
+  return !listeners_.empty();
+}
+
+void ExecutionContext::SetConfiguration(const Tape &tape, size_t
+    current_state_index, uint64_t num_steps, bool is_halted) {
+  if (is_empty_) {
+    return;
+  }
+  const size_t kMaxBlankMargin = tape_.GetMaxBlankMargin();
+  tape_ = tape;
+  tape_.SetMaxBlankMargin(kMaxBlankMargin);
+  current_state_index_ = current_state_index;
+  num_steps_ = num_steps;
+  is_halted_ = is_halted;
+}
+
+void ExecutionContext::SetMaxBlankMargin(size_t max_blank_margin) {
+  tape_.SetMaxBlankMargin(max_blank_margin);
+}
+
+bool ExecutionContext::IsTapeGenerated() const {
+  return tape_.IsGenerated();
+}
+
+StateLayoutReport ExecutionContext::OptimizeStateLayout(uint64_t
+    num_warm_up_steps) {
+  if (is_empty_) {
+    return StateLayoutReport();
+  }
+  StateLayoutProfiler profiler = StateLayoutProfiler(program_);
+  profiler.Profile(tape_, current_state_index_, num_warm_up_steps);
+  const State kCurrentState = GetCurrentState();
+  program_ = std::make_shared<const Program>(*program_,
+      profiler.GetStateOrder());
+  current_state_index_ = program_->GetTransitionTable().GetStateIndex(
+      kCurrentState);
+  return profiler.GetReport();
+}
+
+bool ExecutionContext::IsHalted() const {
+  return is_halted_;
+}
+
+bool ExecutionContext::IsEmpty() const {
+  return is_empty_;
+}
+
+std::string ExecutionContext::GetConfigurationForConsole() const {
+  return FormatConfigurationForConsole(tape_, GetCurrentState());
+}
+
+std::string ExecutionContext::GetConfigurationForMarkdown() const {
+  return FormatConfigurationForMarkdown(tape_, GetCurrentState());
+}
+
+void ExecutionContext::Update() {
+  // 1 step is the same as a run of up to 1 step
+  RunSteps(1, false);
+}
+
+RunResult ExecutionContext::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult ExecutionContext::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+RunResult ExecutionContext::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty execution context has nothing to run
+    return result;
+  }
+
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  uint64_t num_steps_taken = 0;
+  if (!listeners_.empty()) {
+    RunStepsRecordingEvents(max_steps, stop_at_halting_state,
+        num_steps_taken);
+  } else {
+    // runs without listeners never record events, so they pay nothing for
+    // them, can skip runs of sweep steps, and take chains of steps as fused
+    // transitions; the state and step count are kept in locals during the
+    // loop so the compiler can keep them in registers
+    size_t state_index = current_state_index_;
+    bool is_halted = is_halted_;
+    while (num_steps_taken < max_steps) {
+      if (stop_at_halting_state && is_halted) {
+        break;
+      }
+      const FusedTransition &kFusedTransition =
+          kTransitionTable.GetFusedTransition(state_index, tape_.Read());
+      const Transition &kTransition = kFusedTransition.transition;
+      if (!kTransition.is_defined) {
+        break;
+      }
+      if (kTransition.is_sweep) {
+        // each skipped cell is 1 step that changes nothing but the scanner
+        const uint64_t kNumCellsSkipped = kTransition.scanner_offset > 0
+            ? tape_.SkipRight(kTransition.write, max_steps - num_steps_taken)
+            : tape_.SkipLeft(kTransition.write, max_steps - num_steps_taken);
+        if (kNumCellsSkipped > 0) {
+          num_steps_taken += kNumCellsSkipped;
+          continue;
+        }
+      }
+      if (kFusedTransition.num_steps > max_steps - num_steps_taken) {
+        // the chain does not fit in the steps left, so take 1 step of it
+        const Transition &kFirstTransition = kTransitionTable.GetTransition(
+            state_index, tape_.Read());
+        tape_.Write(kFirstTransition.write);
+        if (kFirstTransition.scanner_offset < 0) {
+          tape_.MoveLeft();
+        } else if (kFirstTransition.scanner_offset > 0) {
+          tape_.MoveRight();
+        }
+        state_index = kFirstTransition.state_to_move_to;
+        is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+        num_steps_taken += 1;
+        continue;
+      }
+      tape_.Write(kTransition.write);
+      if (kTransition.scanner_offset < 0) {
+        tape_.MoveLeft();
+      } else if (kTransition.scanner_offset > 0) {
+        tape_.MoveRight();
+      }
+      state_index = kTransition.state_to_move_to;
+      num_steps_taken += kFusedTransition.num_steps;
+      if (kFusedTransition.num_steps_before_jumps != kFusedTransition.num_steps
+          && !kTransitionTable.IsReadCharacter(tape_.Read())) {
+        // the first jump state has no direction for the character moved onto
+        state_index = kFusedTransition.first_jump_state;
+        num_steps_taken -= kFusedTransition.num_steps
+            - kFusedTransition.num_steps_before_jumps;
+      }
+      is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+    }
+    current_state_index_ = state_index;
+    is_halted_ = is_halted;
+    num_steps_ += num_steps_taken;
+  }
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = kTransitionTable.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = tape_.GetIndexOfScanner();
+  return result;
+}
+
+void ExecutionContext::RunStepsRecordingEvents(uint64_t max_steps, bool
+    stop_at_halting_state, uint64_t &num_steps_taken) {
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted_) {
+      break;
+    }
+    const char kRead = tape_.Read();
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        current_state_index_, kRead);
+    if (!kTransition.is_defined) {
+      break;
+    }
+    num_steps_taken += 1;
+    num_steps_ += 1;
+    StepEvent event;
+    event.step = num_steps_;
+    if (kTransition.write != kRead) {
+      tape_.Write(kTransition.write);
+      event.type = StepEventType::kWrite;
+      event.position = tape_.GetPositionOfScanner();
+      event.character = kTransition.write;
+      recorded_events_.push_back(event);
+    }
+    if (kTransition.scanner_offset != 0) {
+      if (kTransition.scanner_offset < 0) {
+        tape_.MoveLeft();
+      } else {
+        tape_.MoveRight();
+      }
+      event.type = StepEventType::kMove;
+      event.position = tape_.GetPositionOfScanner();
+      recorded_events_.push_back(event);
+    }
+    event.state_index = kTransition.state_to_move_to;
+    if (kTransition.state_to_move_to != current_state_index_) {
+      current_state_index_ = kTransition.state_to_move_to;
+      event.type = StepEventType::kStateChange;
+      recorded_events_.push_back(event);
+    }
+    if (!is_halted_ && kTransitionTable.IsHaltingState(
+        current_state_index_)) {
+      is_halted_ = true;
+      event.type = StepEventType::kHalt;
+      recorded_events_.push_back(event);
+    }
+
+    // batches are only delivered between steps
+    if (recorded_events_.size() >= kMaxEventsPerBatch) {
+      DeliverEvents();
+    }
+  }
+  DeliverEvents();
+}
+
+void ExecutionContext::DeliverEvents() {
+  if (recorded_events_.empty()) {
+    return;
+  }
+  // NOTE: listeners are copied so that a listener may unsubscribe
+  const std::vector<std::pair<size_t, StepEventListener>> kListeners =
+      listeners_;
+  for (const std::pair<size_t, StepEventListener> &kListener : kListeners) {
+    kListener.second(recorded_events_);
+  }
+  recorded_events_.clear();
+}
+
+} // namespace turingmachinesimulator
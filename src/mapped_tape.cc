@@ -0,0 +1,539 @@
+#include "mapped_tape.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * size_t storing the largest log2 of the number of cells in a chunk
+ */
+const size_t kMaxChunkShift = 30;
+
+// the file and mapping calls are wrapped so that the tape itself has no
+// platform checks; on platforms without them every call fails
+
+/**
+ * This method maps the given bytes of the given file into memory
+ *
+ * @param file an int representing the descriptor of an open file
+ * @param offset an int64_t representing the offset of the first byte (a
+ *     multiple of the page size)
+ * @param num_bytes a size_t representing the number of bytes to map
+ * @param is_private a bool that is true if changes to the mapping must not
+ *     reach the file
+ * @return a pointer to the mapped bytes (null if they could not be mapped)
+ */
+char *MapFile(int file, int64_t offset, size_t num_bytes, bool is_private) {
+#ifdef _WIN32
+  (void) file;
+  (void) offset;
+  (void) num_bytes;
+  (void) is_private;
+  return nullptr;
+#else
+  void *bytes = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, is_private
+      ? MAP_PRIVATE : MAP_SHARED, file, static_cast<off_t>(offset));
+  return bytes == MAP_FAILED ? nullptr : static_cast<char *>(bytes);
+#endif
+}
+
+void UnmapFile(char *bytes, size_t num_bytes) {
+#ifdef _WIN32
+  (void) bytes;
+  (void) num_bytes;
+#else
+  munmap(bytes, num_bytes);
+#endif
+}
+
+/**
+ * This method asks for the given mapped bytes to be backed by huge pages, if
+ * the platform has them
+ */
+void AdviseHugePages(char *bytes, size_t num_bytes) {
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+  madvise(bytes, num_bytes, MADV_HUGEPAGE);
+#else
+  (void) bytes;
+  (void) num_bytes;
+#endif
+}
+
+/**
+ * This method reads the given number of bytes at the given offset of the
+ * given file
+ *
+ * @return a bool that is false if the bytes could not all be read
+ */
+bool ReadFile(int file, char *bytes, size_t num_bytes, int64_t offset) {
+#ifdef _WIN32
+  (void) file;
+  (void) bytes;
+  (void) num_bytes;
+  (void) offset;
+  return false;
+#else
+  while (num_bytes > 0) {
+    const ssize_t kNumBytesRead = pread(file, bytes, num_bytes,
+        static_cast<off_t>(offset));
+    if (kNumBytesRead <= 0) {
+      return false;
+    }
+    bytes += kNumBytesRead;
+    num_bytes -= static_cast<size_t>(kNumBytesRead);
+    offset += kNumBytesRead;
+  }
+  return true;
+#endif
+}
+
+/**
+ * This method writes the given bytes at the given offset of the given file
+ *
+ * @return a bool that is false if the bytes could not all be written
+ */
+bool WriteFile(int file, const char *bytes, size_t num_bytes, int64_t
+    offset) {
+#ifdef _WIN32
+  (void) file;
+  (void) bytes;
+  (void) num_bytes;
+  (void) offset;
+  return false;
+#else
+  while (num_bytes > 0) {
+    const ssize_t kNumBytesWritten = pwrite(file, bytes, num_bytes,
+        static_cast<off_t>(offset));
+    if (kNumBytesWritten <= 0) {
+      return false;
+    }
+    bytes += kNumBytesWritten;
+    num_bytes -= static_cast<size_t>(kNumBytesWritten);
+    offset += kNumBytesWritten;
+  }
+  return true;
+#endif
+}
+
+} // namespace
+
+MappedTape::MappedTape(const std::vector<char> &cells, char blank_character,
+    const MappedTapeOptions &options)
+    : MappedTape(cells, blank_character, 0, 0, options) {
+}
+
+MappedTape::MappedTape(const std::vector<char> &cells, char blank_character,
+    size_t index_of_scanner, int64_t position_of_scanner, const
+    MappedTapeOptions &options) {
+  if (!Initialize(blank_character, options)) {
+    return;
+  }
+  // if the given tape is empty, set it to 1 blank character (same thing as
+  // an empty tape)
+  const std::vector<char> kCells = cells.empty()
+      ? std::vector<char>{blank_character} : cells;
+
+  // the cells go straight to the scratch file, and are mapped when the
+  // scanner reaches them
+  const size_t kCellsPerChunk = cell_mask_ + 1;
+  chunks_.resize((kCells.size() + cell_mask_) >> chunk_shift_);
+  std::vector<char> chunk_cells(kCellsPerChunk);
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    const size_t kFirstCell = i << chunk_shift_;
+    const size_t kNumCells = std::min(kCellsPerChunk, kCells.size()
+        - kFirstCell);
+    std::fill(chunk_cells.begin(), chunk_cells.end(), blank_character);
+    std::copy(kCells.begin() + kFirstCell, kCells.begin() + kFirstCell
+        + kNumCells, chunk_cells.begin());
+    chunks_[i].scratch_index = AddScratchChunk();
+    if (chunks_[i].scratch_index < 0 || !WriteFile(scratch_file_,
+        chunk_cells.data(), kCellsPerChunk, chunks_[i].scratch_index
+        << chunk_shift_)) {
+      error_message_ = "Could Not Write To Scratch File";
+      Release();
+      return;
+    }
+  }
+  end_ = kCells.size();
+  scanner_ = std::min(index_of_scanner, end_ - 1);
+  // the first cell of the starting tape is left of the given cells if they
+  // were trimmed from a tape with a blank margin
+  origin_ = static_cast<int64_t>(scanner_) - position_of_scanner;
+  is_empty_ = false;
+  EnterChunk(scanner_ >> chunk_shift_);
+}
+
+MappedTape MappedTape::FromFile(const std::string &input_path, char
+    blank_character, const MappedTapeOptions &options) {
+  MappedTape tape;
+  if (tape.Initialize(blank_character, options)) {
+    tape.MapInputFile(input_path);
+  }
+  return tape;
+}
+
+void MappedTape::MapInputFile(const std::string &input_path) {
+#ifdef _WIN32
+  (void) input_path;
+#else
+  input_file_ = open(input_path.c_str(), O_RDONLY);
+  struct stat input_file_status;
+  if (input_file_ < 0 || fstat(input_file_, &input_file_status) != 0) {
+    error_message_ = "Could Not Open Input File";
+    Release();
+    return;
+  }
+  const size_t kFileSize = static_cast<size_t>(input_file_status.st_size);
+
+  // whole chunks of the file are mapped from it when the scanner reaches
+  // them; a last partial chunk would be mapped past the end of the file, so
+  // it is copied to the scratch file instead
+  const size_t kCellsPerChunk = cell_mask_ + 1;
+  end_ = std::max<size_t>(kFileSize, 1);
+  chunks_.resize((end_ + cell_mask_) >> chunk_shift_);
+  for (size_t i = 0; i < kFileSize >> chunk_shift_; i++) {
+    chunks_[i].input_offset = static_cast<int64_t>(i << chunk_shift_);
+  }
+  const size_t kNumCellsInLastChunk = kFileSize & cell_mask_;
+  if (kNumCellsInLastChunk > 0) {
+    std::vector<char> chunk_cells(kCellsPerChunk, blank_character_);
+    ChunkSlot &last_chunk = chunks_.back();
+    last_chunk.scratch_index = AddScratchChunk();
+    if (!ReadFile(input_file_, chunk_cells.data(), kNumCellsInLastChunk,
+        static_cast<int64_t>(kFileSize - kNumCellsInLastChunk))
+        || last_chunk.scratch_index < 0 || !WriteFile(scratch_file_,
+        chunk_cells.data(), kCellsPerChunk, last_chunk.scratch_index
+        << chunk_shift_)) {
+      error_message_ = "Could Not Read Input File";
+      Release();
+      return;
+    }
+  }
+  is_empty_ = false;
+  EnterChunk(0);
+#endif
+}
+
+MappedTape::~MappedTape() {
+  Release();
+}
+
+MappedTape::MappedTape(MappedTape &&other) {
+  *this = std::move(other);
+}
+
+MappedTape &MappedTape::operator=(MappedTape &&other) {
+  if (this == &other) {
+    return *this;
+  }
+  Release();
+  chunks_ = std::move(other.chunks_);
+  resident_chunks_ = std::move(other.resident_chunks_);
+  current_cells_ = other.current_cells_;
+  current_chunk_ = other.current_chunk_;
+  is_current_chunk_written_ = other.is_current_chunk_written_;
+  num_chunks_entered_ = other.num_chunks_entered_;
+  chunk_shift_ = other.chunk_shift_;
+  cell_mask_ = other.cell_mask_;
+  max_resident_chunks_ = other.max_resident_chunks_;
+  use_huge_pages_ = other.use_huge_pages_;
+  scratch_file_ = other.scratch_file_;
+  input_file_ = other.input_file_;
+  num_scratch_chunks_ = other.num_scratch_chunks_;
+  // moving the vector keeps its buffer, so the scanner may still point at it
+  failed_cells_ = std::move(other.failed_cells_);
+  begin_ = other.begin_;
+  end_ = other.end_;
+  scanner_ = other.scanner_;
+  origin_ = other.origin_;
+  blank_character_ = other.blank_character_;
+  has_failed_ = other.has_failed_;
+  is_empty_ = other.is_empty_;
+  error_message_ = other.error_message_;
+
+  // the other tape no longer owns the mappings or the files
+  other.chunks_.clear();
+  other.resident_chunks_.clear();
+  other.current_cells_ = nullptr;
+  other.scratch_file_ = -1;
+  other.input_file_ = -1;
+  other.is_empty_ = true;
+  return *this;
+}
+
+std::vector<char> MappedTape::GetCells() const {
+  std::vector<char> cells(end_ - begin_);
+  size_t cell = begin_;
+  while (cell < end_) {
+    // read the cells up to the end of each chunk at once
+    const size_t kEndOfChunk = std::min(end_, (cell | cell_mask_) + 1);
+    ReadCells(cell, kEndOfChunk - cell, cells.data() + (cell - begin_));
+    cell = kEndOfChunk;
+  }
+  return cells;
+}
+
+char MappedTape::GetCell(size_t index) const {
+  char character = blank_character_;
+  ReadCells(begin_ + index, 1, &character);
+  return character;
+}
+
+size_t MappedTape::GetSize() const {
+  return end_ - begin_;
+}
+
+size_t MappedTape::GetIndexOfScanner() const {
+  return scanner_ - begin_;
+}
+
+int64_t MappedTape::GetPositionOfScanner() const {
+  return static_cast<int64_t>(scanner_) - origin_;
+}
+
+char MappedTape::GetBlankCharacter() const {
+  return blank_character_;
+}
+
+size_t MappedTape::GetNumberOfChunks() const {
+  return chunks_.size();
+}
+
+size_t MappedTape::GetNumberOfResidentChunks() const {
+  return resident_chunks_.size();
+}
+
+size_t MappedTape::GetNumberOfCellsPerChunk() const {
+  return cell_mask_ + 1;
+}
+
+bool MappedTape::HasFailed() const {
+  return has_failed_;
+}
+
+bool MappedTape::IsEmpty() const {
+  return is_empty_;
+}
+
+std::string MappedTape::GetErrorMessage() const {
+  return error_message_;
+}
+
+bool MappedTape::Initialize(char blank_character, const MappedTapeOptions
+    &options) {
+  blank_character_ = blank_character;
+#ifdef _WIN32
+  (void) options;
+  error_message_ = "Memory Mapped Tapes Are Not Supported On This Platform";
+  return false;
+#else
+  // a chunk is a whole number of pages so that it can be mapped from any
+  // offset of a file that is a multiple of its size
+  const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  chunk_shift_ = std::min(options.chunk_shift, kMaxChunkShift);
+  while ((static_cast<size_t>(1) << chunk_shift_) < kPageSize) {
+    chunk_shift_ += 1;
+  }
+  cell_mask_ = (static_cast<size_t>(1) << chunk_shift_) - 1;
+  max_resident_chunks_ = std::max<size_t>(options.max_resident_chunks, 1);
+  use_huge_pages_ = options.use_huge_pages;
+  failed_cells_.assign(cell_mask_ + 1, blank_character);
+
+  const char *kTemporaryDirectory = std::getenv("TMPDIR");
+  const std::string kScratchDirectory = !options.scratch_directory.empty()
+      ? options.scratch_directory : kTemporaryDirectory != nullptr
+      ? kTemporaryDirectory : "/tmp";
+  const std::string kScratchPathTemplate = kScratchDirectory
+      + "/turing-machine-tape-XXXXXX";
+  std::vector<char> scratch_path(kScratchPathTemplate.begin(),
+      kScratchPathTemplate.end());
+  scratch_path.push_back('\0');
+  scratch_file_ = mkstemp(scratch_path.data());
+  if (scratch_file_ < 0) {
+    error_message_ = "Could Not Create Scratch File";
+    return false;
+  }
+  // the scratch file only lives on through its descriptor, so it is deleted
+  // with the tape even if the program crashes
+  unlink(scratch_path.data());
+  return true;
+#endif
+}
+
+void MappedTape::EnterChunk(size_t chunk_index) {
+  ChunkSlot &current_chunk = chunks_[current_chunk_];
+  current_chunk.is_dirty = current_chunk.is_dirty
+      || is_current_chunk_written_;
+  is_current_chunk_written_ = false;
+  current_chunk_ = chunk_index;
+  if (chunks_[chunk_index].cells == nullptr && !MapChunk(chunk_index)) {
+    // the run cannot go on with cells that were never stored, so the
+    // scanner gets cells of its own and the tape is marked as failed
+    has_failed_ = true;
+    error_message_ = "Could Not Map Chunk Of Tape";
+    current_cells_ = failed_cells_.data();
+    return;
+  }
+  num_chunks_entered_ += 1;
+  chunks_[chunk_index].last_use = num_chunks_entered_;
+  current_cells_ = chunks_[chunk_index].cells;
+}
+
+bool MappedTape::MapChunk(size_t chunk_index) {
+  if (resident_chunks_.size() >= max_resident_chunks_) {
+    // the chunk of the scanner was entered last, so it is only unmapped if
+    // it is the only mapped chunk (and the scanner is leaving it)
+    size_t least_recently_used = 0;
+    for (size_t i = 1; i < resident_chunks_.size(); i++) {
+      if (chunks_[resident_chunks_[i]].last_use
+          < chunks_[resident_chunks_[least_recently_used]].last_use) {
+        least_recently_used = i;
+      }
+    }
+    UnmapChunk(resident_chunks_[least_recently_used]);
+    resident_chunks_.erase(resident_chunks_.begin() + least_recently_used);
+  }
+
+  ChunkSlot &chunk = chunks_[chunk_index];
+  const size_t kNumBytes = cell_mask_ + 1;
+  bool is_new = false;
+  if (chunk.input_offset >= 0) {
+    // the input file is mapped privately so that writes never reach it
+    chunk.cells = MapFile(input_file_, chunk.input_offset, kNumBytes, true);
+  } else {
+    if (chunk.scratch_index < 0) {
+      chunk.scratch_index = AddScratchChunk();
+      if (chunk.scratch_index < 0) {
+        return false;
+      }
+      is_new = true;
+    }
+    chunk.cells = MapFile(scratch_file_, chunk.scratch_index << chunk_shift_,
+        kNumBytes, false);
+  }
+  if (chunk.cells == nullptr) {
+    return false;
+  }
+  if (use_huge_pages_) {
+    AdviseHugePages(chunk.cells, kNumBytes);
+  }
+  if (is_new) {
+    std::memset(chunk.cells, blank_character_, kNumBytes);
+  }
+  chunk.is_dirty = false;
+  resident_chunks_.push_back(chunk_index);
+  return true;
+}
+
+void MappedTape::UnmapChunk(size_t chunk_index) {
+  ChunkSlot &chunk = chunks_[chunk_index];
+  const size_t kNumBytes = cell_mask_ + 1;
+  if (chunk.input_offset >= 0 && chunk.is_dirty) {
+    // changes to a private mapping are lost when it is unmapped, so a chunk
+    // of the input file that was written moves to the scratch file
+    const int64_t kScratchIndex = AddScratchChunk();
+    if (kScratchIndex < 0 || !WriteFile(scratch_file_, chunk.cells,
+        kNumBytes, kScratchIndex << chunk_shift_)) {
+      has_failed_ = true;
+      error_message_ = "Could Not Write To Scratch File";
+    } else {
+      chunk.scratch_index = kScratchIndex;
+      chunk.input_offset = -1;
+    }
+  }
+  UnmapFile(chunk.cells, kNumBytes);
+  chunk.cells = nullptr;
+  chunk.is_dirty = false;
+}
+
+int64_t MappedTape::AddScratchChunk() {
+#ifdef _WIN32
+  return -1;
+#else
+  // the file grows without writing its new bytes (which read as 0)
+  if (ftruncate(scratch_file_, static_cast<off_t>((num_scratch_chunks_ + 1)
+      << chunk_shift_)) != 0) {
+    return -1;
+  }
+  num_scratch_chunks_ += 1;
+  return num_scratch_chunks_ - 1;
+#endif
+}
+
+void MappedTape::ReadCells(size_t first_cell, size_t num_cells, char *cells)
+    const {
+  const ChunkSlot &kChunk = chunks_.at(first_cell >> chunk_shift_);
+  const size_t kOffsetInChunk = first_cell & cell_mask_;
+  if (first_cell >> chunk_shift_ == current_chunk_) {
+    // the chunk of the scanner may be the cells given to it after a failure
+    std::copy(current_cells_ + kOffsetInChunk, current_cells_
+        + kOffsetInChunk + num_cells, cells);
+  } else if (kChunk.cells != nullptr) {
+    std::copy(kChunk.cells + kOffsetInChunk, kChunk.cells + kOffsetInChunk
+        + num_cells, cells);
+  } else if (kChunk.input_offset >= 0) {
+    ReadFile(input_file_, cells, num_cells, kChunk.input_offset
+        + static_cast<int64_t>(kOffsetInChunk));
+  } else if (kChunk.scratch_index >= 0) {
+    ReadFile(scratch_file_, cells, num_cells, (kChunk.scratch_index
+        << chunk_shift_) + static_cast<int64_t>(kOffsetInChunk));
+  } else {
+    // a chunk that was never mapped is blank headroom
+    std::fill(cells, cells + num_cells, blank_character_);
+  }
+}
+
+void MappedTape::Release() {
+  for (size_t chunk_index : resident_chunks_) {
+    UnmapFile(chunks_[chunk_index].cells, cell_mask_ + 1);
+    chunks_[chunk_index].cells = nullptr;
+  }
+  resident_chunks_.clear();
+  chunks_.clear();
+  current_cells_ = nullptr;
+#ifndef _WIN32
+  if (scratch_file_ >= 0) {
+    close(scratch_file_);
+  }
+  if (input_file_ >= 0) {
+    close(input_file_);
+  }
+#endif
+  scratch_file_ = -1;
+  input_file_ = -1;
+  is_empty_ = true;
+}
+
+void MappedTape::GrowLeft() {
+  // the headroom is only empty chunk slots, which are not mapped or stored
+  // until the scanner reaches them
+  const size_t kHeadroom = std::max<size_t>(1, chunks_.size());
+  chunks_.insert(chunks_.begin(), kHeadroom, ChunkSlot());
+  for (size_t &chunk_index : resident_chunks_) {
+    chunk_index += kHeadroom;
+  }
+  current_chunk_ += kHeadroom;
+  begin_ += kHeadroom << chunk_shift_;
+  end_ += kHeadroom << chunk_shift_;
+  scanner_ += kHeadroom << chunk_shift_;
+  origin_ += static_cast<int64_t>(kHeadroom << chunk_shift_);
+}
+
+void MappedTape::GrowRight() {
+  const size_t kHeadroom = std::max<size_t>(1, chunks_.size());
+  chunks_.resize(chunks_.size() + kHeadroom);
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,151 @@
+#include "mapped_tape_machine.h"
+
+#include <utility>
+
+#include "configuration_formatter.h"
+
+namespace turingmachinesimulator {
+
+MappedTapeMachine::MappedTapeMachine(const TuringMachine &turing_machine,
+    const MappedTapeOptions &options) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty mapped tape machine if there is nothing to
+    // run
+    return;
+  }
+  tape_ = MappedTape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), turing_machine.GetIndexOfScanner(),
+      turing_machine.GetPositionOfScanner(), options);
+  Initialize(turing_machine);
+}
+
+MappedTapeMachine::MappedTapeMachine(const TuringMachine &turing_machine,
+    MappedTape &&tape)
+    : tape_(std::move(tape)) {
+  if (turing_machine.IsEmpty()) {
+    return;
+  }
+  Initialize(turing_machine);
+}
+
+RunResult MappedTapeMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult MappedTapeMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> MappedTapeMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+const MappedTape &MappedTapeMachine::GetMappedTape() const {
+  return tape_;
+}
+
+size_t MappedTapeMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+int64_t MappedTapeMachine::GetPositionOfScanner() const {
+  return tape_.GetPositionOfScanner();
+}
+
+State MappedTapeMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return program_->GetTransitionTable().GetState(current_state_index_);
+}
+
+uint64_t MappedTapeMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+bool MappedTapeMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool MappedTapeMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+std::string MappedTapeMachine::GetErrorMessage() const {
+  return tape_.GetErrorMessage();
+}
+
+std::string MappedTapeMachine::GetConfigurationForConsole() const {
+  if (is_empty_) {
+    return "";
+  }
+  return FormatConfigurationForConsole(tape_, GetCurrentState());
+}
+
+std::string MappedTapeMachine::GetConfigurationForMarkdown() const {
+  if (is_empty_) {
+    return "";
+  }
+  return FormatConfigurationForMarkdown(tape_, GetCurrentState());
+}
+
+bool MappedTapeMachine::Initialize(const TuringMachine &turing_machine) {
+  if (tape_.IsEmpty()) {
+    // the tape could not be created, its error message says why
+    return false;
+  }
+  program_ = turing_machine.GetProgram();
+  current_state_index_ = program_->GetTransitionTable().GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+  is_empty_ = false;
+  return true;
+}
+
+RunResult MappedTapeMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty mapped tape machine has nothing to run
+    return result;
+  }
+
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  size_t state_index = current_state_index_;
+  bool is_halted = is_halted_;
+  uint64_t num_steps_taken = 0;
+  // a tape that could not map the chunk of its scanner stops the run before
+  // the next step reads it
+  while (num_steps_taken < max_steps && !tape_.HasFailed()) {
+    if (stop_at_halting_state && is_halted) {
+      break;
+    }
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        state_index, tape_.Read());
+    if (!kTransition.is_defined) {
+      break;
+    }
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+    num_steps_taken += 1;
+  }
+  current_state_index_ = state_index;
+  is_halted_ = is_halted;
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = kTransitionTable.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = tape_.GetIndexOfScanner();
+  return result;
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,457 @@
+#include "memoized_segment_machine.h"
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * uint64_t storing how many times the scanner may cross between the halves of
+ * a segment (or how many steps it may take on a single cell) in 1 evaluation
+ * before the evaluation starts looking for a repeated configuration
+ */
+const uint64_t kCrossingsBeforeCycleDetection = 64;
+
+/**
+ * This function returns the key of a memoized result
+ *
+ * @param segment a uint32_t representing the id of the segment
+ * @param state a uint32_t representing the index of the state
+ * @param is_right_edge a bool that is true if the segment is entered from the
+ *     right
+ * @return a uint64_t representing the key
+ */
+uint64_t GetMemoKey(uint32_t segment, uint32_t state, bool is_right_edge) {
+  return (static_cast<uint64_t>(segment) << 32)
+      | (static_cast<uint64_t>(state) << 1) | (is_right_edge ? 1 : 0);
+}
+
+} // namespace
+
+const size_t MemoizedSegmentMachine::kDefaultMaxTableSize;
+
+MemoizedSegmentMachine::MemoizedSegmentMachine(const TuringMachine
+    &turing_machine) : MemoizedSegmentMachine(turing_machine,
+    kDefaultMaxTableSize) {
+}
+
+MemoizedSegmentMachine::MemoizedSegmentMachine(const TuringMachine
+    &turing_machine, size_t max_table_size)
+    : max_table_size_(std::max<size_t>(max_table_size, 1)),
+    max_segments_(max_table_size_) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty memoized segment machine if there is nothing
+    // to run
+    return;
+  }
+  transition_table_ = turing_machine.GetTransitionTable();
+  blank_character_ = turing_machine.GetBlankCharacter();
+  current_state_index_ = static_cast<uint32_t>(transition_table_.GetStateIndex(
+      turing_machine.GetCurrentState()));
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+
+  // build the tree of segments bottom up, padding the tape with blanks to a
+  // power of 2 cells
+  const std::vector<char> kTape = turing_machine.GetTape();
+  std::vector<uint32_t> level_segments;
+  for (char character : kTape) {
+    level_segments.push_back(MakeCell(character));
+  }
+  uint32_t level = 0;
+  while (level_segments.size() > 1) {
+    if (level_segments.size() % 2 == 1) {
+      level_segments.push_back(MakeBlankSegment(level));
+    }
+    std::vector<uint32_t> next_level_segments;
+    for (size_t i = 0; i < level_segments.size(); i += 2) {
+      next_level_segments.push_back(MakeSegment(level_segments[i],
+          level_segments[i + 1]));
+    }
+    level_segments = next_level_segments;
+    level += 1;
+  }
+  root_ = level_segments.front();
+  begin_ = 0;
+  end_ = static_cast<int64_t>(kTape.size());
+  scanner_ = static_cast<int64_t>(turing_machine.GetIndexOfScanner());
+  is_empty_ = false;
+}
+
+RunResult MemoizedSegmentMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult MemoizedSegmentMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> MemoizedSegmentMachine::GetTape() const {
+  std::vector<char> cells;
+  if (!is_empty_) {
+    CollectCells(root_, 0, begin_, end_, cells);
+  }
+  return cells;
+}
+
+size_t MemoizedSegmentMachine::GetIndexOfScanner() const {
+  return static_cast<size_t>(scanner_ - begin_);
+}
+
+State MemoizedSegmentMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return transition_table_.GetState(current_state_index_);
+}
+
+uint64_t MemoizedSegmentMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+bool MemoizedSegmentMachine::IsHalted() const {
+  return is_halted_;
+}
+
+size_t MemoizedSegmentMachine::GetNumberOfSegments() const {
+  return segments_.size();
+}
+
+size_t MemoizedSegmentMachine::GetNumberOfMemoizedResults() const {
+  return memoized_results_.size();
+}
+
+bool MemoizedSegmentMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult MemoizedSegmentMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty memoized segment machine has nothing to run
+    return result;
+  }
+
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted_) {
+      break;
+    }
+    if (segments_.size() >= max_segments_) {
+      CollectSegments();
+    }
+    const SegmentResult kSegmentResult = Evaluate(root_, current_state_index_,
+        scanner_, max_steps - num_steps_taken);
+    root_ = kSegmentResult.segment;
+    current_state_index_ = kSegmentResult.state;
+    num_steps_taken += kSegmentResult.num_steps;
+    scanner_ = kSegmentResult.scanner_offset;
+    begin_ = std::min(begin_, kSegmentResult.min_scanner_offset);
+    end_ = std::max(end_, kSegmentResult.max_scanner_offset + 1);
+    if (transition_table_.IsHaltingState(current_state_index_)) {
+      is_halted_ = true;
+    }
+
+    // the scanner may have left the root segment (it only ever moves 1 cell
+    // past its edge)
+    if (scanner_ < 0) {
+      GrowRoot(true);
+    } else if (scanner_ >= (static_cast<int64_t>(1)
+        << segments_[root_].level)) {
+      GrowRoot(false);
+    }
+    if (kSegmentResult.status == SegmentStatus::kStuck) {
+      break;
+    }
+  }
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = GetIndexOfScanner();
+  return result;
+}
+
+SegmentResult MemoizedSegmentMachine::Evaluate(uint32_t segment, uint32_t
+    state, int64_t scanner_offset, uint64_t step_budget) {
+  // NOTE: the segment is copied since creating segments may reallocate
+  // segments_
+  const TapeSegment kSegment = segments_[segment];
+  if (kSegment.level == 0) {
+    return EvaluateCell(segment, state, step_budget);
+  }
+  const int64_t kHalfSize = static_cast<int64_t>(1) << (kSegment.level - 1);
+  const int64_t kSize = 2 * kHalfSize;
+
+  // results are only memoized for segments entered from an edge, a memoized
+  // result can be used as long as it fits in the step budget
+  const bool kIsEnteredFromEdge = scanner_offset == 0
+      || scanner_offset == kSize - 1;
+  const uint64_t kMemoKey = GetMemoKey(segment, state, scanner_offset != 0);
+  if (kIsEnteredFromEdge) {
+    const std::unordered_map<uint64_t, SegmentResult>::const_iterator
+        kMemoizedResult = memoized_results_.find(kMemoKey);
+    if (kMemoizedResult != memoized_results_.end()
+        && kMemoizedResult->second.num_steps <= step_budget) {
+      return kMemoizedResult->second;
+    }
+  }
+
+  SegmentResult result;
+  uint32_t halves[2] = {kSegment.left, kSegment.right};
+  result.scanner_offset = scanner_offset;
+  result.min_scanner_offset = scanner_offset;
+  result.max_scanner_offset = scanner_offset;
+  result.state = state;
+
+  // the configurations seen each time the scanner crosses between the halves,
+  // used to fast-forward through cycles
+  uint64_t num_crossings = 0;
+  bool is_cycle_skipped = false;
+  std::map<std::pair<uint64_t, uint64_t>, uint64_t> steps_by_configuration;
+  while (true) {
+    const size_t kHalf = result.scanner_offset < kHalfSize ? 0 : 1;
+    const int64_t kHalfStart = static_cast<int64_t>(kHalf) * kHalfSize;
+    const SegmentResult kHalfResult = Evaluate(halves[kHalf], result.state,
+        result.scanner_offset - kHalfStart, step_budget - result.num_steps);
+    halves[kHalf] = kHalfResult.segment;
+    result.state = kHalfResult.state;
+    result.num_steps += kHalfResult.num_steps;
+    result.scanner_offset = kHalfStart + kHalfResult.scanner_offset;
+    result.min_scanner_offset = std::min(result.min_scanner_offset,
+        kHalfStart + kHalfResult.min_scanner_offset);
+    result.max_scanner_offset = std::max(result.max_scanner_offset,
+        kHalfStart + kHalfResult.max_scanner_offset);
+    if (kHalfResult.status != SegmentStatus::kExited) {
+      result.status = kHalfResult.status;
+      break;
+    }
+    if (result.scanner_offset < 0 || result.scanner_offset >= kSize) {
+      result.status = SegmentStatus::kExited;
+      break;
+    }
+
+    // the scanner crossed into the other half; if this configuration was seen
+    // before, the machine is in a cycle and whole periods can be skipped
+    num_crossings += 1;
+    if (num_crossings > kCrossingsBeforeCycleDetection && !is_cycle_skipped) {
+      const std::pair<uint64_t, uint64_t> kConfiguration(
+          (static_cast<uint64_t>(halves[0]) << 32) | halves[1],
+          (static_cast<uint64_t>(result.state) << 1)
+          | (result.scanner_offset < kHalfSize ? 0 : 1));
+      const std::map<std::pair<uint64_t, uint64_t>, uint64_t>::const_iterator
+          kSeenConfiguration = steps_by_configuration.find(kConfiguration);
+      if (kSeenConfiguration == steps_by_configuration.end()) {
+        steps_by_configuration[kConfiguration] = result.num_steps;
+      } else {
+        const uint64_t kPeriod = result.num_steps - kSeenConfiguration->second;
+        const uint64_t kRemainingSteps = step_budget - result.num_steps;
+        result.num_steps += (kRemainingSteps / kPeriod) * kPeriod;
+        is_cycle_skipped = true;
+        steps_by_configuration.clear();
+      }
+    }
+  }
+  result.segment = MakeSegment(halves[0], halves[1]);
+
+  // a result that did not run out of steps does not depend on the budget
+  if (kIsEnteredFromEdge && result.status != SegmentStatus::kOutOfSteps) {
+    MemoizeResult(kMemoKey, result);
+  }
+  return result;
+}
+
+SegmentResult MemoizedSegmentMachine::EvaluateCell(uint32_t segment, uint32_t
+    state, uint64_t step_budget) {
+  const uint64_t kMemoKey = GetMemoKey(segment, state, false);
+  const std::unordered_map<uint64_t, SegmentResult>::const_iterator
+      kMemoizedResult = memoized_results_.find(kMemoKey);
+  if (kMemoizedResult != memoized_results_.end()
+      && kMemoizedResult->second.num_steps <= step_budget) {
+    return kMemoizedResult->second;
+  }
+
+  SegmentResult result;
+  result.state = state;
+  if (segments_.size() >= max_segments_) {
+    // the segments can only be collected between evaluations of the root
+    // segment, so the evaluation stops early (as if it ran out of steps)
+    result.segment = segment;
+    return result;
+  }
+  char character = segments_[segment].character;
+  bool is_cycle_skipped = false;
+  std::map<std::pair<uint32_t, char>, uint64_t> steps_by_configuration;
+  while (true) {
+    if (result.num_steps == step_budget) {
+      result.status = SegmentStatus::kOutOfSteps;
+      break;
+    }
+    const Transition &kTransition = transition_table_.GetTransition(
+        result.state, character);
+    if (!kTransition.is_defined) {
+      result.status = SegmentStatus::kStuck;
+      break;
+    }
+    character = kTransition.write;
+    result.state = kTransition.state_to_move_to;
+    result.num_steps += 1;
+    result.scanner_offset = kTransition.scanner_offset;
+    result.min_scanner_offset = std::min<int64_t>(result.min_scanner_offset,
+        kTransition.scanner_offset);
+    result.max_scanner_offset = std::max<int64_t>(result.max_scanner_offset,
+        kTransition.scanner_offset);
+    if (transition_table_.IsHaltingState(result.state)) {
+      result.status = SegmentStatus::kHalted;
+      break;
+    }
+    if (kTransition.scanner_offset != 0) {
+      result.status = SegmentStatus::kExited;
+      break;
+    }
+
+    // directions that do not move the scanner may cycle on the cell forever
+    if (result.num_steps > kCrossingsBeforeCycleDetection
+        && !is_cycle_skipped) {
+      const std::pair<uint32_t, char> kConfiguration(result.state, character);
+      const std::map<std::pair<uint32_t, char>, uint64_t>::const_iterator
+          kSeenConfiguration = steps_by_configuration.find(kConfiguration);
+      if (kSeenConfiguration == steps_by_configuration.end()) {
+        steps_by_configuration[kConfiguration] = result.num_steps;
+      } else {
+        const uint64_t kPeriod = result.num_steps - kSeenConfiguration->second;
+        const uint64_t kRemainingSteps = step_budget - result.num_steps;
+        result.num_steps += (kRemainingSteps / kPeriod) * kPeriod;
+        is_cycle_skipped = true;
+      }
+    }
+  }
+  result.segment = MakeCell(character);
+
+  if (result.status != SegmentStatus::kOutOfSteps) {
+    MemoizeResult(kMemoKey, result);
+  }
+  return result;
+}
+
+void MemoizedSegmentMachine::MemoizeResult(uint64_t memo_key, const
+    SegmentResult &result) {
+  if (memoized_results_.size() >= max_table_size_) {
+    memoized_results_.clear();
+  }
+  memoized_results_[memo_key] = result;
+}
+
+uint32_t MemoizedSegmentMachine::MakeCell(char character) {
+  const std::map<char, uint32_t>::const_iterator kCellSegment =
+      cell_segment_ids_.find(character);
+  if (kCellSegment != cell_segment_ids_.end()) {
+    return kCellSegment->second;
+  }
+  TapeSegment cell_segment;
+  cell_segment.character = character;
+  const uint32_t kId = static_cast<uint32_t>(segments_.size());
+  segments_.push_back(cell_segment);
+  cell_segment_ids_[character] = kId;
+  return kId;
+}
+
+uint32_t MemoizedSegmentMachine::MakeSegment(uint32_t left, uint32_t right) {
+  const uint64_t kKey = (static_cast<uint64_t>(left) << 32) | right;
+  const std::unordered_map<uint64_t, uint32_t>::const_iterator kSegment =
+      segment_ids_.find(kKey);
+  if (kSegment != segment_ids_.end()) {
+    return kSegment->second;
+  }
+  TapeSegment new_segment;
+  new_segment.left = left;
+  new_segment.right = right;
+  new_segment.level = segments_[left].level + 1;
+  const uint32_t kId = static_cast<uint32_t>(segments_.size());
+  segments_.push_back(new_segment);
+  segment_ids_[kKey] = kId;
+  return kId;
+}
+
+uint32_t MemoizedSegmentMachine::MakeBlankSegment(uint32_t level) {
+  if (blank_segment_ids_.empty()) {
+    blank_segment_ids_.push_back(MakeCell(blank_character_));
+  }
+  while (blank_segment_ids_.size() <= level) {
+    const uint32_t kHalf = blank_segment_ids_.back();
+    blank_segment_ids_.push_back(MakeSegment(kHalf, kHalf));
+  }
+  return blank_segment_ids_[level];
+}
+
+void MemoizedSegmentMachine::GrowRoot(bool add_to_left) {
+  const uint32_t kLevel = segments_[root_].level;
+  const uint32_t kBlankSegment = MakeBlankSegment(kLevel);
+  if (add_to_left) {
+    root_ = MakeSegment(kBlankSegment, root_);
+    const int64_t kShift = static_cast<int64_t>(1) << kLevel;
+    begin_ += kShift;
+    end_ += kShift;
+    scanner_ += kShift;
+  } else {
+    root_ = MakeSegment(root_, kBlankSegment);
+  }
+}
+
+void MemoizedSegmentMachine::CollectSegments() {
+  // the memoized results and the ids of the segments refer to the old ids, so
+  // they are rebuilt from the segments of the tape
+  std::vector<TapeSegment> segments;
+  segments.swap(segments_);
+  cell_segment_ids_.clear();
+  segment_ids_.clear();
+  blank_segment_ids_.clear();
+  memoized_results_.clear();
+  std::unordered_map<uint32_t, uint32_t> new_segment_ids;
+  root_ = CopySegment(segments, root_, new_segment_ids);
+  // a tape that needs most of the segments is not collected again until it
+  // has doubled them
+  max_segments_ = std::max(max_table_size_, 2 * segments_.size());
+}
+
+uint32_t MemoizedSegmentMachine::CopySegment(const std::vector<TapeSegment>
+    &segments, uint32_t segment, std::unordered_map<uint32_t, uint32_t>
+    &new_segment_ids) {
+  const std::unordered_map<uint32_t, uint32_t>::const_iterator kNewSegment =
+      new_segment_ids.find(segment);
+  if (kNewSegment != new_segment_ids.end()) {
+    return kNewSegment->second;
+  }
+  const TapeSegment &kSegment = segments[segment];
+  uint32_t new_segment = 0;
+  if (kSegment.level == 0) {
+    new_segment = MakeCell(kSegment.character);
+  } else {
+    const uint32_t kLeft = CopySegment(segments, kSegment.left,
+        new_segment_ids);
+    const uint32_t kRight = CopySegment(segments, kSegment.right,
+        new_segment_ids);
+    new_segment = MakeSegment(kLeft, kRight);
+  }
+  new_segment_ids[segment] = new_segment;
+  return new_segment;
+}
+
+void MemoizedSegmentMachine::CollectCells(uint32_t segment, int64_t
+    segment_start, int64_t begin, int64_t end, std::vector<char> &cells) const {
+  const TapeSegment &kSegment = segments_[segment];
+  const int64_t kSize = static_cast<int64_t>(1) << kSegment.level;
+  if (segment_start >= end || segment_start + kSize <= begin) {
+    return;
+  }
+  if (kSegment.level == 0) {
+    cells.push_back(kSegment.character);
+    return;
+  }
+  CollectCells(kSegment.left, segment_start, begin, end, cells);
+  CollectCells(kSegment.right, segment_start + kSize / 2, begin, end, cells);
+}
+
+} // namespace turingmachinesimulator
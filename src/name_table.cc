@@ -0,0 +1,119 @@
+#include "name_table.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * Struct storing the interned names and lists of names
+ */
+struct Names {
+  Names() {
+    // id 0 is the empty name and the empty list of names
+    names.push_back("");
+    name_ids[""] = 0;
+    name_lists.push_back(std::vector<uint32_t>());
+    name_list_ids[std::vector<uint32_t>()] = 0;
+  }
+
+  /**
+   * the names are kept in a deque so adding a name never moves the others,
+   * which keeps the references returned by GetName valid
+   */
+  std::deque<std::string> names;
+  std::map<std::string, uint32_t> name_ids;
+
+  /**
+   * the lists of names are stored as sorted ids of names without repeats
+   */
+  std::vector<std::vector<uint32_t>> name_lists;
+  std::map<std::vector<uint32_t>, uint32_t> name_list_ids;
+
+  /**
+   * mutex guarding the table, states may be created on any thread
+   */
+  std::mutex mutex;
+};
+
+/**
+ * This function returns the table of names shared by every state
+ *
+ * @return a reference to the table of names
+ */
+Names &GetNames() {
+  static Names names;
+  return names;
+}
+
+/**
+ * This function returns the id of the given name, adding it to the table
+ * (the mutex of the table must already be locked)
+ */
+uint32_t InternNameLocked(Names &names, const std::string &name) {
+  const std::map<std::string, uint32_t>::const_iterator kIterator =
+      names.name_ids.find(name);
+  if (kIterator != names.name_ids.end()) {
+    return kIterator->second;
+  }
+  const uint32_t kNameId = static_cast<uint32_t>(names.names.size());
+  names.names.push_back(name);
+  names.name_ids[name] = kNameId;
+  return kNameId;
+}
+
+} // namespace
+
+uint32_t NameTable::InternName(const std::string &name) {
+  Names &names = GetNames();
+  std::lock_guard<std::mutex> lock(names.mutex);
+  return InternNameLocked(names, name);
+}
+
+const std::string &NameTable::GetName(uint32_t name_id) {
+  Names &names = GetNames();
+  std::lock_guard<std::mutex> lock(names.mutex);
+  if (name_id >= names.names.size()) {
+    // id 0 is the empty name
+    return names.names[0];
+  }
+  return names.names[name_id];
+}
+
+uint32_t NameTable::InternNameList(const std::vector<std::string> &names) {
+  Names &table = GetNames();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  std::vector<uint32_t> name_ids;
+  for (const std::string &kName : names) {
+    name_ids.push_back(InternNameLocked(table, kName));
+  }
+  std::sort(name_ids.begin(), name_ids.end());
+  name_ids.erase(std::unique(name_ids.begin(), name_ids.end()),
+      name_ids.end());
+
+  const std::map<std::vector<uint32_t>, uint32_t>::const_iterator kIterator =
+      table.name_list_ids.find(name_ids);
+  if (kIterator != table.name_list_ids.end()) {
+    return kIterator->second;
+  }
+  const uint32_t kNameListId = static_cast<uint32_t>(table.name_lists.size());
+  table.name_lists.push_back(name_ids);
+  table.name_list_ids[name_ids] = kNameListId;
+  return kNameListId;
+}
+
+bool NameTable::NameListContains(uint32_t name_list_id, uint32_t name_id) {
+  Names &names = GetNames();
+  std::lock_guard<std::mutex> lock(names.mutex);
+  if (name_list_id >= names.name_lists.size()) {
+    return false;
+  }
+  const std::vector<uint32_t> &kNameList = names.name_lists[name_list_id];
+  return std::binary_search(kNameList.begin(), kNameList.end(), name_id);
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,513 @@
+#include "native_machine.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * The statuses the compiled run function leaves in the context, these must
+ * match the numbers used in the generated C source
+ */
+const uint32_t kStatusOutOfSteps = 0;
+const uint32_t kStatusHalted = 1;
+const uint32_t kStatusStuck = 2;
+const uint32_t kStatusNeedsRoom = 3;
+
+/**
+ * size_t storing the smallest number of blank cells added to either side of
+ * the tape when it grows
+ */
+const size_t kMinimumHeadroom = 16;
+
+/**
+ * This function returns the 64 bit FNV-1a hash of the given string as 16 hex
+ * digits
+ *
+ * @param text a string to hash
+ * @return a string representing the hash
+ */
+std::string HashToHex(const std::string &text) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char character : text) {
+    hash ^= static_cast<unsigned char>(character);
+    hash *= 1099511628211ULL;
+  }
+  std::stringstream hash_stringstream;
+  hash_stringstream << std::hex;
+  hash_stringstream.width(16);
+  hash_stringstream.fill('0');
+  hash_stringstream << hash;
+  return hash_stringstream.str();
+}
+
+#ifndef _WIN32
+/**
+ * This function creates the given directory and any of its parents that do
+ * not exist, readable and writable only by the current user
+ *
+ * @param path a string representing the directory
+ * @return a bool that is true if the directory exists afterwards
+ */
+bool CreateDirectories(const std::string &path) {
+  for (size_t slash = path.find('/', 1); slash != std::string::npos;
+      slash = path.find('/', slash + 1)) {
+    mkdir(path.substr(0, slash).c_str(), 0700);
+  }
+  mkdir(path.c_str(), 0700);
+  struct stat path_stat;
+  return stat(path.c_str(), &path_stat) == 0 && S_ISDIR(path_stat.st_mode);
+}
+
+/**
+ * This function returns true if the given path is of the given type (it is
+ * not followed if it is a symbolic link), is owned by the current user, and
+ * cannot be written by anyone else
+ *
+ * @param path a string representing the path to check
+ * @param type a mode_t representing the file type (like S_IFDIR)
+ * @return a bool that is true if the path can be trusted
+ */
+bool IsPrivate(const std::string &path, mode_t type) {
+  struct stat path_stat;
+  return lstat(path.c_str(), &path_stat) == 0
+      && (path_stat.st_mode & S_IFMT) == type
+      && path_stat.st_uid == geteuid()
+      && (path_stat.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/**
+ * This function creates a new file from the given template (its last 6
+ * characters must be XXXXXX, which are replaced) and writes the given text to
+ * it; the file is never an existing file or a symbolic link
+ *
+ * @param path_template a string representing the template of the path
+ * @param text a string to write to the file
+ * @param path a string to store the path of the created file in
+ * @return a bool that is true if the file was created and written
+ */
+bool WriteNewFile(const std::string &path_template, const std::string &text,
+    std::string &path) {
+  std::vector<char> path_characters(path_template.begin(),
+      path_template.end());
+  path_characters.push_back('\0');
+  const int kFile = mkstemp(path_characters.data());
+  if (kFile < 0) {
+    return false;
+  }
+  path = path_characters.data();
+  size_t num_written = 0;
+  while (num_written < text.size()) {
+    const ssize_t kNumWritten = write(kFile, text.data() + num_written,
+        text.size() - num_written);
+    if (kNumWritten < 0 && errno != EINTR) {
+      break;
+    }
+    num_written += kNumWritten < 0 ? 0 : static_cast<size_t>(kNumWritten);
+  }
+  return close(kFile) == 0 && num_written == text.size();
+}
+
+/**
+ * This function runs the given command without a shell (the first word is
+ * looked up in the PATH), discarding its output, and waits for it to finish
+ *
+ * @param arguments a vector storing the words of the command
+ * @return a bool that is true if the command ran and exited with status 0
+ */
+bool RunCommand(const std::vector<std::string> &arguments) {
+  if (arguments.empty()) {
+    return false;
+  }
+  std::vector<char *> argv;
+  for (const std::string &kArgument : arguments) {
+    argv.push_back(const_cast<char *>(kArgument.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t file_actions;
+  if (posix_spawn_file_actions_init(&file_actions) != 0) {
+    return false;
+  }
+  posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, "/dev/null",
+      O_WRONLY, 0);
+  posix_spawn_file_actions_adddup2(&file_actions, STDOUT_FILENO,
+      STDERR_FILENO);
+  pid_t process = 0;
+  const int kSpawnError = posix_spawnp(&process, argv[0], &file_actions,
+      nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&file_actions);
+  if (kSpawnError != 0) {
+    return false;
+  }
+  int status = 0;
+  while (waitpid(process, &status, 0) < 0) {
+    if (errno != EINTR) {
+      return false;
+    }
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+#endif
+
+} // namespace
+
+NativeMachine::NativeMachine(const TuringMachine &turing_machine) {
+  const char *kCompilerFromEnvironment = std::getenv("CC");
+  const std::string kCompiler = kCompilerFromEnvironment != nullptr
+      ? kCompilerFromEnvironment : "cc";
+  // the cache is per user, since a shared directory would let other users
+  // plant machines to be loaded
+  const char *kCacheHome = std::getenv("XDG_CACHE_HOME");
+  const char *kHome = std::getenv("HOME");
+  std::string cache_directory;
+  if (kCacheHome != nullptr && kCacheHome[0] == '/') {
+    cache_directory = std::string(kCacheHome)
+        + "/turing-machine-simulator-native";
+  } else if (kHome != nullptr && kHome[0] == '/') {
+    cache_directory = std::string(kHome)
+        + "/.cache/turing-machine-simulator-native";
+  }
+  Initialize(turing_machine, kCompiler, cache_directory);
+}
+
+NativeMachine::NativeMachine(const TuringMachine &turing_machine, const
+    std::string &compiler, const std::string &cache_directory) {
+  Initialize(turing_machine, compiler, cache_directory);
+}
+
+RunResult NativeMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult NativeMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> NativeMachine::GetTape() const {
+  if (!is_compiled_) {
+    return execution_context_.GetTape();
+  }
+  return std::vector<char>(cells_.begin() + context_.begin,
+      cells_.begin() + context_.end);
+}
+
+size_t NativeMachine::GetIndexOfScanner() const {
+  if (!is_compiled_) {
+    return execution_context_.GetIndexOfScanner();
+  }
+  return context_.scanner - context_.begin;
+}
+
+State NativeMachine::GetCurrentState() const {
+  if (!is_compiled_) {
+    return execution_context_.GetCurrentState();
+  }
+  return execution_context_.GetProgram()->GetTransitionTable().GetState(
+      context_.state);
+}
+
+uint64_t NativeMachine::GetNumberOfSteps() const {
+  if (!is_compiled_) {
+    return execution_context_.GetNumberOfSteps();
+  }
+  return num_steps_;
+}
+
+bool NativeMachine::IsHalted() const {
+  if (!is_compiled_) {
+    return execution_context_.IsHalted();
+  }
+  return context_.is_halted != 0;
+}
+
+bool NativeMachine::IsCompiled() const {
+  return is_compiled_;
+}
+
+std::string NativeMachine::GetErrorMessage() const {
+  return error_message_;
+}
+
+std::string NativeMachine::GetSource() const {
+  return source_;
+}
+
+std::string NativeMachine::GetArtifactPath() const {
+  return artifact_path_;
+}
+
+bool NativeMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+void NativeMachine::Initialize(const TuringMachine &turing_machine, const
+    std::string &compiler, const std::string &cache_directory) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty native machine if there is nothing to run
+    return;
+  }
+  // the fallback runs the same program from the same configuration, but is
+  // not given the listeners of the turing machine
+  const Tape kFallbackTape = Tape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), turing_machine.GetIndexOfScanner(),
+      turing_machine.GetPositionOfScanner());
+  execution_context_ = ExecutionContext(turing_machine.GetProgram(),
+      kFallbackTape);
+  execution_context_.SetConfiguration(kFallbackTape, turing_machine
+      .GetTransitionTable().GetStateIndex(turing_machine.GetCurrentState()),
+      turing_machine.GetNumberOfSteps(), turing_machine.IsHalted());
+  is_empty_ = false;
+
+  // copy the configuration of the turing machine with headroom on both sides
+  // of the tape
+  const std::vector<char> kTape = turing_machine.GetTape();
+  blank_character_ = turing_machine.GetBlankCharacter();
+  cells_.assign(kMinimumHeadroom, blank_character_);
+  cells_.insert(cells_.end(), kTape.begin(), kTape.end());
+  cells_.insert(cells_.end(), kMinimumHeadroom, blank_character_);
+  context_.begin = kMinimumHeadroom;
+  context_.end = kMinimumHeadroom + kTape.size();
+  context_.scanner = kMinimumHeadroom + turing_machine.GetIndexOfScanner();
+  context_.state = static_cast<uint32_t>(turing_machine.GetTransitionTable()
+      .GetStateIndex(turing_machine.GetCurrentState()));
+  context_.is_halted = turing_machine.IsHalted() ? 1 : 0;
+  num_steps_ = turing_machine.GetNumberOfSteps();
+
+  source_ = GenerateSource(turing_machine);
+  CompileAndLoad(compiler, cache_directory);
+}
+
+std::string NativeMachine::GenerateSource(const TuringMachine
+    &turing_machine) const {
+  const TransitionTable &kTransitionTable =
+      turing_machine.GetTransitionTable();
+  const std::map<State, std::vector<Direction>> kDirectionsByStateMap =
+      turing_machine.GetDirectionsByStateMap();
+  std::stringstream source_stringstream;
+  source_stringstream << "#include <stddef.h>\n"
+      << "#include <stdint.h>\n\n"
+      << "struct context {\n"
+      << "  char *cells;\n"
+      << "  size_t capacity;\n"
+      << "  size_t begin;\n"
+      << "  size_t end;\n"
+      << "  size_t scanner;\n"
+      << "  uint32_t state;\n"
+      << "  uint32_t status;\n"
+      << "  int is_halted;\n"
+      << "  int stop_at_halting_state;\n"
+      << "};\n\n"
+      << "uint64_t run(struct context *c, uint64_t max_steps) {\n"
+      << "  char *cells = c->cells;\n"
+      << "  size_t capacity = c->capacity;\n"
+      << "  size_t begin = c->begin;\n"
+      << "  size_t end = c->end;\n"
+      << "  size_t s = c->scanner;\n"
+      << "  uint32_t state = c->state;\n"
+      << "  uint64_t n = 0;\n"
+      << "  switch (state) {\n";
+  const size_t kNumStates = kTransitionTable.GetNumberOfStates();
+  for (size_t i = 0; i < kNumStates; i++) {
+    source_stringstream << "    case " << i << ": goto s" << i << ";\n";
+  }
+  source_stringstream << "  }\n";
+
+  // each state checks the step budget and that the scanner has a cell on
+  // both sides, then jumps on the character being read
+  for (size_t i = 0; i < kNumStates; i++) {
+    source_stringstream << "s" << i << ":\n"
+        << "  if (n == max_steps) { state = " << i << "; c->status = "
+        << kStatusOutOfSteps << "; goto done; }\n"
+        << "  if (s == 0 || s + 1 == capacity) { state = " << i
+        << "; c->status = " << kStatusNeedsRoom << "; goto done; }\n"
+        << "  switch ((unsigned char) cells[s]) {\n";
+    const State &kState = kTransitionTable.GetState(i);
+    const std::map<State, std::vector<Direction>>::const_iterator
+        kStateDirections = kDirectionsByStateMap.find(kState);
+    if (kStateDirections != kDirectionsByStateMap.end()) {
+      for (const Direction &kDirection : kStateDirections->second) {
+        const size_t kStateToMoveTo = kTransitionTable.GetStateIndex(
+            kDirection.GetStateToMoveTo());
+        source_stringstream << "    case " << static_cast<int>(
+            static_cast<unsigned char>(kDirection.GetRead())) << ":\n"
+            << "      cells[s] = (char) " << static_cast<int>(
+            kDirection.GetWrite()) << ";\n";
+        if (kDirection.GetScannerMovement() == 'l') {
+          source_stringstream << "      s -= 1;\n"
+              << "      if (s < begin) begin = s;\n";
+        } else if (kDirection.GetScannerMovement() == 'r') {
+          source_stringstream << "      s += 1;\n"
+              << "      if (s >= end) end = s + 1;\n";
+        }
+        source_stringstream << "      n += 1;\n";
+        if (kTransitionTable.IsHaltingState(kStateToMoveTo)) {
+          source_stringstream << "      c->is_halted = 1;\n"
+              << "      if (c->stop_at_halting_state) { state = "
+              << kStateToMoveTo << "; c->status = " << kStatusHalted
+              << "; goto done; }\n";
+        }
+        source_stringstream << "      goto s" << kStateToMoveTo << ";\n";
+      }
+    }
+    source_stringstream << "    default: state = " << i << "; c->status = "
+        << kStatusStuck << "; goto done;\n"
+        << "  }\n";
+  }
+  source_stringstream << "done:\n"
+      << "  c->begin = begin;\n"
+      << "  c->end = end;\n"
+      << "  c->scanner = s;\n"
+      << "  c->state = state;\n"
+      << "  return n;\n"
+      << "}\n";
+  return source_stringstream.str();
+}
+
+void NativeMachine::CompileAndLoad(const std::string &compiler, const
+    std::string &cache_directory) {
+#ifdef _WIN32
+  (void) compiler;
+  (void) cache_directory;
+  error_message_ = "Native Compilation Is Not Supported On This Platform";
+#else
+  // the compiled machine is cached by a hash of its source and the compiler
+  const std::string kHash = HashToHex(compiler + '\n' + source_);
+  const std::string kBasePath = cache_directory + "/tm_" + kHash;
+  artifact_path_ = kBasePath + ".so";
+  if (cache_directory.empty() || !CreateDirectories(cache_directory)) {
+    error_message_ = "Could Not Create The Cache Directory";
+    return;
+  }
+  if (!IsPrivate(cache_directory, S_IFDIR)) {
+    error_message_ = "The Cache Directory Is Not Private";
+    return;
+  }
+
+  // a cached machine is only loaded if nobody else could have written it,
+  // otherwise it is compiled again and replaced
+  if (!IsPrivate(artifact_path_, S_IFREG)) {
+    std::string source_path;
+    if (!WriteNewFile(kBasePath + ".c.XXXXXX", source_, source_path)) {
+      std::remove(source_path.c_str());
+      error_message_ = "Could Not Write Source To The Cache Directory";
+      return;
+    }
+
+    // compile to a new file and then rename it, so other processes never
+    // load a partially written machine
+    std::string temporary_path;
+    if (!WriteNewFile(kBasePath + ".so.XXXXXX", "", temporary_path)) {
+      std::remove(source_path.c_str());
+      std::remove(temporary_path.c_str());
+      error_message_ = "Could Not Compile Machine";
+      return;
+    }
+    // the compiler may be a command with arguments (like CC="ccache cc"),
+    // which are split at whitespace; the paths are passed as they are, and
+    // the language is given since the source does not end in .c
+    std::vector<std::string> arguments;
+    std::stringstream compiler_stringstream(compiler);
+    std::string word;
+    while (compiler_stringstream >> word) {
+      arguments.push_back(word);
+    }
+    const std::vector<std::string> kFlags = {"-O2", "-shared", "-fPIC", "-o",
+        temporary_path, "-x", "c", source_path};
+    arguments.insert(arguments.end(), kFlags.begin(), kFlags.end());
+    const bool kIsCompiled = RunCommand(arguments)
+        && chmod(temporary_path.c_str(), 0700) == 0
+        && std::rename(temporary_path.c_str(), artifact_path_.c_str()) == 0;
+    std::remove(source_path.c_str());
+    if (!kIsCompiled) {
+      std::remove(temporary_path.c_str());
+      error_message_ = "Could Not Compile Machine";
+      return;
+    }
+  }
+
+  void *library = dlopen(artifact_path_.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (library == nullptr) {
+    error_message_ = "Could Not Load Compiled Machine";
+    return;
+  }
+  library_ = std::shared_ptr<void>(library, dlclose);
+  // NOTE: ISO C++ does not allow casting an object pointer to a function
+  // pointer directly, so the address is copied instead
+  void *run_symbol = dlsym(library, "run");
+  if (run_symbol == nullptr) {
+    error_message_ = "Could Not Load Compiled Machine";
+    return;
+  }
+  static_assert(sizeof(run_function_) == sizeof(run_symbol),
+      "function pointers must be the size of object pointers");
+  std::memcpy(&run_function_, &run_symbol, sizeof(run_symbol));
+  is_compiled_ = true;
+#endif
+}
+
+RunResult NativeMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  if (!is_compiled_) {
+    if (stop_at_halting_state) {
+      return execution_context_.RunUntilHalt(max_steps);
+    }
+    return execution_context_.Run(max_steps);
+  }
+
+  uint64_t num_steps_taken = 0;
+  context_.stop_at_halting_state = stop_at_halting_state ? 1 : 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && context_.is_halted) {
+      break;
+    }
+    context_.cells = cells_.data();
+    context_.capacity = cells_.size();
+    num_steps_taken += run_function_(&context_, max_steps - num_steps_taken);
+    context_.cells = nullptr;
+    if (context_.status == kStatusNeedsRoom) {
+      Grow();
+    } else if (context_.status == kStatusHalted
+        || context_.status == kStatusStuck) {
+      break;
+    }
+  }
+  num_steps_ += num_steps_taken;
+
+  RunResult result;
+  result.num_steps = num_steps_taken;
+  result.is_halted = context_.is_halted != 0;
+  result.final_state_id = GetCurrentState().GetId();
+  result.index_of_scanner = GetIndexOfScanner();
+  return result;
+}
+
+void NativeMachine::Grow() {
+  // doubling the headroom keeps the total cost of growing the tape linear in
+  // its final length
+  const size_t kHeadroom = std::max(kMinimumHeadroom, cells_.size());
+  cells_.insert(cells_.begin(), kHeadroom, blank_character_);
+  cells_.insert(cells_.end(), kHeadroom, blank_character_);
+  context_.begin += kHeadroom;
+  context_.end += kHeadroom;
+  context_.scanner += kHeadroom;
+}
+
+} // namespace turingmachinesimulator
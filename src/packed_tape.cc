@@ -0,0 +1,223 @@
+#include "packed_tape.h"
+
+#include <algorithm>
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * This method returns the number of zero bits below the lowest set bit of the
+ * given word
+ *
+ * @param word a nonzero uint64_t
+ * @return a size_t representing the number of trailing zero bits
+ */
+size_t CountTrailingZeroBits(uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctzll(word));
+#else
+  size_t num_zero_bits = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    num_zero_bits += 1;
+  }
+  return num_zero_bits;
+#endif
+}
+
+/**
+ * This method returns the number of zero bits above the highest set bit of
+ * the given word
+ *
+ * @param word a nonzero uint64_t
+ * @return a size_t representing the number of leading zero bits
+ */
+size_t CountLeadingZeroBits(uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_clzll(word));
+#else
+  const uint64_t kHighestBit = static_cast<uint64_t>(1) << 63;
+  size_t num_zero_bits = 0;
+  while ((word & kHighestBit) == 0) {
+    word <<= 1;
+    num_zero_bits += 1;
+  }
+  return num_zero_bits;
+#endif
+}
+
+/**
+ * size_t storing the least number of words of headroom added when the tape
+ * grows
+ */
+const size_t kMinimumHeadroomWords = 2;
+
+} // namespace
+
+PackedTape::PackedTape(const std::vector<char> &cells, char blank_character,
+    const std::vector<char> &alphabet) {
+  // the blank character is code 0, so headroom of zero words is blank
+  std::array<bool, 256> is_in_alphabet = {};
+  std::vector<char> characters = {blank_character};
+  characters.insert(characters.end(), alphabet.begin(), alphabet.end());
+  characters.insert(characters.end(), cells.begin(), cells.end());
+  for (char character : characters) {
+    const unsigned char kIndex = static_cast<unsigned char>(character);
+    if (!is_in_alphabet[kIndex]) {
+      is_in_alphabet[kIndex] = true;
+      code_by_character_[kIndex] = static_cast<uint8_t>(alphabet_.size());
+      alphabet_.push_back(character);
+    }
+  }
+
+  // cells never straddle words, so only widths dividing 64 are used
+  if (alphabet_.size() <= 2) {
+    bits_per_cell_ = 1;
+  } else if (alphabet_.size() <= 4) {
+    bits_per_cell_ = 2;
+  } else if (alphabet_.size() <= 16) {
+    bits_per_cell_ = 4;
+  } else {
+    bits_per_cell_ = 8;
+  }
+  cells_per_word_ = 64 / bits_per_cell_;
+  cells_per_word_shift_ = 0;
+  while ((static_cast<size_t>(1) << cells_per_word_shift_) < cells_per_word_) {
+    cells_per_word_shift_ += 1;
+  }
+  cell_mask_ = (static_cast<uint64_t>(1) << bits_per_cell_) - 1;
+
+  // if the given tape is empty, set it to 1 blank character (same thing as
+  // an empty tape)
+  const size_t kNumCells = std::max(cells.size(), static_cast<size_t>(1));
+  words_.assign((kNumCells + cells_per_word_ - 1) >> cells_per_word_shift_, 0);
+  for (size_t i = 0; i < cells.size(); i++) {
+    scanner_ = i;
+    Write(GetCode(cells[i]));
+  }
+  begin_ = 0;
+  end_ = kNumCells;
+  scanner_ = 0;
+  origin_ = 0;
+}
+
+uint64_t PackedTape::SkipRight(uint8_t code, uint64_t max_cells) {
+  if (words_.empty()) {
+    return 0;
+  }
+  // the last cell is left to a normal step, which grows the tape if needed
+  const size_t kLimit = scanner_ + static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(end_ - 1 - scanner_)));
+  // every cell of the pattern holds the code
+  const uint64_t kPattern = (~static_cast<uint64_t>(0) / cell_mask_) * code;
+  size_t index = scanner_;
+  while (index < kLimit) {
+    // the bits of the word that differ from the pattern, starting at index
+    const uint64_t kDifference = (words_[index >> cells_per_word_shift_]
+        ^ kPattern) >> GetShiftOfCell(index);
+    if (kDifference != 0) {
+      index += CountTrailingZeroBits(kDifference) / bits_per_cell_;
+      break;
+    }
+    index += cells_per_word_ - (index & (cells_per_word_ - 1));
+  }
+  index = std::min(index, kLimit);
+  const uint64_t kNumCellsSkipped = index - scanner_;
+  scanner_ = index;
+  return kNumCellsSkipped;
+}
+
+uint64_t PackedTape::SkipLeft(uint8_t code, uint64_t max_cells) {
+  if (words_.empty()) {
+    return 0;
+  }
+  // the first cell is left to a normal step, which grows the tape if needed
+  const size_t kLimit = scanner_ - static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(scanner_ - begin_)));
+  const uint64_t kPattern = (~static_cast<uint64_t>(0) / cell_mask_) * code;
+  size_t index = scanner_;
+  while (index > kLimit) {
+    // the bits of the word that differ from the pattern, ending at index
+    const size_t kShift = 64 - bits_per_cell_ - GetShiftOfCell(index);
+    const uint64_t kDifference = (words_[index >> cells_per_word_shift_]
+        ^ kPattern) << kShift;
+    if (kDifference != 0) {
+      index -= std::min(index - kLimit, CountLeadingZeroBits(kDifference)
+          / bits_per_cell_);
+      break;
+    }
+    const size_t kNumCellsToStartOfWord = (index & (cells_per_word_ - 1)) + 1;
+    if (kNumCellsToStartOfWord >= index - kLimit) {
+      index = kLimit;
+      break;
+    }
+    index -= kNumCellsToStartOfWord;
+  }
+  const uint64_t kNumCellsSkipped = scanner_ - index;
+  scanner_ = index;
+  return kNumCellsSkipped;
+}
+
+const std::vector<char> &PackedTape::GetAlphabet() const {
+  return alphabet_;
+}
+
+size_t PackedTape::GetBitsPerCell() const {
+  return bits_per_cell_;
+}
+
+std::vector<char> PackedTape::GetCells() const {
+  std::vector<char> cells;
+  cells.reserve(end_ - begin_);
+  for (size_t i = begin_; i < end_; i++) {
+    cells.push_back(alphabet_[GetCodeAt(i)]);
+  }
+  return cells;
+}
+
+char PackedTape::GetCell(size_t index) const {
+  return alphabet_.at(GetCodeAt(begin_ + index));
+}
+
+size_t PackedTape::GetSize() const {
+  return end_ - begin_;
+}
+
+size_t PackedTape::GetIndexOfScanner() const {
+  return scanner_ - begin_;
+}
+
+int64_t PackedTape::GetPositionOfScanner() const {
+  return static_cast<int64_t>(scanner_) - origin_;
+}
+
+char PackedTape::GetBlankCharacter() const {
+  if (alphabet_.empty()) {
+    return 0;
+  }
+  return alphabet_[0];
+}
+
+size_t PackedTape::GetNumberOfBytes() const {
+  return words_.size() * sizeof(uint64_t);
+}
+
+void PackedTape::GrowLeft() {
+  const size_t kHeadroomWords = std::max(kMinimumHeadroomWords,
+      words_.size());
+  words_.insert(words_.begin(), kHeadroomWords, 0);
+  const size_t kHeadroomCells = kHeadroomWords << cells_per_word_shift_;
+  begin_ += kHeadroomCells;
+  end_ += kHeadroomCells;
+  scanner_ += kHeadroomCells;
+  origin_ += static_cast<int64_t>(kHeadroomCells);
+}
+
+void PackedTape::GrowRight() {
+  const size_t kHeadroomWords = std::max(kMinimumHeadroomWords,
+      words_.size());
+  words_.resize(words_.size() + kHeadroomWords, 0);
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,163 @@
+#include "packed_tape_machine.h"
+
+#include <utility>
+
+namespace turingmachinesimulator {
+
+PackedTapeMachine::PackedTapeMachine(const TuringMachine &turing_machine) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty packed tape machine if there is nothing to run
+    return;
+  }
+  transition_table_ = turing_machine.GetTransitionTable();
+  const size_t kNumStates = transition_table_.GetNumberOfStates();
+  const std::vector<char> &kReadCharacters = transition_table_
+      .GetReadCharacters();
+
+  // the alphabet is every character read or written by a direction
+  std::vector<char> alphabet = kReadCharacters;
+  for (size_t i = 0; i < kNumStates; i++) {
+    for (char read : kReadCharacters) {
+      const Transition &kTransition = transition_table_.GetTransition(i, read);
+      if (kTransition.is_defined) {
+        alphabet.push_back(kTransition.write);
+      }
+    }
+  }
+  tape_ = PackedTape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), alphabet);
+  for (size_t i = 0; i < turing_machine.GetIndexOfScanner(); i++) {
+    tape_.MoveRight();
+  }
+
+  // characters that no direction reads (only possible on the starting tape)
+  // keep transitions that are not defined
+  alphabet_size_ = tape_.GetAlphabet().size();
+  transitions_.resize(kNumStates * alphabet_size_);
+  for (size_t i = 0; i < kNumStates; i++) {
+    for (char read : kReadCharacters) {
+      const Transition &kTransition = transition_table_.GetTransition(i, read);
+      if (!kTransition.is_defined) {
+        continue;
+      }
+      const uint8_t kCode = tape_.GetCode(read);
+      PackedTransition &packed_transition = transitions_[i * alphabet_size_
+          + kCode];
+      packed_transition.state_to_move_to = kTransition.state_to_move_to;
+      packed_transition.write = tape_.GetCode(kTransition.write);
+      packed_transition.scanner_offset = kTransition.scanner_offset;
+      packed_transition.is_defined = true;
+      // halting states are never swept so that RunUntilHalt stops after the
+      // step into them
+      packed_transition.is_sweep = packed_transition.write == kCode
+          && kTransition.scanner_offset != 0
+          && kTransition.state_to_move_to == i
+          && !transition_table_.IsHaltingState(i);
+    }
+  }
+
+  current_state_index_ = static_cast<uint32_t>(transition_table_
+      .GetStateIndex(turing_machine.GetCurrentState()));
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+  is_empty_ = false;
+}
+
+RunResult PackedTapeMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult PackedTapeMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> PackedTapeMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+const PackedTape &PackedTapeMachine::GetPackedTape() const {
+  return tape_;
+}
+
+size_t PackedTapeMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+State PackedTapeMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return transition_table_.GetState(current_state_index_);
+}
+
+uint64_t PackedTapeMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+bool PackedTapeMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool PackedTapeMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult PackedTapeMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty packed tape machine has nothing to run
+    return result;
+  }
+
+  // the tape, state, and step count are kept in locals during the loop so the
+  // compiler can keep them in registers
+  PackedTape tape = std::move(tape_);
+  const PackedTransition *transitions = transitions_.data();
+  uint32_t state_index = current_state_index_;
+  bool is_halted = is_halted_;
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted) {
+      break;
+    }
+    const uint8_t kRead = tape.Read();
+    const PackedTransition &kTransition = transitions[state_index
+        * alphabet_size_ + kRead];
+    if (!kTransition.is_defined) {
+      break;
+    }
+    if (kTransition.is_sweep) {
+      // each skipped cell is 1 step that changes nothing but the scanner
+      const uint64_t kNumCellsSkipped = kTransition.scanner_offset > 0
+          ? tape.SkipRight(kRead, max_steps - num_steps_taken)
+          : tape.SkipLeft(kRead, max_steps - num_steps_taken);
+      if (kNumCellsSkipped > 0) {
+        num_steps_taken += kNumCellsSkipped;
+        continue;
+      }
+    }
+    tape.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    is_halted = is_halted || transition_table_.IsHaltingState(state_index);
+    num_steps_taken += 1;
+  }
+  tape_ = std::move(tape);
+  current_state_index_ = state_index;
+  is_halted_ = is_halted;
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = tape_.GetIndexOfScanner();
+  return result;
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,95 @@
+#include "program.h"
+
+namespace turingmachinesimulator {
+
+Program::Program(const std::vector<State> &states, const
+    std::vector<Direction> &directions, const std::vector<std::string>
+    &halting_state_names) {
+  // set starting and halting states
+  for (const State &kState : states) {
+    const std::string kNameOfStartingState = "q1";
+    const std::string kStateName = kState.GetStateName();
+    if (kStateName == kNameOfStartingState) {
+      if (!starting_state_.IsEmpty()) {
+        error_message_ = "Cannot Have More Than 1 Starting State";
+        return;
+      } else {
+        // the machine starts in the starting state
+        starting_state_ = kState;
+      }
+    } else if (std::find(halting_state_names.begin(), halting_state_names.end(),
+        kStateName) != halting_state_names.end()) {
+      halting_states_.push_back(kState);
+    }
+  }
+  if (starting_state_.IsEmpty()) {
+    error_message_ = "Must Have Starting State";
+    return;
+  }
+
+  // put directions into the directions by state map
+  for (const Direction &kDirection : directions) {
+    const State kStateToMoveFrom = kDirection.GetStateToMoveFrom();
+    const std::vector<Direction> &kStateDirections =
+        directions_by_state_map_[kStateToMoveFrom];
+    if (std::find(kStateDirections.begin(), kStateDirections.end(), kDirection)
+        != kStateDirections.end()) {
+      error_message_ = "Must Not Have 2 Directions With Same Read Condition "
+          "From The Same State";
+      return;
+    }
+    directions_by_state_map_[kStateToMoveFrom].push_back(kDirection);
+  }
+
+  // compile the directions into the transition table, this is only done once
+  // the directions are known to be valid
+  transition_table_ = TransitionTable(states, directions, halting_state_names);
+  starting_state_index_ = transition_table_.GetStateIndex(starting_state_);
+
+  // if no errors were encountered in initializing the program, then it is not
+  // empty
+  is_empty_ = false;
+}
+
+Program::Program(const Program &program, const std::vector<size_t>
+    &state_order)
+    : Program(program) {
+  if (is_empty_) {
+    return;
+  }
+  const State kStartingState = transition_table_.GetState(
+      starting_state_index_);
+  transition_table_.ReorderStates(state_order);
+  starting_state_index_ = transition_table_.GetStateIndex(kStartingState);
+}
+
+const std::vector<State> &Program::GetHaltingStates() const {
+  return halting_states_;
+}
+
+const std::map<State, std::vector<Direction>>
+    &Program::GetDirectionsByStateMap() const {
+  return directions_by_state_map_;
+}
+
+const TransitionTable &Program::GetTransitionTable() const {
+  return transition_table_;
+}
+
+size_t Program::GetStartingStateIndex() const {
+  return starting_state_index_;
+}
+
+State Program::GetStartingState() const {
+  return starting_state_;
+}
+
+std::string Program::GetErrorMessage() const {
+  return error_message_;
+}
+
+bool Program::IsEmpty() const {
+  return is_empty_;
+}
+
+} // namespace turingmachinesimulator
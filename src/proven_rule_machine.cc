@@ -0,0 +1,890 @@
+#include "proven_rule_machine.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * Signed integer type wide enough for the closed forms of rule applications
+ */
+#if defined(__GNUC__)
+__extension__ typedef __int128 WideInteger;
+#else
+typedef int64_t WideInteger;
+#endif
+
+/**
+ * size_t storing the most runs a tape may have for its shape to be recorded
+ */
+const size_t kMaxRunsInShape = 64;
+
+/**
+ * size_t storing the most shapes whose run lengths are remembered at once
+ */
+const size_t kMaxShapes = 4096;
+
+/**
+ * uint64_t storing the most iterations 1 application of a rule may take
+ */
+const uint64_t kMaxIterationsInRule = 4096;
+
+/**
+ * uint64_t storing the number of iterations shapes are taken for at a time,
+ * long enough to see any shape a rule can be proven for twice
+ */
+const uint64_t kShapeWindow = 2 * kMaxIterationsInRule;
+
+/**
+ * uint64_t storing the most iterations run on symbolic run lengths to prove
+ * rules in 1 window of shapes; a window that has run that many ends early
+ */
+const uint64_t kMaxProofIterationsPerWindow = 8 * kMaxIterationsInRule;
+
+/**
+ * uint64_t storing the most iterations shapes are skipped for at a time
+ */
+const uint64_t kMaxShapeSkip = static_cast<uint64_t>(1) << 24;
+
+/**
+ * size_t storing the most failed attempts to prove a rule for 1 shape
+ */
+const size_t kMaxFailedProofs = 4;
+
+/**
+ * size_t storing the most rules proven for 1 shape
+ */
+const size_t kMaxRulesPerShape = 16;
+
+/**
+ * uint64_t storing the most times a rule is applied at once (which keeps the
+ * closed forms well inside 128 bits)
+ */
+const uint64_t kMaxApplicationsAtOnce = static_cast<uint64_t>(1) << 40;
+
+/**
+ * uint64_t storing the longest run a rule application may make
+ */
+const uint64_t kMaxRunLength = static_cast<uint64_t>(1) << 62;
+
+/**
+ * Struct representing a run whose length is a linear expression
+ */
+struct SymbolicRun {
+  /**
+   * char storing the character of every cell of the run
+   */
+  char character = 0;
+
+  /**
+   * LinearExpression storing the number of cells in the run
+   */
+  LinearExpression num_cells;
+};
+
+/**
+ * Struct representing the configuration of a machine running on symbolic run
+ * lengths while a rule is being proven
+ */
+struct RuleProof {
+  /**
+   * pointer to the TransitionTable of the machine
+   */
+  const TransitionTable *transition_table = nullptr;
+
+  /**
+   * char storing the blank character of the tape
+   */
+  char blank_character = 0;
+
+  /**
+   * vectors storing the runs to either side of the scanner (the backs are
+   * next to the scanner, like RunLengthTape)
+   */
+  std::vector<SymbolicRun> left_runs;
+  std::vector<SymbolicRun> right_runs;
+
+  /**
+   * char storing the character the scanner is reading
+   */
+  char scanned_character = 0;
+
+  /**
+   * size_t storing the index (in the transition table) of the current state
+   */
+  size_t state_index = 0;
+
+  /**
+   * vector storing the value of each variable in the configuration the proof
+   * started from
+   */
+  std::vector<uint64_t> value_by_variable;
+
+  /**
+   * vector storing the smallest value of each variable the proof holds for
+   */
+  std::vector<uint64_t> minimum_by_variable;
+
+  /**
+   * LinearExpressions storing the number of steps taken and how far the
+   * scanner moved
+   */
+  LinearExpression num_steps;
+  LinearExpression scanner_offset;
+};
+
+/**
+ * This method returns a linear expression that is the given constant
+ *
+ * @param constant an int64_t representing the value of the expression
+ * @param num_variables a size_t representing the number of variables
+ * @return a LinearExpression representing the constant
+ */
+LinearExpression MakeConstant(int64_t constant, size_t num_variables) {
+  LinearExpression expression;
+  expression.constant = constant;
+  expression.coefficients.assign(num_variables, 0);
+  return expression;
+}
+
+/**
+ * This method adds the given multiple of an expression to a sum
+ *
+ * @param sum a LinearExpression to add to
+ * @param term a LinearExpression to add
+ * @param multiple an int64_t representing how many times to add the term
+ */
+void AddMultiple(LinearExpression &sum, const LinearExpression &term, int64_t
+    multiple) {
+  sum.constant += term.constant * multiple;
+  for (size_t i = 0; i < sum.coefficients.size(); i++) {
+    sum.coefficients[i] += term.coefficients[i] * multiple;
+  }
+}
+
+/**
+ * This method returns true if the given expression depends on a variable
+ *
+ * @param expression a LinearExpression
+ * @return a bool that is true if a coefficient is not 0
+ */
+bool HasVariables(const LinearExpression &expression) {
+  for (int64_t coefficient : expression.coefficients) {
+    if (coefficient != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * This method makes sure the given run length is at least the given number
+ * for every value of the variables the proof holds for, raising the minimum
+ * of its variable if the configuration the proof started from allows it
+ * NOTE: run lengths only ever add variables with positive coefficients
+ *
+ * @param proof a RuleProof
+ * @param num_cells a LinearExpression representing a run length
+ * @param least an int64_t representing the least the run length may be
+ * @return a bool that is false if the run length cannot be made that long
+ */
+bool EnsureAtLeast(RuleProof &proof, const LinearExpression &num_cells,
+    int64_t least) {
+  WideInteger smallest_value = num_cells.constant;
+  size_t num_variables = 0;
+  size_t variable = 0;
+  for (size_t i = 0; i < num_cells.coefficients.size(); i++) {
+    if (num_cells.coefficients[i] != 0) {
+      smallest_value += static_cast<WideInteger>(num_cells.coefficients[i])
+          * proof.minimum_by_variable[i];
+      num_variables += 1;
+      variable = i;
+    }
+  }
+  if (smallest_value >= least) {
+    return true;
+  }
+  if (num_variables != 1) {
+    return false;
+  }
+  const int64_t kCoefficient = num_cells.coefficients[variable];
+  const WideInteger kMinimum = (least - num_cells.constant + kCoefficient - 1)
+      / kCoefficient;
+  if (kMinimum > proof.value_by_variable[variable]) {
+    return false;
+  }
+  proof.minimum_by_variable[variable] = static_cast<uint64_t>(kMinimum);
+  return true;
+}
+
+/**
+ * This method adds cells of the given character next to the scanner
+ *
+ * @param runs a vector of SymbolicRuns to add the cells to
+ * @param character a char representing the character of the cells
+ * @param num_cells a LinearExpression representing the number of cells
+ */
+void AddCells(std::vector<SymbolicRun> &runs, char character, const
+    LinearExpression &num_cells) {
+  if (!runs.empty() && runs.back().character == character) {
+    AddMultiple(runs.back().num_cells, num_cells, 1);
+    return;
+  }
+  SymbolicRun run;
+  run.character = character;
+  run.num_cells = num_cells;
+  runs.push_back(run);
+}
+
+/**
+ * This method takes the cell next to the scanner from the given runs
+ *
+ * @param proof a RuleProof
+ * @param runs a vector of SymbolicRuns to take the cell from
+ * @param character a char to store the character of the cell in
+ * @return a bool that is false if whether the run runs out depends on the
+ *     variables
+ */
+bool TakeCell(RuleProof &proof, std::vector<SymbolicRun> &runs, char
+    &character) {
+  if (runs.empty()) {
+    // the tape grows by a blank cell
+    character = proof.blank_character;
+    return true;
+  }
+  SymbolicRun &run = runs.back();
+  character = run.character;
+  if (!HasVariables(run.num_cells)) {
+    run.num_cells.constant -= 1;
+    if (run.num_cells.constant == 0) {
+      runs.pop_back();
+    }
+    return true;
+  }
+  // a run whose length depends on the variables must not run out, since what
+  // comes after it would then depend on them too
+  if (!EnsureAtLeast(proof, run.num_cells, 2)) {
+    return false;
+  }
+  run.num_cells.constant -= 1;
+  return true;
+}
+
+/**
+ * This method takes 1 iteration (a step or a chain step, exactly as
+ * ProvenRuleMachine does) on the symbolic runs
+ *
+ * @param proof a RuleProof
+ * @return a bool that is false if the iteration depends on the variables,
+ *     has no direction, or enters a halting state
+ */
+bool RunIteration(RuleProof &proof) {
+  const TransitionTable &kTransitionTable = *proof.transition_table;
+  const Transition &kTransition = kTransitionTable.GetTransition(
+      proof.state_index, proof.scanned_character);
+  if (!kTransition.is_defined) {
+    return false;
+  }
+  const size_t kNumVariables = proof.value_by_variable.size();
+  std::vector<SymbolicRun> &runs_ahead = kTransition.scanner_offset > 0
+      ? proof.right_runs : proof.left_runs;
+  std::vector<SymbolicRun> &runs_behind = kTransition.scanner_offset > 0
+      ? proof.left_runs : proof.right_runs;
+  const int64_t kDirection = kTransition.scanner_offset > 0 ? 1 : -1;
+
+  if (kTransition.state_to_move_to == proof.state_index
+      && kTransition.scanner_offset != 0
+      && !kTransitionTable.IsHaltingState(proof.state_index)) {
+    // a chain across blanks to the end of the tape never ends
+    const bool kReachesEndOfTape = runs_ahead.empty() || (runs_ahead.size()
+        == 1 && runs_ahead.back().character == proof.scanned_character);
+    if (proof.scanned_character == proof.blank_character
+        && kReachesEndOfTape) {
+      return false;
+    }
+    LinearExpression num_cells = MakeConstant(1, kNumVariables);
+    if (!runs_ahead.empty() && runs_ahead.back().character
+        == proof.scanned_character) {
+      AddMultiple(num_cells, runs_ahead.back().num_cells, 1);
+      runs_ahead.pop_back();
+    }
+    AddCells(runs_behind, kTransition.write, num_cells);
+    AddMultiple(proof.num_steps, num_cells, 1);
+    AddMultiple(proof.scanner_offset, num_cells, kDirection);
+    return TakeCell(proof, runs_ahead, proof.scanned_character);
+  }
+
+  if (kTransition.scanner_offset == 0) {
+    proof.scanned_character = kTransition.write;
+  } else {
+    AddCells(runs_behind, kTransition.write, MakeConstant(1, kNumVariables));
+    if (!TakeCell(proof, runs_ahead, proof.scanned_character)) {
+      return false;
+    }
+    proof.scanner_offset.constant += kDirection;
+  }
+  // rules never halt the machine, so RunUntilHalt stops at the right step
+  if (kTransitionTable.IsHaltingState(kTransition.state_to_move_to)) {
+    return false;
+  }
+  proof.state_index = kTransition.state_to_move_to;
+  proof.num_steps.constant += 1;
+  return true;
+}
+
+/**
+ * This method makes the symbolic runs for the given runs, giving each run
+ * whose length changed since the given earlier lengths a new variable
+ *
+ * @param runs a vector of TapeRuns
+ * @param earlier_num_cells a vector of uint64_ts representing the earlier
+ *     lengths of the runs
+ * @param proof a RuleProof to add the variables to
+ * @param variable_by_run a vector to store the variable of each run in (-1
+ *     for runs whose lengths did not change)
+ * @return a bool that is false if a run is too long for a rule
+ */
+bool AddVariables(const std::vector<TapeRun> &runs, const
+    std::vector<uint64_t> &earlier_num_cells, RuleProof &proof,
+    std::vector<int> &variable_by_run) {
+  variable_by_run.clear();
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (runs[i].num_cells >= kMaxRunLength) {
+      return false;
+    }
+    if (runs[i].num_cells == earlier_num_cells[i]) {
+      variable_by_run.push_back(-1);
+    } else {
+      variable_by_run.push_back(static_cast<int>(
+          proof.value_by_variable.size()));
+      proof.value_by_variable.push_back(runs[i].num_cells);
+    }
+  }
+  return true;
+}
+
+/**
+ * This method makes the symbolic runs for the given runs
+ *
+ * @param runs a vector of TapeRuns
+ * @param variable_by_run a vector storing the variable of each run (-1 for
+ *     runs whose lengths are constants)
+ * @param num_variables a size_t representing the number of variables
+ * @return a vector of SymbolicRuns representing the runs
+ */
+std::vector<SymbolicRun> MakeSymbolicRuns(const std::vector<TapeRun> &runs,
+    const std::vector<int> &variable_by_run, size_t num_variables) {
+  std::vector<SymbolicRun> symbolic_runs;
+  for (size_t i = 0; i < runs.size(); i++) {
+    SymbolicRun run;
+    run.character = runs[i].character;
+    if (variable_by_run[i] < 0) {
+      run.num_cells = MakeConstant(static_cast<int64_t>(runs[i].num_cells),
+          num_variables);
+    } else {
+      run.num_cells = MakeConstant(0, num_variables);
+      run.num_cells.coefficients[static_cast<size_t>(variable_by_run[i])] = 1;
+    }
+    symbolic_runs.push_back(run);
+  }
+  return symbolic_runs;
+}
+
+/**
+ * This method checks that the runs a proof ended with have the shape of the
+ * runs it started with, with each variable changed by a constant
+ *
+ * @param proof a RuleProof
+ * @param runs a vector of TapeRuns the proof started from
+ * @param symbolic_runs a vector of SymbolicRuns the proof ended with
+ * @param variable_by_run a vector storing the variable of each run
+ * @param change_by_variable a vector to store the change of each variable in
+ * @return a bool that is true if the runs match
+ */
+bool MatchRuns(RuleProof &proof, const std::vector<TapeRun> &runs, const
+    std::vector<SymbolicRun> &symbolic_runs, const std::vector<int>
+    &variable_by_run, std::vector<int64_t> &change_by_variable) {
+  if (runs.size() != symbolic_runs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < runs.size(); i++) {
+    const LinearExpression &kNumCells = symbolic_runs[i].num_cells;
+    if (symbolic_runs[i].character != runs[i].character) {
+      return false;
+    }
+    if (variable_by_run[i] < 0) {
+      if (HasVariables(kNumCells) || kNumCells.constant
+          != static_cast<int64_t>(runs[i].num_cells)) {
+        return false;
+      }
+      continue;
+    }
+    const size_t kVariable = static_cast<size_t>(variable_by_run[i]);
+    for (size_t j = 0; j < kNumCells.coefficients.size(); j++) {
+      if (kNumCells.coefficients[j] != (j == kVariable ? 1 : 0)) {
+        return false;
+      }
+    }
+    if (!EnsureAtLeast(proof, kNumCells, 1)) {
+      return false;
+    }
+    change_by_variable[kVariable] = kNumCells.constant;
+  }
+  return true;
+}
+
+/**
+ * This method returns the sum of the given expression over n applications of
+ * a rule, in closed form
+ *
+ * @param expression a LinearExpression in the variables of the rule
+ * @param value_by_variable a vector storing the values of the variables at
+ *     the start of the first application
+ * @param change_by_variable a vector storing the change of each variable per
+ *     application
+ * @param num_applications a uint64_t representing n
+ * @return a WideInteger representing the sum
+ */
+WideInteger SumOverApplications(const LinearExpression &expression, const
+    std::vector<uint64_t> &value_by_variable, const std::vector<int64_t>
+    &change_by_variable, uint64_t num_applications) {
+  const WideInteger kNumApplications = num_applications;
+  // the i-th application (from 0) sees value + i * change, and the changes
+  // add up to change * n * (n - 1) / 2
+  const WideInteger kNumPairs = kNumApplications * (kNumApplications - 1)
+      / 2;
+  WideInteger sum = kNumApplications * expression.constant;
+  for (size_t i = 0; i < expression.coefficients.size(); i++) {
+    sum += static_cast<WideInteger>(expression.coefficients[i])
+        * (kNumApplications * value_by_variable[i] + kNumPairs
+        * change_by_variable[i]);
+  }
+  return sum;
+}
+
+} // namespace
+
+std::string StepCountToString(StepCount step_count) {
+  if (step_count == 0) {
+    return "0";
+  }
+  std::string digits;
+  while (step_count > 0) {
+    digits += static_cast<char>('0' + static_cast<int>(step_count % 10));
+    step_count /= 10;
+  }
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
+
+ProvenRuleMachine::ProvenRuleMachine(const TuringMachine &turing_machine) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty proven rule machine if there is nothing to
+    // run
+    return;
+  }
+  transition_table_ = turing_machine.GetTransitionTable();
+  tape_ = RunLengthTape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), turing_machine.GetIndexOfScanner());
+  current_state_index_ = transition_table_.GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  position_of_scanner_ = turing_machine.GetPositionOfScanner();
+  is_halted_ = turing_machine.IsHalted();
+  shape_window_end_ = kShapeWindow;
+  is_empty_ = false;
+}
+
+RunResult ProvenRuleMachine::Run(uint64_t max_steps) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty proven rule machine has nothing to run
+    return result;
+  }
+  result.num_steps = static_cast<uint64_t>(RunSteps(max_steps, false));
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = static_cast<size_t>(tape_.GetIndexOfScanner());
+  return result;
+}
+
+RunResult ProvenRuleMachine::RunUntilHalt(uint64_t step_budget) {
+  RunResult result;
+  if (is_empty_) {
+    return result;
+  }
+  result.num_steps = static_cast<uint64_t>(RunSteps(step_budget, true));
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = static_cast<size_t>(tape_.GetIndexOfScanner());
+  return result;
+}
+
+std::vector<char> ProvenRuleMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+const RunLengthTape &ProvenRuleMachine::GetRunLengthTape() const {
+  return tape_;
+}
+
+uint64_t ProvenRuleMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+int64_t ProvenRuleMachine::GetPositionOfScanner() const {
+  return position_of_scanner_;
+}
+
+State ProvenRuleMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return transition_table_.GetState(current_state_index_);
+}
+
+StepCount ProvenRuleMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+size_t ProvenRuleMachine::GetNumberOfProvenRules() const {
+  return num_proven_rules_;
+}
+
+uint64_t ProvenRuleMachine::GetNumberOfRuleApplications() const {
+  return num_rule_applications_;
+}
+
+bool ProvenRuleMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool ProvenRuleMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+StepCount ProvenRuleMachine::RunSteps(StepCount max_steps, bool
+    stop_at_halting_state) {
+  StepCount num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted_) {
+      break;
+    }
+
+    // rules are only proven and applied before the machine halts
+    if (!is_halted_ && IsTakingShapes() && tape_.GetNumberOfRuns()
+        <= kMaxRunsInShape) {
+      UpdateShape();
+      const ProvenRule *rule = FindRule(shape_);
+      if (rule == nullptr) {
+        rule = LearnRule(shape_);
+      }
+      if (rule != nullptr) {
+        const StepCount kNumRuleSteps = ApplyRule(*rule, max_steps
+            - num_steps_taken);
+        if (kNumRuleSteps > 0) {
+          num_steps_taken += kNumRuleSteps;
+          continue;
+        }
+      }
+    }
+
+    const Transition &kTransition = transition_table_.GetTransition(
+        current_state_index_, tape_.Read());
+    if (!kTransition.is_defined) {
+      break;
+    }
+    num_iterations_ += 1;
+
+    // the same chain steps as RunLengthMachine
+    if (kTransition.state_to_move_to == current_state_index_
+        && kTransition.scanner_offset != 0
+        && !transition_table_.IsHaltingState(current_state_index_)) {
+      const uint64_t kMaxCells = static_cast<uint64_t>(std::min<StepCount>(
+          max_steps - num_steps_taken, std::numeric_limits<uint64_t>::max()));
+      if (kTransition.scanner_offset > 0) {
+        const uint64_t kNumCells = tape_.ChainRight(kTransition.write,
+            kMaxCells);
+        position_of_scanner_ += static_cast<int64_t>(kNumCells);
+        num_steps_taken += kNumCells;
+      } else {
+        const uint64_t kNumCells = tape_.ChainLeft(kTransition.write,
+            kMaxCells);
+        position_of_scanner_ -= static_cast<int64_t>(kNumCells);
+        num_steps_taken += kNumCells;
+      }
+      continue;
+    }
+
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+      position_of_scanner_ -= 1;
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+      position_of_scanner_ += 1;
+    }
+    current_state_index_ = kTransition.state_to_move_to;
+    is_halted_ = is_halted_ || transition_table_.IsHaltingState(
+        current_state_index_);
+    num_steps_taken += 1;
+  }
+  num_steps_ += num_steps_taken;
+  return num_steps_taken;
+}
+
+bool ProvenRuleMachine::IsTakingShapes() {
+  if (num_iterations_ >= shape_window_end_ || num_proof_iterations_in_window_
+      > kMaxProofIterationsPerWindow) {
+    // a window that applied no rule doubles the iterations skipped before
+    // the next 1, so machines that never count pay for few shapes
+    if (num_rule_applications_ == num_rule_applications_at_window_start_) {
+      num_iterations_skipped_ = std::min(kMaxShapeSkip, std::max(kShapeWindow,
+          2 * num_iterations_skipped_));
+      // lengths seen before the skip are too far back to prove a rule from
+      run_lengths_by_shape_.clear();
+    } else {
+      num_iterations_skipped_ = 0;
+    }
+    shape_window_start_ = num_iterations_ + num_iterations_skipped_;
+    shape_window_end_ = shape_window_start_ + kShapeWindow;
+    num_rule_applications_at_window_start_ = num_rule_applications_;
+    num_proof_iterations_in_window_ = 0;
+  }
+  return num_iterations_ >= shape_window_start_;
+}
+
+void ProvenRuleMachine::UpdateShape() {
+  // the number of left runs separates the left runs from the right runs; it
+  // is at most kMaxRunsInShape, so 1 byte holds it
+  const uint32_t kStateIndex = static_cast<uint32_t>(current_state_index_);
+  shape_.assign(reinterpret_cast<const char *>(&kStateIndex),
+      sizeof(kStateIndex));
+  shape_ += static_cast<char>(tape_.GetLeftRuns().size());
+  shape_ += tape_.Read();
+  for (const TapeRun &kRun : tape_.GetLeftRuns()) {
+    shape_ += kRun.character;
+  }
+  for (const TapeRun &kRun : tape_.GetRightRuns()) {
+    shape_ += kRun.character;
+  }
+}
+
+const ProvenRule *ProvenRuleMachine::FindRule(const std::string &shape)
+    const {
+  std::unordered_map<std::string, std::vector<ProvenRule>>::const_iterator
+      rules =
+      rules_by_shape_.find(shape);
+  if (rules == rules_by_shape_.end()) {
+    return nullptr;
+  }
+  const std::vector<TapeRun> &kLeftRuns = tape_.GetLeftRuns();
+  const std::vector<TapeRun> &kRightRuns = tape_.GetRightRuns();
+  for (const ProvenRule &kRule : rules->second) {
+    bool is_match = true;
+    for (size_t i = 0; i < kLeftRuns.size() && is_match; i++) {
+      is_match = kRule.variable_by_left_run[i] >= 0
+          || kRule.num_cells_by_left_run[i] == kLeftRuns[i].num_cells;
+    }
+    for (size_t i = 0; i < kRightRuns.size() && is_match; i++) {
+      is_match = kRule.variable_by_right_run[i] >= 0
+          || kRule.num_cells_by_right_run[i] == kRightRuns[i].num_cells;
+    }
+    if (is_match) {
+      return &kRule;
+    }
+  }
+  return nullptr;
+}
+
+const ProvenRule *ProvenRuleMachine::LearnRule(const std::string &shape) {
+  std::unordered_map<std::string, RunLengths>::iterator run_lengths_of_shape =
+      run_lengths_by_shape_.find(shape);
+  const bool kIsNewShape = run_lengths_of_shape == run_lengths_by_shape_.end();
+  if (kIsNewShape) {
+    if (run_lengths_by_shape_.size() >= kMaxShapes) {
+      run_lengths_by_shape_.clear();
+    }
+    run_lengths_of_shape = run_lengths_by_shape_.insert(std::make_pair(shape,
+        RunLengths())).first;
+  }
+  RunLengths &run_lengths = run_lengths_of_shape->second;
+
+  const ProvenRule *rule = nullptr;
+  if (!kIsNewShape && run_lengths.num_failed_proofs < kMaxFailedProofs) {
+    std::vector<ProvenRule> &rules = rules_by_shape_[shape];
+    num_proof_iterations_in_window_ += num_iterations_ - run_lengths.iteration;
+    ProvenRule new_rule;
+    if (rules.size() < kMaxRulesPerShape && ProveRule(run_lengths,
+        new_rule)) {
+      rules.push_back(new_rule);
+      num_proven_rules_ += 1;
+      rule = &rules.back();
+    } else {
+      run_lengths.num_failed_proofs += 1;
+    }
+  }
+
+  run_lengths.iteration = num_iterations_;
+  run_lengths.num_cells_by_left_run.clear();
+  for (const TapeRun &kRun : tape_.GetLeftRuns()) {
+    run_lengths.num_cells_by_left_run.push_back(kRun.num_cells);
+  }
+  run_lengths.num_cells_by_right_run.clear();
+  for (const TapeRun &kRun : tape_.GetRightRuns()) {
+    run_lengths.num_cells_by_right_run.push_back(kRun.num_cells);
+  }
+  return rule;
+}
+
+bool ProvenRuleMachine::ProveRule(const RunLengths &earlier_run_lengths,
+    ProvenRule &rule) const {
+  const uint64_t kNumIterations = num_iterations_
+      - earlier_run_lengths.iteration;
+  if (kNumIterations == 0 || kNumIterations > kMaxIterationsInRule) {
+    return false;
+  }
+
+  // the runs whose lengths changed since the shape was last seen become the
+  // variables, and the iterations in between are run again on them
+  RuleProof proof;
+  proof.transition_table = &transition_table_;
+  proof.blank_character = tape_.GetBlankCharacter();
+  if (!AddVariables(tape_.GetLeftRuns(),
+      earlier_run_lengths.num_cells_by_left_run, proof,
+      rule.variable_by_left_run) || !AddVariables(tape_.GetRightRuns(),
+      earlier_run_lengths.num_cells_by_right_run, proof,
+      rule.variable_by_right_run)) {
+    return false;
+  }
+  const size_t kNumVariables = proof.value_by_variable.size();
+  proof.left_runs = MakeSymbolicRuns(tape_.GetLeftRuns(),
+      rule.variable_by_left_run, kNumVariables);
+  proof.right_runs = MakeSymbolicRuns(tape_.GetRightRuns(),
+      rule.variable_by_right_run, kNumVariables);
+  proof.scanned_character = tape_.Read();
+  proof.state_index = current_state_index_;
+  proof.minimum_by_variable.assign(kNumVariables, 1);
+  proof.num_steps = MakeConstant(0, kNumVariables);
+  proof.scanner_offset = MakeConstant(0, kNumVariables);
+  for (uint64_t i = 0; i < kNumIterations; i++) {
+    if (!RunIteration(proof)) {
+      return false;
+    }
+  }
+
+  if (proof.state_index != current_state_index_
+      || proof.scanned_character != tape_.Read()) {
+    return false;
+  }
+  rule.change_by_variable.assign(kNumVariables, 0);
+  if (!MatchRuns(proof, tape_.GetLeftRuns(), proof.left_runs,
+      rule.variable_by_left_run, rule.change_by_variable)
+      || !MatchRuns(proof, tape_.GetRightRuns(), proof.right_runs,
+      rule.variable_by_right_run, rule.change_by_variable)) {
+    return false;
+  }
+  rule.num_cells_by_left_run.clear();
+  for (const TapeRun &kRun : tape_.GetLeftRuns()) {
+    rule.num_cells_by_left_run.push_back(kRun.num_cells);
+  }
+  rule.num_cells_by_right_run.clear();
+  for (const TapeRun &kRun : tape_.GetRightRuns()) {
+    rule.num_cells_by_right_run.push_back(kRun.num_cells);
+  }
+  rule.minimum_by_variable = proof.minimum_by_variable;
+  rule.num_steps = proof.num_steps;
+  rule.scanner_offset = proof.scanner_offset;
+  rule.num_iterations = kNumIterations;
+  return true;
+}
+
+StepCount ProvenRuleMachine::ApplyRule(const ProvenRule &rule, StepCount
+    max_steps) {
+  const std::vector<TapeRun> &kLeftRuns = tape_.GetLeftRuns();
+  const std::vector<TapeRun> &kRightRuns = tape_.GetRightRuns();
+  std::vector<uint64_t> value_by_variable(rule.minimum_by_variable.size());
+  for (size_t i = 0; i < kLeftRuns.size(); i++) {
+    if (rule.variable_by_left_run[i] >= 0) {
+      value_by_variable[static_cast<size_t>(rule.variable_by_left_run[i])] =
+          kLeftRuns[i].num_cells;
+    }
+  }
+  for (size_t i = 0; i < kRightRuns.size(); i++) {
+    if (rule.variable_by_right_run[i] >= 0) {
+      value_by_variable[static_cast<size_t>(rule.variable_by_right_run[i])] =
+          kRightRuns[i].num_cells;
+    }
+  }
+
+  // a variable that shrinks limits the number of applications to the ones
+  // that start with it at least its minimum
+  uint64_t max_applications = kMaxApplicationsAtOnce;
+  for (size_t i = 0; i < value_by_variable.size(); i++) {
+    const uint64_t kValue = value_by_variable[i];
+    const int64_t kChange = rule.change_by_variable[i];
+    if (kValue < rule.minimum_by_variable[i] || kValue >= kMaxRunLength) {
+      return 0;
+    }
+    if (kChange < 0) {
+      max_applications = std::min(max_applications, (kValue
+          - rule.minimum_by_variable[i]) / static_cast<uint64_t>(-kChange)
+          + 1);
+    } else if (kChange > 0) {
+      max_applications = std::min(max_applications, (kMaxRunLength - kValue)
+          / static_cast<uint64_t>(kChange));
+    }
+  }
+
+  // every application takes at least 1 step, so the number of steps grows
+  // with the number of applications
+  const WideInteger kMaxSteps = static_cast<WideInteger>(std::min<StepCount>(
+      max_steps, ~static_cast<StepCount>(0) >> 1));
+  uint64_t num_applications = 0;
+  while (num_applications < max_applications) {
+    const uint64_t kMiddle = max_applications - (max_applications
+        - num_applications) / 2;
+    if (SumOverApplications(rule.num_steps, value_by_variable,
+        rule.change_by_variable, kMiddle) <= kMaxSteps) {
+      num_applications = kMiddle;
+    } else {
+      max_applications = kMiddle - 1;
+    }
+  }
+  if (num_applications == 0) {
+    return 0;
+  }
+
+  std::vector<uint64_t> num_cells_by_left_run;
+  for (size_t i = 0; i < kLeftRuns.size(); i++) {
+    const int kVariable = rule.variable_by_left_run[i];
+    num_cells_by_left_run.push_back(kVariable < 0 ? kLeftRuns[i].num_cells
+        : static_cast<uint64_t>(kLeftRuns[i].num_cells + static_cast<int64_t>(
+        num_applications) * rule.change_by_variable[static_cast<size_t>(
+        kVariable)]));
+  }
+  std::vector<uint64_t> num_cells_by_right_run;
+  for (size_t i = 0; i < kRightRuns.size(); i++) {
+    const int kVariable = rule.variable_by_right_run[i];
+    num_cells_by_right_run.push_back(kVariable < 0 ? kRightRuns[i].num_cells
+        : static_cast<uint64_t>(kRightRuns[i].num_cells + static_cast<int64_t>(
+        num_applications) * rule.change_by_variable[static_cast<size_t>(
+        kVariable)]));
+  }
+  const StepCount kNumSteps = static_cast<StepCount>(SumOverApplications(
+      rule.num_steps, value_by_variable, rule.change_by_variable,
+      num_applications));
+  position_of_scanner_ += static_cast<int64_t>(SumOverApplications(
+      rule.scanner_offset, value_by_variable, rule.change_by_variable,
+      num_applications));
+  tape_.SetNumbersOfCells(num_cells_by_left_run, num_cells_by_right_run);
+  num_iterations_ += num_applications * rule.num_iterations;
+  num_rule_applications_ += num_applications;
+  return kNumSteps;
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,116 @@
+#include "run_length_machine.h"
+
+namespace turingmachinesimulator {
+
+RunLengthMachine::RunLengthMachine(const TuringMachine &turing_machine) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty run length machine if there is nothing to run
+    return;
+  }
+  transition_table_ = turing_machine.GetTransitionTable();
+  tape_ = RunLengthTape(turing_machine.GetTape(),
+      turing_machine.GetBlankCharacter(), turing_machine.GetIndexOfScanner());
+  current_state_index_ = transition_table_.GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+  is_empty_ = false;
+}
+
+RunResult RunLengthMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult RunLengthMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> RunLengthMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+const RunLengthTape &RunLengthMachine::GetRunLengthTape() const {
+  return tape_;
+}
+
+uint64_t RunLengthMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+State RunLengthMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return transition_table_.GetState(current_state_index_);
+}
+
+uint64_t RunLengthMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+uint64_t RunLengthMachine::GetNumberOfChainSteps() const {
+  return num_chain_steps_;
+}
+
+bool RunLengthMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool RunLengthMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult RunLengthMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty run length machine has nothing to run
+    return result;
+  }
+
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted_) {
+      break;
+    }
+    const Transition &kTransition = transition_table_.GetTransition(
+        current_state_index_, tape_.Read());
+    if (!kTransition.is_defined) {
+      break;
+    }
+
+    // a direction that loops on its state applies to every cell of the run
+    // being read; halting states are never chained so that RunUntilHalt
+    // stops after the step into them
+    if (kTransition.state_to_move_to == current_state_index_
+        && kTransition.scanner_offset != 0
+        && !transition_table_.IsHaltingState(current_state_index_)) {
+      num_steps_taken += kTransition.scanner_offset > 0
+          ? tape_.ChainRight(kTransition.write, max_steps - num_steps_taken)
+          : tape_.ChainLeft(kTransition.write, max_steps - num_steps_taken);
+      num_chain_steps_ += 1;
+      continue;
+    }
+
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+    }
+    current_state_index_ = kTransition.state_to_move_to;
+    is_halted_ = is_halted_ || transition_table_.IsHaltingState(
+        current_state_index_);
+    num_steps_taken += 1;
+  }
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = transition_table_.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = static_cast<size_t>(tape_.GetIndexOfScanner());
+  return result;
+}
+
+} // namespace turingmachinesimulator
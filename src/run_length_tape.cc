@@ -0,0 +1,189 @@
+#include "run_length_tape.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace turingmachinesimulator {
+
+RunLengthTape::RunLengthTape(const std::vector<char> &cells, char
+    blank_character, size_t index_of_scanner)
+    : blank_character_(blank_character) {
+  // if the given tape is empty, set it to 1 blank character (same thing as
+  // an empty tape)
+  const std::vector<char> kCells = cells.empty()
+      ? std::vector<char>{blank_character} : cells;
+  const size_t kIndexOfScanner = std::min(index_of_scanner, kCells.size()
+      - 1);
+  for (size_t i = 0; i < kIndexOfScanner; i++) {
+    AddCells(left_runs_, kCells[i], 1);
+  }
+  for (size_t i = kCells.size() - 1; i > kIndexOfScanner; i--) {
+    AddCells(right_runs_, kCells[i], 1);
+  }
+  scanned_character_ = kCells[kIndexOfScanner];
+  num_cells_left_of_scanner_ = kIndexOfScanner;
+  num_cells_right_of_scanner_ = kCells.size() - 1 - kIndexOfScanner;
+  is_empty_ = false;
+}
+
+void RunLengthTape::MoveLeft() {
+  AddCells(right_runs_, scanned_character_, 1);
+  num_cells_right_of_scanner_ += 1;
+  scanned_character_ = TakeCell(left_runs_);
+  if (num_cells_left_of_scanner_ > 0) {
+    num_cells_left_of_scanner_ -= 1;
+  }
+}
+
+void RunLengthTape::MoveRight() {
+  AddCells(left_runs_, scanned_character_, 1);
+  num_cells_left_of_scanner_ += 1;
+  scanned_character_ = TakeCell(right_runs_);
+  if (num_cells_right_of_scanner_ > 0) {
+    num_cells_right_of_scanner_ -= 1;
+  }
+}
+
+uint64_t RunLengthTape::ChainRight(char character, uint64_t max_cells) {
+  // the run is the cell being read and the cells of the same character to
+  // its right
+  const uint64_t kLengthOfTopRun = GetLengthOfTopRun(right_runs_,
+      scanned_character_);
+  const uint64_t kNumCellsTaken = kLengthOfTopRun
+      == std::numeric_limits<uint64_t>::max() ? max_cells
+      : std::min(max_cells, kLengthOfTopRun + 1);
+  AddCells(left_runs_, character, kNumCellsTaken);
+  num_cells_left_of_scanner_ += kNumCellsTaken;
+  TakeCells(right_runs_, kNumCellsTaken - 1);
+  scanned_character_ = TakeCell(right_runs_);
+  num_cells_right_of_scanner_ -= std::min(num_cells_right_of_scanner_,
+      kNumCellsTaken);
+  return kNumCellsTaken;
+}
+
+uint64_t RunLengthTape::ChainLeft(char character, uint64_t max_cells) {
+  const uint64_t kLengthOfTopRun = GetLengthOfTopRun(left_runs_,
+      scanned_character_);
+  const uint64_t kNumCellsTaken = kLengthOfTopRun
+      == std::numeric_limits<uint64_t>::max() ? max_cells
+      : std::min(max_cells, kLengthOfTopRun + 1);
+  AddCells(right_runs_, character, kNumCellsTaken);
+  num_cells_right_of_scanner_ += kNumCellsTaken;
+  TakeCells(left_runs_, kNumCellsTaken - 1);
+  scanned_character_ = TakeCell(left_runs_);
+  num_cells_left_of_scanner_ -= std::min(num_cells_left_of_scanner_,
+      kNumCellsTaken);
+  return kNumCellsTaken;
+}
+
+std::vector<char> RunLengthTape::GetCells() const {
+  std::vector<char> cells;
+  if (is_empty_) {
+    return cells;
+  }
+  for (const TapeRun &kRun : left_runs_) {
+    cells.insert(cells.end(), kRun.num_cells, kRun.character);
+  }
+  cells.push_back(scanned_character_);
+  for (std::vector<TapeRun>::const_reverse_iterator run =
+      right_runs_.rbegin(); run != right_runs_.rend(); ++run) {
+    cells.insert(cells.end(), run->num_cells, run->character);
+  }
+  return cells;
+}
+
+uint64_t RunLengthTape::GetSize() const {
+  if (is_empty_) {
+    return 0;
+  }
+  return num_cells_left_of_scanner_ + 1 + num_cells_right_of_scanner_;
+}
+
+uint64_t RunLengthTape::GetIndexOfScanner() const {
+  return num_cells_left_of_scanner_;
+}
+
+size_t RunLengthTape::GetNumberOfRuns() const {
+  return left_runs_.size() + right_runs_.size();
+}
+
+const std::vector<TapeRun> &RunLengthTape::GetLeftRuns() const {
+  return left_runs_;
+}
+
+const std::vector<TapeRun> &RunLengthTape::GetRightRuns() const {
+  return right_runs_;
+}
+
+void RunLengthTape::SetNumbersOfCells(const std::vector<uint64_t>
+    &num_cells_by_left_run, const std::vector<uint64_t>
+    &num_cells_by_right_run) {
+  // the runs hold every cell between the scanner and the ends of the tape, so
+  // the ends move with them
+  num_cells_left_of_scanner_ = 0;
+  for (size_t i = 0; i < left_runs_.size(); i++) {
+    left_runs_[i].num_cells = num_cells_by_left_run.at(i);
+    num_cells_left_of_scanner_ += left_runs_[i].num_cells;
+  }
+  num_cells_right_of_scanner_ = 0;
+  for (size_t i = 0; i < right_runs_.size(); i++) {
+    right_runs_[i].num_cells = num_cells_by_right_run.at(i);
+    num_cells_right_of_scanner_ += right_runs_[i].num_cells;
+  }
+}
+
+char RunLengthTape::GetBlankCharacter() const {
+  return blank_character_;
+}
+
+void RunLengthTape::TakeCells(std::vector<TapeRun> &runs, uint64_t
+    num_cells) {
+  while (num_cells > 0 && !runs.empty()) {
+    const uint64_t kNumCellsFromRun = std::min(num_cells,
+        runs.back().num_cells);
+    runs.back().num_cells -= kNumCellsFromRun;
+    if (runs.back().num_cells == 0) {
+      runs.pop_back();
+    }
+    num_cells -= kNumCellsFromRun;
+  }
+}
+
+char RunLengthTape::TakeCell(std::vector<TapeRun> &runs) {
+  if (runs.empty()) {
+    // the tape grows by a blank cell
+    return blank_character_;
+  }
+  const char kCharacter = runs.back().character;
+  TakeCells(runs, 1);
+  return kCharacter;
+}
+
+void RunLengthTape::AddCells(std::vector<TapeRun> &runs, char character,
+    uint64_t num_cells) {
+  if (!runs.empty() && runs.back().character == character) {
+    runs.back().num_cells += num_cells;
+    return;
+  }
+  TapeRun run;
+  run.character = character;
+  run.num_cells = num_cells;
+  runs.push_back(run);
+}
+
+uint64_t RunLengthTape::GetLengthOfTopRun(const std::vector<TapeRun> &runs,
+    char character) const {
+  // neighbouring runs always hold different characters, so a blank run
+  // alone on the stack is the last run before the end of the tape
+  const bool kReachesEndOfTape = runs.empty() || (runs.size() == 1
+      && runs.back().character == character);
+  if (character == blank_character_ && kReachesEndOfTape) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  if (runs.empty() || runs.back().character != character) {
+    return 0;
+  }
+  return runs.back().num_cells;
+}
+
+} // namespace turingmachinesimulator
@@ -6,10 +6,11 @@ State::State(int id, const std::string &state_name, const glm::vec2
     &state_location, double radius, const std::vector<std::string> 
     &possible_halting_state_names)
     : id_(id), 
-      state_name_(state_name), 
+      state_name_id_(NameTable::InternName(state_name)), 
       state_location_(state_location), 
       radius_(radius),
-      possible_halting_state_names_(possible_halting_state_names) {
+      possible_halting_state_names_id_(NameTable::InternNameList(
+          possible_halting_state_names)) {
   // states are only empty when created with the default constructor
   is_empty_ = false;
 }
@@ -19,11 +20,11 @@ int State::GetId() const {
 }
     
 void State::SetStateName(const std::string &state_name) {
-  state_name_ = state_name;
+  state_name_id_ = NameTable::InternName(state_name);
 }
 
-std::string State::GetStateName() const {
-  return state_name_;
+const std::string &State::GetStateName() const {
+  return NameTable::GetName(state_name_id_);
 }
 
 double State::GetRadius() const {
@@ -62,12 +63,12 @@ bool State::IsStateCenterWithinGivenRadiusOfPoint(const glm::vec2 &point,
 
 void State::Display() const {
   const std::string kStartingStateName = "q1";
-  if (state_name_ == kStartingStateName) {
+  const std::string kStateName = GetStateName();
+  if (kStateName == kStartingStateName) {
     DrawStartingState();
-  } else if (std::find(possible_halting_state_names_.begin(), 
-      possible_halting_state_names_.end(), state_name_) 
-      != possible_halting_state_names_.end()) {
-    DrawHaltingState(state_name_);
+  } else if (NameTable::NameListContains(possible_halting_state_names_id_,
+      state_name_id_)) {
+    DrawHaltingState(kStateName);
   } else {
     DrawNthState();
   }
@@ -93,7 +94,7 @@ void State::DrawNthState() const {
   // circle
   ci::gl::drawSolidCircle(state_location_, (radius_ - 2));
   ci::gl::color(ci::Color("black"));
-  ci::gl::drawStringCentered(state_name_, state_location_,
+  ci::gl::drawStringCentered(GetStateName(), state_location_,
       ci::Color("black"));
 }
 
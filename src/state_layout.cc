@@ -0,0 +1,186 @@
+#include "state_layout.h"
+
+#include <algorithm>
+#include <map>
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * size_t storing the number of bytes in a cache line, table entries at least
+ * this far apart are counted as far accesses
+ */
+const size_t kCacheLineSize = 64;
+
+} // namespace
+
+StateLayoutProfiler::StateLayoutProfiler(const std::shared_ptr<const Program>
+    &program)
+    : program_(program) {
+  if (program_ != nullptr) {
+    num_steps_by_state_.assign(program_->GetTransitionTable()
+        .GetNumberOfStates(), 0);
+  }
+}
+
+void StateLayoutProfiler::Profile(const Tape &tape, size_t state_index,
+    uint64_t max_steps) {
+  if (program_ == nullptr || program_->IsEmpty()) {
+    return;
+  }
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const uint64_t kNumColumns = kTransitionTable.GetNumberOfColumns();
+  const uint64_t kNumEntries = kTransitionTable.GetNumberOfStates()
+      * kNumColumns;
+  Tape profiled_tape = tape;
+  bool has_previous_entry = false;
+  uint64_t previous_entry = 0;
+  for (uint64_t step = 0; step < max_steps; step++) {
+    if (kTransitionTable.IsHaltingState(state_index)) {
+      break;
+    }
+    const char kRead = profiled_tape.Read();
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        state_index, kRead);
+    if (!kTransition.is_defined) {
+      break;
+    }
+    const uint64_t kEntry = state_index * kNumColumns
+        + kTransitionTable.GetColumn(kRead);
+    if (has_previous_entry) {
+      num_steps_by_entry_pair_[previous_entry * kNumEntries + kEntry] += 1;
+    }
+    has_previous_entry = true;
+    previous_entry = kEntry;
+    num_steps_by_state_[state_index] += 1;
+    num_steps_profiled_ += 1;
+
+    profiled_tape.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      profiled_tape.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      profiled_tape.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+  }
+}
+
+std::vector<size_t> StateLayoutProfiler::GetStateOrder() const {
+  const size_t kNumStates = num_steps_by_state_.size();
+  std::vector<size_t> state_order;
+  if (kNumStates == 0) {
+    return state_order;
+  }
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const uint64_t kNumColumns = kTransitionTable.GetNumberOfColumns();
+  const uint64_t kNumEntries = kNumStates * kNumColumns;
+
+  // count how often each state is followed by each other state
+  std::vector<std::map<size_t, uint64_t>> num_steps_by_successor(kNumStates);
+  for (const std::pair<const uint64_t, uint64_t> &kEntryPair
+      : num_steps_by_entry_pair_) {
+    const size_t kState = static_cast<size_t>(kEntryPair.first / kNumEntries
+        / kNumColumns);
+    const size_t kSuccessor = static_cast<size_t>(kEntryPair.first
+        % kNumEntries / kNumColumns);
+    if (kState != kSuccessor) {
+      num_steps_by_successor[kState][kSuccessor] += kEntryPair.second;
+    }
+  }
+
+  std::vector<size_t> hot_states;
+  for (size_t state = 0; state < kNumStates; state++) {
+    if (num_steps_by_state_[state] > 0) {
+      hot_states.push_back(state);
+    }
+  }
+  std::stable_sort(hot_states.begin(), hot_states.end(),
+      [this](size_t state, size_t other_state) {
+    return num_steps_by_state_[state] > num_steps_by_state_[other_state];
+  });
+
+  std::vector<bool> is_placed(kNumStates, false);
+  for (const size_t kHotState : hot_states) {
+    size_t state = kHotState;
+    while (!is_placed[state]) {
+      is_placed[state] = true;
+      state_order.push_back(state);
+      // follow the most frequent successor, staying put if every successor
+      // is already placed
+      uint64_t most_steps = 0;
+      for (const std::pair<const size_t, uint64_t> &kSuccessor
+          : num_steps_by_successor[state]) {
+        if (!is_placed[kSuccessor.first] && kSuccessor.second > most_steps) {
+          most_steps = kSuccessor.second;
+          state = kSuccessor.first;
+        }
+      }
+    }
+  }
+  for (size_t state = 0; state < kNumStates; state++) {
+    if (!is_placed[state]) {
+      state_order.push_back(state);
+    }
+  }
+  return state_order;
+}
+
+StateLayoutReport StateLayoutProfiler::GetReport() const {
+  StateLayoutReport report;
+  report.num_steps_profiled = num_steps_profiled_;
+  std::vector<size_t> new_index_by_index(num_steps_by_state_.size());
+  for (size_t state = 0; state < new_index_by_index.size(); state++) {
+    new_index_by_index[state] = state;
+  }
+  MeasureSpread(new_index_by_index, report.mean_access_distance_before,
+      report.far_access_rate_before);
+  const std::vector<size_t> kStateOrder = GetStateOrder();
+  for (size_t new_index = 0; new_index < kStateOrder.size(); new_index++) {
+    new_index_by_index[kStateOrder[new_index]] = new_index;
+  }
+  MeasureSpread(new_index_by_index, report.mean_access_distance_after,
+      report.far_access_rate_after);
+  return report;
+}
+
+void StateLayoutProfiler::MeasureSpread(const std::vector<size_t>
+    &new_index_by_index, double &mean_access_distance, double
+    &far_access_rate) const {
+  mean_access_distance = 0;
+  far_access_rate = 0;
+  if (num_steps_by_entry_pair_.empty()) {
+    return;
+  }
+  const uint64_t kNumColumns = program_->GetTransitionTable()
+      .GetNumberOfColumns();
+  const uint64_t kNumEntries = new_index_by_index.size() * kNumColumns;
+  // the interpreter reads the fused transitions, so distances are measured
+  // in their size
+  const uint64_t kEntrySize = sizeof(FusedTransition);
+  double total_distance = 0;
+  uint64_t num_far_accesses = 0;
+  uint64_t num_accesses = 0;
+  for (const std::pair<const uint64_t, uint64_t> &kEntryPair
+      : num_steps_by_entry_pair_) {
+    const uint64_t kEntry = kEntryPair.first / kNumEntries;
+    const uint64_t kNextEntry = kEntryPair.first % kNumEntries;
+    const uint64_t kAddress = (new_index_by_index[kEntry / kNumColumns]
+        * kNumColumns + kEntry % kNumColumns) * kEntrySize;
+    const uint64_t kNextAddress = (new_index_by_index[kNextEntry
+        / kNumColumns] * kNumColumns + kNextEntry % kNumColumns) * kEntrySize;
+    const uint64_t kDistance = kAddress > kNextAddress
+        ? kAddress - kNextAddress : kNextAddress - kAddress;
+    total_distance += static_cast<double>(kDistance)
+        * static_cast<double>(kEntryPair.second);
+    if (kDistance >= kCacheLineSize) {
+      num_far_accesses += kEntryPair.second;
+    }
+    num_accesses += kEntryPair.second;
+  }
+  mean_access_distance = total_distance / static_cast<double>(num_accesses);
+  far_access_rate = static_cast<double>(num_far_accesses)
+      / static_cast<double>(num_accesses);
+}
+
+} // namespace turingmachinesimulator
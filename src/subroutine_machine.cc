@@ -0,0 +1,373 @@
+#include "subroutine_machine.h"
+
+#include <algorithm>
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * uint64_t storing the most steps a call is run for on a copy of its window,
+ * longer calls are not memoized
+ */
+const uint64_t kMaxStepsPerCall = 1 << 16;
+
+/**
+ * size_t storing the most entries (nodes times columns of the transition
+ * table) kept in the trie of a subroutine before it is cleared
+ */
+const size_t kMaxCallTrieEntries = 1 << 22;
+
+/**
+ * size_t storing the effect index of the nodes of a trie that read a cell
+ */
+const size_t kNoEffect = static_cast<size_t>(-1);
+
+/**
+ * size_t storing the subroutine of the states that are not the entry state of
+ * a subroutine
+ */
+const size_t kNoSubroutine = static_cast<size_t>(-1);
+
+} // namespace
+
+SubroutineMachine::SubroutineMachine(const TuringMachine &turing_machine,
+    const std::vector<Subroutine> &subroutines) {
+  if (turing_machine.IsEmpty()) {
+    // do not create a non-empty subroutine machine if there is nothing to run
+    return;
+  }
+  program_ = turing_machine.GetProgram();
+  tape_ = Tape(turing_machine.GetTape(), turing_machine.GetBlankCharacter(),
+      turing_machine.GetIndexOfScanner(),
+      turing_machine.GetPositionOfScanner());
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const size_t kNumStates = kTransitionTable.GetNumberOfStates();
+  current_state_index_ = kTransitionTable.GetStateIndex(
+      turing_machine.GetCurrentState());
+  num_steps_ = turing_machine.GetNumberOfSteps();
+  is_halted_ = turing_machine.IsHalted();
+
+  // the entry state of each subroutine is looked up once here, so the step
+  // loop only checks 1 vector per step
+  subroutine_by_state_index_.assign(kNumStates, kNoSubroutine);
+  for (const Subroutine &kSubroutine : subroutines) {
+    const size_t kEntryStateIndex = kTransitionTable.GetStateIndex(
+        kSubroutine.entry_state);
+    if (kEntryStateIndex == kNumStates || kTransitionTable.IsHaltingState(
+        kEntryStateIndex) || subroutine_by_state_index_[kEntryStateIndex]
+        != kNoSubroutine) {
+      continue;
+    }
+    CompiledSubroutine subroutine;
+    subroutine.is_in_subroutine_by_state_index.assign(kNumStates, 0);
+    subroutine.is_exit_by_state_index.assign(kNumStates, 0);
+    subroutine.is_in_subroutine_by_state_index[kEntryStateIndex] = 1;
+    for (const State &kState : kSubroutine.states) {
+      const size_t kStateIndex = kTransitionTable.GetStateIndex(kState);
+      if (kStateIndex != kNumStates) {
+        subroutine.is_in_subroutine_by_state_index[kStateIndex] = 1;
+      }
+    }
+    for (const State &kState : kSubroutine.exit_states) {
+      const size_t kStateIndex = kTransitionTable.GetStateIndex(kState);
+      if (kStateIndex != kNumStates) {
+        subroutine.is_exit_by_state_index[kStateIndex] = 1;
+      }
+    }
+    subroutine.window_radius = kSubroutine.window_radius;
+    subroutine.is_read_by_offset.assign(2 * kSubroutine.window_radius + 1, 0);
+    subroutine_by_state_index_[kEntryStateIndex] = subroutines_.size();
+    subroutines_.push_back(subroutine);
+  }
+  is_empty_ = false;
+}
+
+RunResult SubroutineMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult SubroutineMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+std::vector<char> SubroutineMachine::GetTape() const {
+  return tape_.GetCells();
+}
+
+size_t SubroutineMachine::GetIndexOfScanner() const {
+  return tape_.GetIndexOfScanner();
+}
+
+int64_t SubroutineMachine::GetPositionOfScanner() const {
+  return tape_.GetPositionOfScanner();
+}
+
+State SubroutineMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return program_->GetTransitionTable().GetState(current_state_index_);
+}
+
+uint64_t SubroutineMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+uint64_t SubroutineMachine::GetNumberOfReplayedCalls() const {
+  return num_replayed_calls_;
+}
+
+size_t SubroutineMachine::GetNumberOfMemoizedEffects() const {
+  size_t num_memoized_effects = 0;
+  for (const CompiledSubroutine &kSubroutine : subroutines_) {
+    num_memoized_effects += kSubroutine.effects.size();
+  }
+  return num_memoized_effects;
+}
+
+bool SubroutineMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool SubroutineMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+RunResult SubroutineMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  RunResult result;
+  if (is_empty_) {
+    // an empty subroutine machine has nothing to run
+    return result;
+  }
+
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  size_t state_index = current_state_index_;
+  bool is_halted = is_halted_;
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted) {
+      break;
+    }
+    const size_t kSubroutine = subroutine_by_state_index_[state_index];
+    if (kSubroutine != kNoSubroutine) {
+      CompiledSubroutine &subroutine = subroutines_[kSubroutine];
+      uint64_t num_call_steps = ReplayCall(subroutine, max_steps
+          - num_steps_taken, state_index);
+      if (num_call_steps == 0) {
+        num_call_steps = RunCall(subroutine, max_steps - num_steps_taken,
+            state_index);
+      }
+      if (num_call_steps > 0) {
+        num_steps_taken += num_call_steps;
+        is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+        continue;
+      }
+      // a call stuck on its first step is left to the step loop to report
+    }
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        state_index, tape_.Read());
+    if (!kTransition.is_defined) {
+      break;
+    }
+    if (kTransition.is_sweep) {
+      // each skipped cell is 1 step that changes nothing but the scanner
+      const uint64_t kNumCellsSkipped = kTransition.scanner_offset > 0
+          ? tape_.SkipRight(kTransition.write, max_steps - num_steps_taken)
+          : tape_.SkipLeft(kTransition.write, max_steps - num_steps_taken);
+      if (kNumCellsSkipped > 0) {
+        num_steps_taken += kNumCellsSkipped;
+        continue;
+      }
+    }
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    is_halted = is_halted || kTransitionTable.IsHaltingState(state_index);
+    num_steps_taken += 1;
+  }
+  current_state_index_ = state_index;
+  is_halted_ = is_halted;
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = kTransitionTable.GetState(current_state_index_)
+      .GetId();
+  result.index_of_scanner = tape_.GetIndexOfScanner();
+  return result;
+}
+
+uint64_t SubroutineMachine::ReplayCall(CompiledSubroutine &subroutine,
+    uint64_t max_steps, size_t &state_index) {
+  if (subroutine.nodes.empty()) {
+    return 0;
+  }
+
+  // follow the cells the memoized calls read (cells past the ends of the
+  // tape are blank) until an effect or a cell no call has read yet
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const size_t kNumColumns = kTransitionTable.GetNumberOfColumns();
+  const TapeView kTapeView = tape_.GetView();
+  const int64_t kIndexOfScanner = static_cast<int64_t>(
+      kTapeView.GetIndexOfScanner());
+  const int64_t kSize = static_cast<int64_t>(kTapeView.GetSize());
+  size_t node = 0;
+  while (subroutine.nodes[node].effect_index == kNoEffect) {
+    const int64_t kIndex = kIndexOfScanner + subroutine.nodes[node]
+        .read_offset;
+    const char kCharacter = kIndex >= 0 && kIndex < kSize ? kTapeView[
+        static_cast<size_t>(kIndex)] : tape_.GetBlankCharacter();
+    node = subroutine.child_by_read[node * kNumColumns
+        + kTransitionTable.GetColumn(kCharacter)];
+    if (node == 0) {
+      return 0;
+    }
+  }
+  const CallEffect &kEffect = subroutine.effects[
+      subroutine.nodes[node].effect_index];
+  if (kEffect.num_steps > max_steps) {
+    return 0;
+  }
+
+  // visit exactly the cells the call reached, so the tape grows the same way
+  for (int64_t offset = 0; offset > kEffect.first_offset; offset--) {
+    tape_.MoveLeft();
+  }
+  for (size_t cell = 0; cell < kEffect.cells.size(); cell++) {
+    if (cell > 0) {
+      tape_.MoveRight();
+    }
+    tape_.Write(kEffect.cells[cell]);
+  }
+  int64_t offset = kEffect.first_offset + static_cast<int64_t>(
+      kEffect.cells.size()) - 1;
+  for (; offset > kEffect.scanner_offset; offset--) {
+    tape_.MoveLeft();
+  }
+  for (; offset < kEffect.scanner_offset; offset++) {
+    tape_.MoveRight();
+  }
+  state_index = kEffect.state_index;
+  num_replayed_calls_ += 1;
+  return kEffect.num_steps;
+}
+
+uint64_t SubroutineMachine::RunCall(CompiledSubroutine &subroutine, uint64_t
+    max_steps, size_t &state_index) {
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const int64_t kRadius = static_cast<int64_t>(subroutine.window_radius);
+  const int64_t kStartPosition = tape_.GetPositionOfScanner();
+  const uint64_t kStepLimit = std::min(max_steps, kMaxStepsPerCall);
+  reads_.clear();
+  uint64_t num_steps = 0;
+  bool is_memoizable = true;
+  // a halting state ends the call like an exit state
+  while (subroutine.is_in_subroutine_by_state_index[state_index] != 0
+      && !kTransitionTable.IsHaltingState(state_index)) {
+    const int64_t kOffset = tape_.GetPositionOfScanner() - kStartPosition;
+    if (num_steps == kStepLimit || kOffset < -kRadius || kOffset > kRadius) {
+      is_memoizable = false;
+      break;
+    }
+    const char kCharacter = tape_.Read();
+    char &is_read = subroutine.is_read_by_offset[static_cast<size_t>(kOffset
+        + kRadius)];
+    if (is_read == 0) {
+      is_read = 1;
+      reads_.push_back(std::make_pair(kOffset, kCharacter));
+    }
+    const Transition &kTransition = kTransitionTable.GetTransition(
+        state_index, kCharacter);
+    if (!kTransition.is_defined) {
+      is_memoizable = false;
+      break;
+    }
+    tape_.Write(kTransition.write);
+    if (kTransition.scanner_offset < 0) {
+      tape_.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape_.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    num_steps += 1;
+  }
+
+  int64_t first_offset = 0;
+  int64_t last_offset = 0;
+  for (const std::pair<int64_t, char> &kRead : reads_) {
+    subroutine.is_read_by_offset[static_cast<size_t>(kRead.first + kRadius)]
+        = 0;
+    first_offset = std::min(first_offset, kRead.first);
+    last_offset = std::max(last_offset, kRead.first);
+  }
+  if (!is_memoizable || (subroutine.is_exit_by_state_index[state_index] == 0
+      && !kTransitionTable.IsHaltingState(state_index))) {
+    return num_steps;
+  }
+
+  // the scanner moves 1 cell at a time, so every cell between the first and
+  // last cell read was read
+  CallEffect effect;
+  const int64_t kScannerOffset = tape_.GetPositionOfScanner()
+      - kStartPosition;
+  const int64_t kFirstIndex = static_cast<int64_t>(tape_.GetIndexOfScanner())
+      - kScannerOffset + first_offset;
+  for (int64_t offset = first_offset; offset <= last_offset; offset++) {
+    effect.cells.push_back(tape_.GetCell(static_cast<size_t>(kFirstIndex
+        + offset - first_offset)));
+  }
+  effect.first_offset = first_offset;
+  effect.scanner_offset = kScannerOffset;
+  effect.num_steps = num_steps;
+  effect.state_index = state_index;
+  MemoizeCall(subroutine, effect);
+  return num_steps;
+}
+
+void SubroutineMachine::MemoizeCall(CompiledSubroutine &subroutine, const
+    CallEffect &effect) {
+  const TransitionTable &kTransitionTable = program_->GetTransitionTable();
+  const size_t kNumColumns = kTransitionTable.GetNumberOfColumns();
+  if ((subroutine.nodes.size() + reads_.size() + 1) * kNumColumns
+      > kMaxCallTrieEntries) {
+    subroutine.nodes.clear();
+    subroutine.child_by_read.clear();
+    subroutine.effects.clear();
+  }
+  if (subroutine.nodes.empty()) {
+    subroutine.nodes.push_back(CallNode());
+    subroutine.child_by_read.assign(kNumColumns, 0);
+  }
+
+  // a call is deterministic, so calls that read the same cells so far read
+  // the same cell next and share the path to it; every character a memoized
+  // call read has a direction, so it has a column of its own
+  size_t node = 0;
+  for (size_t read = 0; read < reads_.size(); read++) {
+    const size_t kEntry = node * kNumColumns + kTransitionTable.GetColumn(
+        reads_[read].second);
+    if (subroutine.child_by_read[kEntry] == 0) {
+      CallNode child_node;
+      if (read + 1 < reads_.size()) {
+        child_node.read_offset = reads_[read + 1].first;
+      }
+      subroutine.child_by_read[kEntry] = subroutine.nodes.size();
+      subroutine.nodes.push_back(child_node);
+      subroutine.child_by_read.resize(subroutine.child_by_read.size()
+          + kNumColumns, 0);
+    }
+    node = subroutine.child_by_read[kEntry];
+  }
+  if (subroutine.nodes[node].effect_index == kNoEffect) {
+    subroutine.nodes[node].effect_index = subroutine.effects.size();
+    subroutine.effects.push_back(effect);
+  }
+}
+
+} // namespace turingmachinesimulator
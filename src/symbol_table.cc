@@ -0,0 +1,34 @@
+#include "symbol_table.h"
+
+namespace turingmachinesimulator {
+
+SymbolId SymbolTable::Intern(const std::string &symbol) {
+  const std::map<std::string, SymbolId>::const_iterator kIterator =
+      id_by_symbol_.find(symbol);
+  if (kIterator != id_by_symbol_.end()) {
+    return kIterator->second;
+  }
+  const SymbolId kSymbolId = static_cast<SymbolId>(symbols_.size());
+  symbols_.push_back(symbol);
+  id_by_symbol_[symbol] = kSymbolId;
+  return kSymbolId;
+}
+
+SymbolId SymbolTable::GetId(const std::string &symbol) const {
+  const std::map<std::string, SymbolId>::const_iterator kIterator =
+      id_by_symbol_.find(symbol);
+  if (kIterator == id_by_symbol_.end()) {
+    return static_cast<SymbolId>(symbols_.size());
+  }
+  return kIterator->second;
+}
+
+const std::string &SymbolTable::GetSymbol(SymbolId symbol_id) const {
+  return symbols_.at(symbol_id);
+}
+
+size_t SymbolTable::GetSize() const {
+  return symbols_.size();
+}
+
+} // namespace turingmachinesimulator
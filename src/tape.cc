@@ -0,0 +1,344 @@
+#include "tape.h"
+
+#include "symbol_table.h"
+
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * This method returns the number of cells, starting at the given cell and
+ * moving right, that hold the given character
+ *
+ * @param cells a pointer to the first cell to compare
+ * @param num_cells a size_t representing the most cells to compare
+ * @param character a Cell representing the character to compare with
+ * @return a size_t representing the number of matching cells
+ */
+template <typename Cell>
+size_t CountMatchingCellsRight(const Cell *cells, size_t num_cells, Cell
+    character) {
+  size_t num_matching_cells = 0;
+  while (num_matching_cells < num_cells
+      && cells[num_matching_cells] == character) {
+    num_matching_cells += 1;
+  }
+  return num_matching_cells;
+}
+
+/**
+ * This method returns the number of cells, starting at the given cell and
+ * moving left, that hold the given character
+ *
+ * @param cells a pointer to the first cell to compare
+ * @param num_cells a size_t representing the most cells to compare
+ * @param character a Cell representing the character to compare with
+ * @return a size_t representing the number of matching cells
+ */
+template <typename Cell>
+size_t CountMatchingCellsLeft(const Cell *cells, size_t num_cells, Cell
+    character) {
+  size_t num_matching_cells = 0;
+  while (num_matching_cells < num_cells
+      && *(cells - num_matching_cells) == character) {
+    num_matching_cells += 1;
+  }
+  return num_matching_cells;
+}
+
+#if defined(__GNUC__) && (defined(__AVX2__) || defined(__SSE2__))
+// the vector versions compare a block of chars at once, each bit of the mask
+// of a block is 1 if its char matches; the scalar versions finish the cells
+// that do not fill a block
+
+#if defined(__AVX2__)
+/**
+ * size_t storing the number of chars compared at once
+ */
+const size_t kBlockSize = 32;
+
+/**
+ * This method returns the match mask of the block of chars at the given
+ * pointer
+ */
+uint32_t GetMatchMask(const char *block, char character) {
+  const __m256i kCells = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+      block));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(kCells,
+      _mm256_set1_epi8(character))));
+}
+#else
+const size_t kBlockSize = 16;
+
+uint32_t GetMatchMask(const char *block, char character) {
+  const __m128i kCells = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+      block));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(kCells,
+      _mm_set1_epi8(character))));
+}
+#endif
+
+/**
+ * uint32_t storing the match mask of a block of chars that all match
+ */
+const uint32_t kAllMatch = static_cast<uint32_t>((static_cast<uint64_t>(1)
+    << kBlockSize) - 1);
+
+size_t CountMatchingCellsRight(const char *cells, size_t num_cells, char
+    character) {
+  size_t num_matching_cells = 0;
+  while (num_cells - num_matching_cells >= kBlockSize) {
+    const uint32_t kMismatches = ~GetMatchMask(cells + num_matching_cells,
+        character) & kAllMatch;
+    if (kMismatches != 0) {
+      // the lowest bit is the leftmost cell of the block
+      return num_matching_cells + static_cast<size_t>(__builtin_ctz(
+          kMismatches));
+    }
+    num_matching_cells += kBlockSize;
+  }
+  return num_matching_cells + CountMatchingCellsRight<char>(cells
+      + num_matching_cells, num_cells - num_matching_cells, character);
+}
+
+size_t CountMatchingCellsLeft(const char *cells, size_t num_cells, char
+    character) {
+  size_t num_matching_cells = 0;
+  while (num_cells - num_matching_cells >= kBlockSize) {
+    // the block ends at the next cell to compare
+    const uint32_t kMismatches = ~GetMatchMask(cells - num_matching_cells
+        - (kBlockSize - 1), character) & kAllMatch;
+    if (kMismatches != 0) {
+      // the highest bit is the rightmost cell of the block
+      return num_matching_cells + static_cast<size_t>(__builtin_clz(
+          kMismatches)) - (32 - kBlockSize);
+    }
+    num_matching_cells += kBlockSize;
+  }
+  return num_matching_cells + CountMatchingCellsLeft<char>(cells
+      - num_matching_cells, num_cells - num_matching_cells, character);
+}
+#endif
+
+} // namespace
+
+template <typename Cell>
+BasicTape<Cell>::BasicTape(const std::vector<Cell> &cells, Cell
+    blank_character)
+    : blank_character_(blank_character) {
+  // if the given tape is empty, set it to 1 blank character (same thing as
+  // an empty tape)
+  if (cells.empty()) {
+    cells_ = {blank_character};
+  } else {
+    cells_ = cells;
+  }
+  begin_ = 0;
+  end_ = cells_.size();
+  scanner_ = 0;
+  origin_ = 0;
+}
+
+template <typename Cell>
+BasicTape<Cell>::BasicTape(const std::vector<Cell> &cells, Cell
+    blank_character, size_t index_of_scanner, int64_t position_of_scanner)
+    : BasicTape(cells, blank_character) {
+  scanner_ = std::min(index_of_scanner, end_ - 1);
+  // the first cell of the starting tape is left of the given cells if they
+  // were trimmed from a tape with a blank margin
+  origin_ = static_cast<int64_t>(scanner_) - position_of_scanner;
+}
+
+template <typename Cell>
+BasicTape<Cell>::BasicTape(const BasicTapeGenerator<Cell> &tape_generator,
+    Cell blank_character)
+    : BasicTape(std::vector<Cell>(), blank_character) {
+  tape_generator_ = std::make_shared<const BasicTapeGenerator<Cell>>(
+      tape_generator);
+  if (tape_generator_->GetNumberOfCells() != 0) {
+    tape_generator_->Generate(0, 1, cells_.data());
+  }
+  position_of_generated_cells_ = 1;
+}
+
+template <typename Cell>
+uint64_t BasicTape<Cell>::SkipRight(Cell character, uint64_t max_cells) {
+  if (cells_.empty()) {
+    return 0;
+  }
+  // the last cell is left to a normal step, which grows the tape if needed
+  const size_t kNumCellsToCompare = static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(end_ - 1 - scanner_)));
+  const size_t kNumCellsSkipped = CountMatchingCellsRight(cells_.data()
+      + scanner_, kNumCellsToCompare, character);
+  scanner_ += kNumCellsSkipped;
+  return kNumCellsSkipped;
+}
+
+template <typename Cell>
+uint64_t BasicTape<Cell>::SkipLeft(Cell character, uint64_t max_cells) {
+  if (cells_.empty()) {
+    return 0;
+  }
+  // the first cell is left to a normal step, which grows the tape if needed
+  const size_t kNumCellsToCompare = static_cast<size_t>(std::min(max_cells,
+      static_cast<uint64_t>(scanner_ - begin_)));
+  const size_t kNumCellsSkipped = CountMatchingCellsLeft(cells_.data()
+      + scanner_, kNumCellsToCompare, character);
+  scanner_ -= kNumCellsSkipped;
+  return kNumCellsSkipped;
+}
+
+template <typename Cell>
+std::vector<Cell> BasicTape<Cell>::GetCells() const {
+  return std::vector<Cell>(cells_.begin() + begin_, cells_.begin() + end_);
+}
+
+template <typename Cell>
+BasicTapeView<Cell> BasicTape<Cell>::GetView() const {
+  return BasicTapeView<Cell>(cells_.data() + begin_, end_ - begin_,
+      scanner_ - begin_);
+}
+
+template <typename Cell>
+Cell BasicTape<Cell>::GetCell(size_t index) const {
+  return cells_.at(begin_ + index);
+}
+
+template <typename Cell>
+size_t BasicTape<Cell>::GetSize() const {
+  return end_ - begin_;
+}
+
+template <typename Cell>
+size_t BasicTape<Cell>::GetIndexOfScanner() const {
+  return scanner_ - begin_;
+}
+
+template <typename Cell>
+int64_t BasicTape<Cell>::GetPositionOfScanner() const {
+  return static_cast<int64_t>(scanner_) - origin_;
+}
+
+template <typename Cell>
+int64_t BasicTape<Cell>::GetPositionOfFirstCell() const {
+  return static_cast<int64_t>(begin_) - origin_;
+}
+
+template <typename Cell>
+Cell BasicTape<Cell>::GetBlankCharacter() const {
+  return blank_character_;
+}
+
+template <typename Cell>
+void BasicTape<Cell>::SetMaxBlankMargin(size_t max_blank_margin) {
+  max_blank_margin_ = max_blank_margin;
+}
+
+template <typename Cell>
+size_t BasicTape<Cell>::GetMaxBlankMargin() const {
+  return max_blank_margin_;
+}
+
+template <typename Cell>
+bool BasicTape<Cell>::IsGenerated() const {
+  return tape_generator_ != nullptr;
+}
+
+template <typename Cell>
+void BasicTape<Cell>::GrowLeft() {
+  if (max_blank_margin_ != 0) {
+    TrimBlankMargins();
+    return;
+  }
+  // doubling the headroom each time keeps the total cost of growing the tape
+  // linear in its final length
+  const size_t kMinimumHeadroom = 16;
+  const size_t kHeadroom = std::max(kMinimumHeadroom, cells_.size());
+  cells_.insert(cells_.begin(), kHeadroom, blank_character_);
+  begin_ += kHeadroom;
+  end_ += kHeadroom;
+  scanner_ += kHeadroom;
+  origin_ += static_cast<int64_t>(kHeadroom);
+}
+
+template <typename Cell>
+void BasicTape<Cell>::GrowRight() {
+  if (max_blank_margin_ != 0) {
+    TrimBlankMargins();
+    return;
+  }
+  const size_t kMinimumHeadroom = 16;
+  const size_t kHeadroom = std::max(kMinimumHeadroom, cells_.size());
+  const size_t kFirstNewIndex = cells_.size();
+  cells_.resize(cells_.size() + kHeadroom, blank_character_);
+  GenerateCells(kFirstNewIndex);
+}
+
+template <typename Cell>
+void BasicTape<Cell>::TrimBlankMargins() {
+  // the cells about to be dropped were reached, so they are not generated
+  // again if the tape grows back over them
+  position_of_generated_cells_ = std::max(position_of_generated_cells_,
+      static_cast<int64_t>(end_) - origin_);
+  // only the blank runs at the ends of the tape are dropped, so the cells
+  // within the margin of the scanner and every written cell between the
+  // blank runs are kept
+  const size_t kNumCellsFarLeft = scanner_ - begin_ > max_blank_margin_
+      ? scanner_ - begin_ - max_blank_margin_ : 0;
+  begin_ += CountMatchingCellsRight(cells_.data() + begin_, kNumCellsFarLeft,
+      blank_character_);
+  // when growing right, the scanner is already 1 cell past the end
+  const size_t kNumCellsFarRight = end_ > scanner_ + 1 + max_blank_margin_
+      ? end_ - 1 - scanner_ - max_blank_margin_ : 0;
+  end_ -= CountMatchingCellsLeft(cells_.data() + end_ - 1, kNumCellsFarRight,
+      blank_character_);
+  // the headroom is as large as the cells that are left, so like growing the
+  // tape, the cost of reallocating is paid for by the steps that use up the
+  // headroom, and the buffer is never more than 3 times the kept cells
+  const size_t kMinimumHeadroom = 16;
+  const size_t kSize = end_ - begin_;
+  const size_t kHeadroom = std::max(kMinimumHeadroom, kSize);
+  std::vector<Cell> cells(kHeadroom + kSize + kHeadroom, blank_character_);
+  std::copy(cells_.begin() + begin_, cells_.begin() + end_, cells.begin()
+      + kHeadroom);
+  cells_.swap(cells);
+  origin_ += static_cast<int64_t>(kHeadroom) - static_cast<int64_t>(begin_);
+  scanner_ = scanner_ - begin_ + kHeadroom;
+  begin_ = kHeadroom;
+  end_ = kHeadroom + kSize;
+  GenerateCells(end_);
+}
+
+template <typename Cell>
+void BasicTape<Cell>::GenerateCells(size_t first_index) {
+  if (tape_generator_ == nullptr) {
+    return;
+  }
+  // the cells of the tape so far (up to end_) hold whatever was written to
+  // them, the cells after them are still as the generator gives them
+  position_of_generated_cells_ = std::max(position_of_generated_cells_,
+      static_cast<int64_t>(end_) - origin_);
+  const int64_t kFirstPosition = std::max(position_of_generated_cells_,
+      static_cast<int64_t>(first_index) - origin_);
+  const int64_t kEndPosition = std::min(static_cast<int64_t>(
+      tape_generator_->GetNumberOfCells()), static_cast<int64_t>(
+      cells_.size()) - origin_);
+  if (kFirstPosition >= kEndPosition) {
+    return;
+  }
+  tape_generator_->Generate(static_cast<uint64_t>(kFirstPosition),
+      static_cast<size_t>(kEndPosition - kFirstPosition), cells_.data()
+      + (kFirstPosition + origin_));
+}
+
+// the tapes are only made of chars or interned symbol ids
+template class BasicTape<char>;
+template class BasicTape<NarrowSymbolId>;
+template class BasicTape<SymbolId>;
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,71 @@
+#include "tape_generator.h"
+
+#include <algorithm>
+
+#include "symbol_table.h"
+
+namespace turingmachinesimulator {
+
+template <typename Cell>
+BasicTapeGenerator<Cell>::BasicTapeGenerator(const
+    std::vector<BasicTapePattern<Cell>> &patterns) {
+  for (const BasicTapePattern<Cell> &kPattern : patterns) {
+    if (kPattern.pattern.empty() || kPattern.num_repetitions == 0) {
+      continue;
+    }
+    patterns_.push_back(kPattern);
+    position_by_pattern_.push_back(num_cells_);
+    num_cells_ += kPattern.pattern.size() * kPattern.num_repetitions;
+  }
+}
+
+template <typename Cell>
+BasicTapeGenerator<Cell>::BasicTapeGenerator(const
+    std::function<Cell(uint64_t)> &cell_at_position, uint64_t num_cells)
+    : cell_at_position_(cell_at_position), num_cells_(num_cells) {
+}
+
+template <typename Cell>
+void BasicTapeGenerator<Cell>::Generate(uint64_t position, size_t num_cells,
+    Cell *cells) const {
+  if (cell_at_position_) {
+    for (size_t i = 0; i < num_cells; i++) {
+      cells[i] = cell_at_position_(position + i);
+    }
+    return;
+  }
+  // find the repeated pattern holding the first cell, then copy the patterns
+  // from there
+  size_t pattern = static_cast<size_t>(std::upper_bound(
+      position_by_pattern_.begin(), position_by_pattern_.end(), position)
+      - position_by_pattern_.begin()) - 1;
+  size_t num_cells_generated = 0;
+  while (num_cells_generated < num_cells) {
+    const std::vector<Cell> &kCells = patterns_[pattern].pattern;
+    const uint64_t kEndOfPattern = pattern + 1 < patterns_.size()
+        ? position_by_pattern_[pattern + 1] : num_cells_;
+    uint64_t cell_position = position + num_cells_generated;
+    size_t index_in_pattern = static_cast<size_t>((cell_position
+        - position_by_pattern_[pattern]) % kCells.size());
+    while (num_cells_generated < num_cells && cell_position < kEndOfPattern) {
+      cells[num_cells_generated] = kCells[index_in_pattern];
+      index_in_pattern = index_in_pattern + 1 == kCells.size() ? 0
+          : index_in_pattern + 1;
+      num_cells_generated += 1;
+      cell_position += 1;
+    }
+    pattern += 1;
+  }
+}
+
+template <typename Cell>
+uint64_t BasicTapeGenerator<Cell>::GetNumberOfCells() const {
+  return num_cells_;
+}
+
+// the tapes are only made of chars or interned symbol ids
+template class BasicTapeGenerator<char>;
+template class BasicTapeGenerator<NarrowSymbolId>;
+template class BasicTapeGenerator<SymbolId>;
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,203 @@
+#include "transition_table.h"
+
+namespace turingmachinesimulator {
+
+TransitionTable::TransitionTable(const std::vector<State> &states, const
+    std::vector<Direction> &directions, const std::vector<std::string>
+    &halting_state_names) {
+  // give every state a dense index, the states of the machine come first so
+  // that the table keeps them over the copies stored in the directions
+  for (const State &kState : states) {
+    AddState(kState, halting_state_names);
+  }
+  for (const Direction &kDirection : directions) {
+    AddState(kDirection.GetStateToMoveFrom(), halting_state_names);
+    AddState(kDirection.GetStateToMoveTo(), halting_state_names);
+  }
+
+  // give every character that is read by a direction a column
+  for (const Direction &kDirection : directions) {
+    const unsigned char kRead = static_cast<unsigned char>(
+        kDirection.GetRead());
+    if (column_by_character_[kRead] == 0) {
+      read_characters_.push_back(kDirection.GetRead());
+      column_by_character_[kRead] = static_cast<uint16_t>(
+          read_characters_.size());
+    }
+  }
+  num_columns_ = read_characters_.size() + 1;
+
+  // fill in the table
+  transitions_.assign(states_.size() * num_columns_, Transition());
+  for (const Direction &kDirection : directions) {
+    const size_t kRow = GetStateIndex(kDirection.GetStateToMoveFrom());
+    const size_t kColumn = column_by_character_[static_cast<unsigned char>(
+        kDirection.GetRead())];
+    Transition &transition = transitions_[kRow * num_columns_ + kColumn];
+    transition.state_to_move_to = static_cast<uint32_t>(GetStateIndex(
+        kDirection.GetStateToMoveTo()));
+    transition.write = kDirection.GetWrite();
+    const char kScannerMovement = kDirection.GetScannerMovement();
+    if (kScannerMovement == 'l') {
+      transition.scanner_offset = -1;
+    } else if (kScannerMovement == 'r') {
+      transition.scanner_offset = 1;
+    } else {
+      transition.scanner_offset = 0;
+    }
+    transition.is_defined = true;
+    // halting states are never swept so that RunUntilHalt stops after the
+    // step into them
+    transition.is_sweep = transition.write == kDirection.GetRead()
+        && transition.scanner_offset != 0 && transition.state_to_move_to
+        == kRow && is_halting_by_state_index_[kRow] == 0;
+  }
+  FuseTransitions();
+}
+
+size_t TransitionTable::GetStateIndex(const State &state) const {
+  const std::map<int, size_t>::const_iterator kIterator =
+      state_index_by_id_.find(state.GetId());
+  if (kIterator == state_index_by_id_.end()) {
+    return states_.size();
+  }
+  return kIterator->second;
+}
+
+const State &TransitionTable::GetState(size_t state_index) const {
+  return states_.at(state_index);
+}
+
+size_t TransitionTable::GetNumberOfStates() const {
+  return states_.size();
+}
+
+const std::vector<char> &TransitionTable::GetReadCharacters() const {
+  return read_characters_;
+}
+
+size_t TransitionTable::GetNumberOfColumns() const {
+  return num_columns_;
+}
+
+bool TransitionTable::IsEmpty() const {
+  return states_.empty();
+}
+
+void TransitionTable::ReorderStates(const std::vector<size_t> &state_order) {
+  if (state_order.size() != states_.size()) {
+    return;
+  }
+  const size_t kNoIndex = states_.size();
+  std::vector<size_t> new_index_by_index(states_.size(), kNoIndex);
+  for (size_t new_index = 0; new_index < state_order.size(); new_index++) {
+    if (state_order[new_index] >= states_.size()
+        || new_index_by_index[state_order[new_index]] != kNoIndex) {
+      return;
+    }
+    new_index_by_index[state_order[new_index]] = new_index;
+  }
+
+  std::vector<State> states;
+  std::vector<char> is_halting_by_state_index;
+  std::vector<Transition> transitions;
+  transitions.reserve(transitions_.size());
+  for (const size_t kIndex : state_order) {
+    states.push_back(states_[kIndex]);
+    is_halting_by_state_index.push_back(is_halting_by_state_index_[kIndex]);
+    for (size_t column = 0; column < num_columns_; column++) {
+      Transition transition = transitions_[kIndex * num_columns_ + column];
+      transition.state_to_move_to = static_cast<uint32_t>(
+          new_index_by_index[transition.state_to_move_to]);
+      transitions.push_back(transition);
+    }
+  }
+  for (std::pair<const int, size_t> &state_index_by_id : state_index_by_id_) {
+    state_index_by_id.second = new_index_by_index[state_index_by_id.second];
+  }
+  states_.swap(states);
+  is_halting_by_state_index_.swap(is_halting_by_state_index);
+  transitions_.swap(transitions);
+  FuseTransitions();
+}
+
+void TransitionTable::FuseTransitions() {
+  // chains are cut off after this many steps, so states that stay in place
+  // forever still get a finite superinstruction
+  const uint32_t kMaxFusedSteps = 64;
+  fused_transitions_.assign(transitions_.size(), FusedTransition());
+  for (size_t index = 0; index < transitions_.size(); index++) {
+    FusedTransition &fused_transition = fused_transitions_[index];
+    Transition &transition = fused_transition.transition;
+    transition = transitions_[index];
+    if (!transition.is_defined) {
+      continue;
+    }
+    fused_transition.num_steps = 1;
+    // a halting state ends the chain so RunUntilHalt stops right after the
+    // step into it
+    while (transition.scanner_offset == 0 && !IsHaltingState(
+        transition.state_to_move_to) && fused_transition.num_steps
+        < kMaxFusedSteps) {
+      const Transition &kNextTransition = GetTransition(
+          transition.state_to_move_to, transition.write);
+      if (!kNextTransition.is_defined) {
+        break;
+      }
+      transition.write = kNextTransition.write;
+      transition.scanner_offset = kNextTransition.scanner_offset;
+      transition.state_to_move_to = kNextTransition.state_to_move_to;
+      fused_transition.num_steps += 1;
+    }
+    // skipping sweep steps only works for a sweep taken on its own
+    transition.is_sweep = transition.is_sweep
+        && fused_transition.num_steps == 1;
+    fused_transition.num_steps_before_jumps = fused_transition.num_steps;
+    fused_transition.first_jump_state = transition.state_to_move_to;
+    // the character after a move is not known, so only states that do the
+    // same thing on every character can be stepped through
+    while (transition.scanner_offset != 0 && IsJumpState(
+        transition.state_to_move_to) && fused_transition.num_steps
+        < kMaxFusedSteps) {
+      transition.state_to_move_to = transitions_[transition.state_to_move_to
+          * num_columns_ + 1].state_to_move_to;
+      fused_transition.num_steps += 1;
+    }
+  }
+}
+
+bool TransitionTable::IsJumpState(size_t state_index) const {
+  if (IsHaltingState(state_index) || read_characters_.empty()) {
+    return false;
+  }
+  const size_t kStateToJumpTo = transitions_[state_index * num_columns_ + 1]
+      .state_to_move_to;
+  if (kStateToJumpTo == state_index) {
+    return false;
+  }
+  for (size_t column = 1; column < num_columns_; column++) {
+    const Transition &kTransition = transitions_[state_index * num_columns_
+        + column];
+    if (!kTransition.is_defined || kTransition.write
+        != read_characters_[column - 1] || kTransition.scanner_offset != 0
+        || kTransition.state_to_move_to != kStateToJumpTo) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TransitionTable::AddState(const State &state, const
+    std::vector<std::string> &halting_state_names) {
+  if (state_index_by_id_.find(state.GetId()) != state_index_by_id_.end()) {
+    return;
+  }
+  state_index_by_id_[state.GetId()] = states_.size();
+  states_.push_back(state);
+  const bool kIsHaltingState = std::find(halting_state_names.begin(),
+      halting_state_names.end(), state.GetStateName())
+      != halting_state_names.end();
+  is_halting_by_state_index_.push_back(kIsHaltingState ? 1 : 0);
+}
+
+} // namespace turingmachinesimulator
@@ -1,185 +1,281 @@
 #include "turing_machine.h"
 
+#include <limits>
+
+#include "proven_rule_machine.h"
+
 namespace turingmachinesimulator {
 
-TuringMachine::TuringMachine(const std::vector<State> &states, const 
-    std::vector<Direction> &directions, const std::vector<char> &tape, char 
-    blank_character, const std::vector<std::string> &halting_state_names) {
-  // if the given tape is empty, set it to 1 blank character (same thing as 
-  // an empty tape)
-  if (tape.empty()) {
-    tape_ = {blank_character};
-  } else {
-    tape_ = tape;
-  }
-  
-  // set starting and halting states
-  for (const State &kState : states) {
-    const std::string kNameOfStartingState = "q1";
-    const std::string kStateName = kState.GetStateName();
-    if (kStateName == kNameOfStartingState) {
-      if (!current_state_.IsEmpty()) {
-        error_message_ = "Cannot Have More Than 1 Starting State";
-        return;
-      } else {
-        // the machine starts in the starting state
-        current_state_ = kState;
-      }
-    } else if (std::find(halting_state_names.begin(), halting_state_names.end(),
-        kStateName) != halting_state_names.end()) {
-      halting_states_.push_back(kState);
-    }
-  }
-  if (current_state_.IsEmpty()) {
-    error_message_ = "Must Have Starting State";
-    return;
-  }
-  
-  // put directions into the directions by state map
- for (const Direction &kDirection : directions) {
-    const State kStateToMoveFrom = kDirection.GetStateToMoveFrom();
-    try {
-      std::vector<Direction> kStateDirections = 
-          directions_by_state_map_.at(kStateToMoveFrom);
-      if (std::find(kStateDirections.begin(), kStateDirections.end(), kDirection)
-          != kStateDirections.end()) {
-        error_message_ = "Must Not Have 2 Directions With Same Read Condition "
-            "From The Same State";
-        return;
-      }
-    } catch (const std::exception &kException) {
-      // Only here if the state to move from isn't in the map yet
-      // Don't need to do anything since the above code would not apply
-      // to such a situation anyway
-    }
-    directions_by_state_map_[kStateToMoveFrom].push_back(kDirection);
-  }
- 
-  // if no errors were encountered in initializing the turing machine, then it is
-  // not empty and initialize the blank character and halting state names
-  is_empty_ = false;
-  blank_character_ = blank_character;
-  halting_state_names_ = halting_state_names;
+namespace {
+
+/**
+ * Program returned for turing machines made with the default constructor
+ */
+const Program kEmptyProgram = Program();
+
+/**
+ * This method returns the given number of steps, or the largest uint64_t if
+ * it does not fit in 1 (a count of steps saturates rather than wrapping
+ * around)
+ *
+ * @param step_count a StepCount representing a number of steps
+ * @return a uint64_t representing the number of steps
+ */
+uint64_t SaturateStepCount(StepCount step_count) {
+  const uint64_t kMaxNumSteps = std::numeric_limits<uint64_t>::max();
+  return step_count > kMaxNumSteps ? kMaxNumSteps : static_cast<uint64_t>(
+      step_count);
+}
+
+} // namespace
+
+TuringMachine::TuringMachine(const std::vector<State> &states, const
+    std::vector<Direction> &directions, const std::vector<char> &tape, char
+    blank_character, const std::vector<std::string> &halting_state_names)
+    : TuringMachine(std::make_shared<const Program>(states, directions,
+      halting_state_names), tape, blank_character) {
+}
+
+TuringMachine::TuringMachine(const std::shared_ptr<const Program> &program,
+    const std::vector<char> &tape, char blank_character)
+    : program_(program),
+      execution_context_(program, tape, blank_character) {
+}
+
+TuringMachine::TuringMachine(const std::vector<State> &states, const
+    std::vector<Direction> &directions, const TapeGenerator &tape_generator,
+    char blank_character, const std::vector<std::string> &halting_state_names)
+    : TuringMachine(std::make_shared<const Program>(states, directions,
+      halting_state_names), tape_generator, blank_character) {
+}
+
+TuringMachine::TuringMachine(const std::shared_ptr<const Program> &program,
+    const TapeGenerator &tape_generator, char blank_character)
+    : program_(program),
+      execution_context_(program, Tape(tape_generator, blank_character)) {
 }
 
 State TuringMachine::GetCurrentState() const {
-  return current_state_;
+  if (is_execution_context_behind_) {
+    return proven_rule_machine_->GetCurrentState();
+  }
+  if (execution_context_.IsEmpty() && program_ != nullptr) {
+    // a machine rejected after its starting state was found is still in its
+    // starting state
+    return program_->GetStartingState();
+  }
+  return execution_context_.GetCurrentState();
+}
+
+int TuringMachine::GetCurrentStateId() const {
+  if (is_execution_context_behind_) {
+    return proven_rule_machine_->GetCurrentState().GetId();
+  }
+  return execution_context_.GetCurrentStateId();
 }
 
 std::vector<State> TuringMachine::GetHaltingStates() const {
-  return halting_states_;
+  return GetHaltingStatesView();
+}
+
+const std::vector<State> &TuringMachine::GetHaltingStatesView() const {
+  if (program_ == nullptr) {
+    return kEmptyProgram.GetHaltingStates();
+  }
+  return program_->GetHaltingStates();
 }
 
 std::map<State, std::vector<Direction>> TuringMachine::GetDirectionsByStateMap()
     const {
-  return directions_by_state_map_;
+  return GetDirectionsByStateMapView();
+}
+
+const std::map<State, std::vector<Direction>>
+    &TuringMachine::GetDirectionsByStateMapView() const {
+  if (program_ == nullptr) {
+    return kEmptyProgram.GetDirectionsByStateMap();
+  }
+  return program_->GetDirectionsByStateMap();
 }
 
 std::vector<char> TuringMachine::GetTape() const {
-  return tape_;
+  SyncWithProvenRuleMachine();
+  return execution_context_.GetTape();
+}
+
+TapeView TuringMachine::GetTapeView() const {
+  SyncWithProvenRuleMachine();
+  return execution_context_.GetTapeView();
 }
 
 size_t TuringMachine::GetIndexOfScanner() const {
-  return index_of_scanner_;
+  if (is_execution_context_behind_) {
+    return static_cast<size_t>(proven_rule_machine_->GetIndexOfScanner());
+  }
+  return execution_context_.GetIndexOfScanner();
+}
+
+int64_t TuringMachine::GetPositionOfScanner() const {
+  if (is_execution_context_behind_) {
+    return proven_rule_machine_->GetPositionOfScanner();
+  }
+  return execution_context_.GetPositionOfScanner();
+}
+
+size_t TuringMachine::Subscribe(const StepEventListener &listener) {
+  DropProvenRuleMachine();
+  return execution_context_.Subscribe(listener);
+}
+
+void TuringMachine::Unsubscribe(size_t subscription_id) {
+  execution_context_.Unsubscribe(subscription_id);
+}
+
+uint64_t TuringMachine::GetNumberOfSteps() const {
+  if (is_execution_context_behind_) {
+    return SaturateStepCount(proven_rule_machine_->GetNumberOfSteps());
+  }
+  return execution_context_.GetNumberOfSteps();
+}
+
+StepCount TuringMachine::GetExactNumberOfSteps() const {
+  if (proven_rule_machine_ != nullptr) {
+    // the proven rule machine is dropped before steps are taken any other
+    // way, so its count is up to date
+    return proven_rule_machine_->GetNumberOfSteps();
+  }
+  return execution_context_.GetNumberOfSteps();
 }
 
 std::string TuringMachine::GetErrorMessage() const {
-  return error_message_;
+  if (program_ == nullptr) {
+    return "";
+  }
+  return program_->GetErrorMessage();
+}
+
+char TuringMachine::GetBlankCharacter() const {
+  return execution_context_.GetBlankCharacter();
+}
+
+const TransitionTable &TuringMachine::GetTransitionTable() const {
+  if (program_ == nullptr) {
+    return kEmptyProgram.GetTransitionTable();
+  }
+  return program_->GetTransitionTable();
+}
+
+const std::shared_ptr<const Program> &TuringMachine::GetProgram() const {
+  return program_;
 }
 
 bool TuringMachine::IsHalted() const {
-  return is_halted_;
+  if (is_execution_context_behind_) {
+    return proven_rule_machine_->IsHalted();
+  }
+  return execution_context_.IsHalted();
 }
 
 bool TuringMachine::IsEmpty() const {
-  return is_empty_;
+  return execution_context_.IsEmpty();
 }
 
 std::string TuringMachine::GetConfigurationForConsole() const {
-  std::stringstream configuration_stringstream;
-  configuration_stringstream << ';';
-  // cannot use for-each loop here since the index is necessary
-  for (size_t i = 0; i < tape_.size(); i++) {
-    if (i == index_of_scanner_) {
-      configuration_stringstream << current_state_.GetStateName();
-    }
-    configuration_stringstream << tape_.at(i);
-  }
-  return configuration_stringstream.str();
+  SyncWithProvenRuleMachine();
+  return execution_context_.GetConfigurationForConsole();
 }
 
 std::string TuringMachine::GetConfigurationForMarkdown() const {
-  std::stringstream configuration_stringstream;
-  configuration_stringstream << ';';
-  // cannot use for-each loop here since index is necessary
-  for (size_t i = 0; i < tape_.size(); i++) {
-    if (i == index_of_scanner_) {
-      // NOTE: 'q' always precedes the name of the state; we only want the name 
-      // of the state in the subscript
-      configuration_stringstream << 'q';
-      const std::string kStateName = current_state_.GetStateName();
-      const std::string kStateNameWithoutQ = kStateName.substr(1, 
-          kStateName.size());
-      // NOTE: <sub> is the markdown subscript tag
-      configuration_stringstream << "<sub>" << kStateNameWithoutQ << "</sub>";
-    }
-    configuration_stringstream << tape_.at(i);
-  }
-  return configuration_stringstream.str();
+  SyncWithProvenRuleMachine();
+  return execution_context_.GetConfigurationForMarkdown();
 }
 
 void TuringMachine::Update() {
-  std::vector<Direction> possible_directions;
-  try {
-    possible_directions = directions_by_state_map_.at(current_state_);
-  } catch (const std::exception &kException) {
-    // if there are no directions for the state, then there is nothing to update
-    return;
+  DropProvenRuleMachine();
+  execution_context_.Update();
+}
+
+void TuringMachine::SetRunMode(RunMode run_mode) {
+  run_mode_ = run_mode;
+}
+
+RunMode TuringMachine::GetRunMode() const {
+  return run_mode_;
+}
+
+void TuringMachine::SetMaxBlankMargin(size_t max_blank_margin) {
+  DropProvenRuleMachine();
+  execution_context_.SetMaxBlankMargin(max_blank_margin);
+}
+
+StateLayoutReport TuringMachine::OptimizeStateLayout(uint64_t
+    num_warm_up_steps) {
+  DropProvenRuleMachine();
+  const StateLayoutReport kReport = execution_context_.OptimizeStateLayout(
+      num_warm_up_steps);
+  program_ = execution_context_.GetProgram();
+  return kReport;
+}
+
+RunResult TuringMachine::Run(uint64_t max_steps) {
+  if (run_mode_ == RunMode::kProvenRules) {
+    return RunWithProvenRules(max_steps, false);
+  }
+  DropProvenRuleMachine();
+  return execution_context_.Run(max_steps);
+}
+
+RunResult TuringMachine::RunUntilHalt(uint64_t step_budget) {
+  if (run_mode_ == RunMode::kProvenRules) {
+    return RunWithProvenRules(step_budget, true);
   }
-  
-  for (const Direction &kDirection : possible_directions) {
-    if (kDirection.GetRead() == tape_.at(index_of_scanner_)) {
-      ExecuteDirection(kDirection);
-      break; // once the direction is found and executed, nothing to search for
-    }
-  }
-}
-
-void TuringMachine::ExecuteDirection(const Direction &direction) {
-  // write the character given by the direction to the tape
-  tape_.at(index_of_scanner_) = direction.GetWrite();
-  
-  // move the scanner 1 index left/right and update the tape size if needed
-  const char kScannerMovement = direction.GetScannerMovement();
-  const char kLeftMovement = 'l';
-  if (kScannerMovement == kLeftMovement) {
-    // if the scanner is at the beginning of the tape, insert a blank character
-    // to index 0 in order to move left, otherwise move the scanner left (index
-    // - 1)
-    if (index_of_scanner_ == 0) {
-      tape_.insert(tape_.begin(), blank_character_);
-    } else {
-      index_of_scanner_ -= 1;
-    }
-  }
-  const char kRightMovement = 'r';
-  if (kScannerMovement == kRightMovement) {
-    index_of_scanner_ += 1;
-    // if the updated scanner index is larger than the length of the tape,
-    // append a blank character to the tape in order to move right
-    if (index_of_scanner_ >= tape_.size()) {
-      tape_.push_back(blank_character_);
-    }
-  }
-  
-  // update the current state and halt the turing machine if the current state 
-  // is now a halting state
-  current_state_ = direction.GetStateToMoveTo();
-  if (std::find(halting_state_names_.begin(),
-      halting_state_names_.end(), current_state_.GetStateName()) 
-      != halting_state_names_.end()) {
-    is_halted_ = true;
+  DropProvenRuleMachine();
+  return execution_context_.RunUntilHalt(step_budget);
+}
+
+RunResult TuringMachine::RunWithProvenRules(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  // listeners need every step, which proven rules skip, and the proven rule
+  // machine only takes over the cells of a generated tape reached so far
+  if (IsEmpty() || execution_context_.HasListeners()
+      || execution_context_.IsTapeGenerated()) {
+    DropProvenRuleMachine();
+    return stop_at_halting_state ? execution_context_.RunUntilHalt(max_steps)
+        : execution_context_.Run(max_steps);
+  }
+  if (proven_rule_machine_ == nullptr) {
+    proven_rule_machine_ = std::make_shared<ProvenRuleMachine>(*this);
+  } else if (proven_rule_machine_.use_count() > 1) {
+    // a copy of this turing machine shares the proven rule machine
+    proven_rule_machine_ = std::make_shared<ProvenRuleMachine>(
+        *proven_rule_machine_);
   }
+  const RunResult kResult = stop_at_halting_state
+      ? proven_rule_machine_->RunUntilHalt(max_steps)
+      : proven_rule_machine_->Run(max_steps);
+  is_execution_context_behind_ = is_execution_context_behind_
+      || kResult.num_steps > 0;
+  return kResult;
+}
+
+void TuringMachine::SyncWithProvenRuleMachine() const {
+  if (!is_execution_context_behind_) {
+    return;
+  }
+  is_execution_context_behind_ = false;
+  const ProvenRuleMachine &kProvenRuleMachine = *proven_rule_machine_;
+  const Tape kTape = Tape(kProvenRuleMachine.GetTape(), GetBlankCharacter(),
+      static_cast<size_t>(kProvenRuleMachine.GetIndexOfScanner()),
+      kProvenRuleMachine.GetPositionOfScanner());
+  execution_context_.SetConfiguration(kTape,
+      GetTransitionTable().GetStateIndex(kProvenRuleMachine.GetCurrentState()),
+      SaturateStepCount(kProvenRuleMachine.GetNumberOfSteps()),
+      kProvenRuleMachine.IsHalted());
+}
+
+void TuringMachine::DropProvenRuleMachine() {
+  SyncWithProvenRuleMachine();
+  proven_rule_machine_.reset();
 }
 
 } // namespace turingmachinesimulator
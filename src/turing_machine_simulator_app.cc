@@ -78,7 +78,7 @@ void TuringMachineSimulatorApp::draw() {
     // experimenting for best visual experience
     const int kSizeOfHighlightRing = 10;
     if (simulation_is_in_progress_ 
-        && turing_machine_.GetCurrentState().Equals(kState)) {
+        && turing_machine_.GetCurrentStateId() == kState.GetId()) {
       ci::gl::color(ci::Color("yellow"));
       ci::gl::drawSolidCircle(kState.GetStateLocation(), 
           kState.GetRadius() + kSizeOfHighlightRing);
@@ -250,9 +250,8 @@ void TuringMachineSimulatorApp::PerformTuringMachineStep() {
     configuration_file << turing_machine_.GetConfigurationForMarkdown();
   }
 
-  // update the tape, scanner, and stop simulation if applicable
-  tape_ = turing_machine_.GetTape();
-  index_of_character_being_read_ = turing_machine_.GetIndexOfScanner();
+  // NOTE: the tape and scanner were already updated by the step events of
+  // the turing machine, stop simulation if applicable
   if (turing_machine_.IsHalted()) {
     halting_state_to_highlight_ = turing_machine_.GetCurrentState();
     // NOTE: Lines 259-263 must not be added to StopSimulation()
@@ -501,6 +500,17 @@ void TuringMachineSimulatorApp::EditTapeCharacter(const ci::app::KeyEvent
 void TuringMachineSimulatorApp::StartSimulation() {
   num_simulations_run_ += 1;
   simulation_is_in_progress_ = true;
+
+  // follow the changes the turing machine makes to the tape instead of
+  // copying the tape after every step
+  const TapeView kTapeView = turing_machine_.GetTapeView();
+  simulated_tape_ = Tape(std::vector<char>(kTapeView.begin(),
+      kTapeView.end()), blank_character_, kTapeView.GetIndexOfScanner(),
+      turing_machine_.GetPositionOfScanner());
+  index_of_character_being_read_ = kTapeView.GetIndexOfScanner();
+  turing_machine_.Subscribe([this](const std::vector<StepEvent> &events) {
+    ApplyStepEvents(events);
+  });
   
   // label the complete configuration with a heading indicating which
   // number simulation this is
@@ -518,8 +528,27 @@ void TuringMachineSimulatorApp::StartSimulation() {
   }
 }
 
+void TuringMachineSimulatorApp::ApplyStepEvents(const std::vector<StepEvent>
+    &events) {
+  for (const StepEvent &kEvent : events) {
+    if (kEvent.type == StepEventType::kWrite) {
+      simulated_tape_.Write(kEvent.character);
+    } else if (kEvent.type == StepEventType::kMove) {
+      // the tape gains a blank cell when the scanner moves past either end
+      if (kEvent.position < simulated_tape_.GetPositionOfScanner()) {
+        simulated_tape_.MoveLeft();
+      } else {
+        simulated_tape_.MoveRight();
+      }
+    }
+  }
+  index_of_character_being_read_ = simulated_tape_.GetIndexOfScanner();
+}
+
 void TuringMachineSimulatorApp::StopSimulation() {
   simulation_is_in_progress_ = false;
+  // show the tape the simulation ended with once it is editable again
+  tape_ = simulated_tape_.GetCells();
   is_first_turn_of_simulation_ = true;
   // resume normal frame rate from reduced frame rate so graphics aren't slow
   ci::app::setFrameRate(60);
@@ -722,13 +751,18 @@ void TuringMachineSimulatorApp::DrawArrow(const Direction &direction) const {
 
 void TuringMachineSimulatorApp::DrawTape() const {
   const double kPixelLengthOfTape = kLowerCornerOfTape.x - kUpperCornerOfTape.x;
-  const double kHorizontalSizeOfSquares = kPixelLengthOfTape / tape_.size();
+  // during a simulation the tape shown is the one following the turing machine
+  const TapeView kTapeView = simulation_is_in_progress_
+      ? simulated_tape_.GetView() : TapeView(tape_.data(), tape_.size(),
+      index_of_character_being_read_);
+  const double kHorizontalSizeOfSquares = kPixelLengthOfTape
+      / kTapeView.GetSize();
   glm::vec2 square_upper_corner = kUpperCornerOfTape;
   glm::vec2 square_lower_corner = glm::vec2(kUpperCornerOfTape.x
      + kHorizontalSizeOfSquares, kLowerCornerOfTape.y);
   ci::gl::color(ci::Color("black"));
   // note: cannot be in for-each loop because the index is needed
-  for (size_t i = 0; i < tape_.size(); i++) {
+  for (size_t i = 0; i < kTapeView.GetSize(); i++) {
     // draw the square
     const ci::Rectf kSquare = ci::Rectf(square_upper_corner, square_lower_corner);
     ci::gl::drawStrokedRect(kSquare);
@@ -736,7 +770,7 @@ void TuringMachineSimulatorApp::DrawTape() const {
     // display the character in the square
     const glm::vec2 kCenterOfSquare =  kSquare.getCenter();
     std::stringstream character_as_stringstream;
-    character_as_stringstream << tape_.at(i);
+    character_as_stringstream << kTapeView[i];
     ci::gl::drawString(character_as_stringstream.str(), kCenterOfSquare,
         "black");
 
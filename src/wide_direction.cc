@@ -0,0 +1,78 @@
+#include "wide_direction.h"
+
+#include <cctype>
+
+namespace turingmachinesimulator {
+
+WideDirection::WideDirection(const std::string &read, const std::string
+    &write, char move, const State &state_to_move_from, const State
+    &state_to_move_to) {
+  // validate read and write symbols
+  if (read.empty() || write.empty()) {
+    // don't create non-empty direction object if a symbol is empty
+    return;
+  }
+
+  // validate scanner movement character (must be l/r/n)
+  const char kScannerMovementChar = static_cast<char>(std::tolower(move));
+  if (kScannerMovementChar != 'l' && kScannerMovementChar != 'r'
+      && kScannerMovementChar != 'n') {
+    // don't create non-empty direction object if scanner movement direction is
+    // wrong
+    return;
+  }
+
+  // validate state to move from/to
+  if (state_to_move_from.IsEmpty() || state_to_move_to.IsEmpty()) {
+    // don't create non-empty direction object if state to move from/to is
+    // empty
+    return;
+  }
+  read_ = read;
+  write_ = write;
+  scanner_movement_ = kScannerMovementChar;
+  state_to_move_from_ = state_to_move_from;
+  state_to_move_to_ = state_to_move_to;
+  // if all variables are successfully initialized, then the direction is
+  // non-empty
+  is_empty_ = false;
+}
+
+WideDirection::WideDirection(const Direction &direction) {
+  if (direction.IsEmpty()) {
+    // an empty direction widens to an empty direction
+    return;
+  }
+  read_ = std::string(1, direction.GetRead());
+  write_ = std::string(1, direction.GetWrite());
+  scanner_movement_ = direction.GetScannerMovement();
+  state_to_move_from_ = direction.GetStateToMoveFrom();
+  state_to_move_to_ = direction.GetStateToMoveTo();
+  is_empty_ = false;
+}
+
+bool WideDirection::IsEmpty() const {
+  return is_empty_;
+}
+
+const std::string &WideDirection::GetRead() const {
+  return read_;
+}
+
+const std::string &WideDirection::GetWrite() const {
+  return write_;
+}
+
+char WideDirection::GetScannerMovement() const {
+  return scanner_movement_;
+}
+
+State WideDirection::GetStateToMoveFrom() const {
+  return state_to_move_from_;
+}
+
+State WideDirection::GetStateToMoveTo() const {
+  return state_to_move_to_;
+}
+
+} // namespace turingmachinesimulator
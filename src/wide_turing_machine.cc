@@ -0,0 +1,335 @@
+#include "wide_turing_machine.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "configuration_formatter.h"
+
+namespace turingmachinesimulator {
+
+namespace {
+
+/**
+ * Class presenting a tape of symbol ids as a tape of the symbols they stand
+ * for, so the configuration formatters can print it
+ */
+template <typename Cell>
+class SymbolTapeView {
+  public:
+    /**
+     * This method creates a view of the symbols of the given tape
+     *
+     * @param tape a BasicTape of symbol ids
+     * @param symbol_table the SymbolTable the ids of the tape are from
+     */
+    SymbolTapeView(const BasicTape<Cell> &tape, const SymbolTable
+        &symbol_table)
+        : tape_(tape),
+          symbol_table_(symbol_table) {
+    }
+
+    size_t GetSize() const {
+      return tape_.GetSize();
+    }
+
+    size_t GetIndexOfScanner() const {
+      return tape_.GetIndexOfScanner();
+    }
+
+    const std::string &GetCell(size_t index) const {
+      return symbol_table_.GetSymbol(tape_.GetCell(index));
+    }
+
+  private:
+    /**
+     * BasicTape storing the ids of the symbols
+     */
+    const BasicTape<Cell> &tape_;
+
+    /**
+     * SymbolTable storing the symbols of the ids
+     */
+    const SymbolTable &symbol_table_;
+};
+
+/**
+ * This method returns the symbols of the given tape from left to right
+ *
+ * @param tape a BasicTape of symbol ids
+ * @param symbol_table the SymbolTable the ids of the tape are from
+ * @return a vector of strings representing the symbols of the tape
+ */
+template <typename Cell>
+std::vector<std::string> GetSymbolsOfTape(const BasicTape<Cell> &tape, const
+    SymbolTable &symbol_table) {
+  std::vector<std::string> symbols;
+  for (Cell symbol_id : tape.GetView()) {
+    symbols.push_back(symbol_table.GetSymbol(symbol_id));
+  }
+  return symbols;
+}
+
+} // namespace
+
+WideTuringMachine::WideTuringMachine(const std::vector<State> &states, const
+    std::vector<WideDirection> &directions, const std::vector<std::string>
+    &tape, const std::string &blank_symbol, const std::vector<std::string>
+    &halting_state_names) {
+  // set starting state
+  State starting_state = State();
+  for (const State &kState : states) {
+    const std::string kNameOfStartingState = "q1";
+    if (kState.GetStateName() == kNameOfStartingState) {
+      if (!starting_state.IsEmpty()) {
+        error_message_ = "Cannot Have More Than 1 Starting State";
+        return;
+      }
+      starting_state = kState;
+    }
+  }
+  if (starting_state.IsEmpty()) {
+    error_message_ = "Must Have Starting State";
+    return;
+  }
+
+  // give every state a dense index and every symbol a dense id, the blank
+  // symbol is interned first so that it is id 0
+  for (const State &kState : states) {
+    AddState(kState, halting_state_names);
+  }
+  symbol_table_.Intern(blank_symbol);
+  for (const WideDirection &kDirection : directions) {
+    if (kDirection.IsEmpty()) {
+      error_message_ = "Must Not Have Empty Directions";
+      return;
+    }
+    AddState(kDirection.GetStateToMoveFrom(), halting_state_names);
+    AddState(kDirection.GetStateToMoveTo(), halting_state_names);
+    symbol_table_.Intern(kDirection.GetRead());
+    symbol_table_.Intern(kDirection.GetWrite());
+  }
+  std::vector<SymbolId> tape_symbol_ids;
+  for (const std::string &kSymbol : tape) {
+    tape_symbol_ids.push_back(symbol_table_.Intern(kSymbol));
+  }
+
+  // fill in the table, which is only sized once the alphabet is known
+  alphabet_size_ = symbol_table_.GetSize();
+  transitions_.assign(states_.size() * alphabet_size_, WideTransition());
+  for (const WideDirection &kDirection : directions) {
+    WideTransition &transition = transitions_[GetStateIndex(
+        kDirection.GetStateToMoveFrom()) * alphabet_size_
+        + symbol_table_.GetId(kDirection.GetRead())];
+    if (transition.is_defined) {
+      error_message_ = "Must Not Have 2 Directions With Same Read Condition "
+          "From The Same State";
+      return;
+    }
+    transition.state_to_move_to = static_cast<uint32_t>(GetStateIndex(
+        kDirection.GetStateToMoveTo()));
+    transition.write = symbol_table_.GetId(kDirection.GetWrite());
+    const char kScannerMovement = kDirection.GetScannerMovement();
+    if (kScannerMovement == 'l') {
+      transition.scanner_offset = -1;
+    } else if (kScannerMovement == 'r') {
+      transition.scanner_offset = 1;
+    } else {
+      transition.scanner_offset = 0;
+    }
+    transition.is_defined = true;
+  }
+
+  // NOTE: the tape treats an empty tape as 1 blank symbol
+  // the cells of the tape are only as wide as the alphabet needs
+  is_tape_narrow_ = alphabet_size_ <= static_cast<size_t>(
+      std::numeric_limits<NarrowSymbolId>::max()) + 1;
+  if (is_tape_narrow_) {
+    narrow_tape_ = BasicTape<NarrowSymbolId>(std::vector<NarrowSymbolId>(
+        tape_symbol_ids.begin(), tape_symbol_ids.end()), 0);
+  } else {
+    tape_ = BasicTape<SymbolId>(tape_symbol_ids, 0);
+  }
+  current_state_index_ = GetStateIndex(starting_state);
+
+  // if no errors were encountered in initializing the machine, then it is not
+  // empty
+  is_empty_ = false;
+}
+
+State WideTuringMachine::GetCurrentState() const {
+  if (is_empty_) {
+    return State();
+  }
+  return states_[current_state_index_];
+}
+
+std::vector<std::string> WideTuringMachine::GetTape() const {
+  if (is_empty_) {
+    return std::vector<std::string>();
+  }
+  if (is_tape_narrow_) {
+    return GetSymbolsOfTape(narrow_tape_, symbol_table_);
+  }
+  return GetSymbolsOfTape(tape_, symbol_table_);
+}
+
+BasicTapeView<SymbolId> WideTuringMachine::GetTapeView() const {
+  if (is_tape_narrow_) {
+    return BasicTapeView<SymbolId>();
+  }
+  return tape_.GetView();
+}
+
+BasicTapeView<NarrowSymbolId> WideTuringMachine::GetNarrowTapeView() const {
+  if (!is_tape_narrow_) {
+    return BasicTapeView<NarrowSymbolId>();
+  }
+  return narrow_tape_.GetView();
+}
+
+bool WideTuringMachine::IsTapeNarrow() const {
+  return is_tape_narrow_;
+}
+
+const SymbolTable &WideTuringMachine::GetSymbolTable() const {
+  return symbol_table_;
+}
+
+size_t WideTuringMachine::GetIndexOfScanner() const {
+  if (is_tape_narrow_) {
+    return narrow_tape_.GetIndexOfScanner();
+  }
+  return tape_.GetIndexOfScanner();
+}
+
+uint64_t WideTuringMachine::GetNumberOfSteps() const {
+  return num_steps_;
+}
+
+std::string WideTuringMachine::GetErrorMessage() const {
+  return error_message_;
+}
+
+std::string WideTuringMachine::GetBlankSymbol() const {
+  if (is_empty_) {
+    return "";
+  }
+  return symbol_table_.GetSymbol(0);
+}
+
+bool WideTuringMachine::IsHalted() const {
+  return is_halted_;
+}
+
+bool WideTuringMachine::IsEmpty() const {
+  return is_empty_;
+}
+
+std::string WideTuringMachine::GetConfigurationForConsole() const {
+  if (is_empty_) {
+    return ";";
+  }
+  if (is_tape_narrow_) {
+    return FormatConfigurationForConsole(SymbolTapeView<NarrowSymbolId>(
+        narrow_tape_, symbol_table_), GetCurrentState());
+  }
+  return FormatConfigurationForConsole(SymbolTapeView<SymbolId>(tape_,
+      symbol_table_), GetCurrentState());
+}
+
+std::string WideTuringMachine::GetConfigurationForMarkdown() const {
+  if (is_empty_) {
+    return ";";
+  }
+  if (is_tape_narrow_) {
+    return FormatConfigurationForMarkdown(SymbolTapeView<NarrowSymbolId>(
+        narrow_tape_, symbol_table_), GetCurrentState());
+  }
+  return FormatConfigurationForMarkdown(SymbolTapeView<SymbolId>(tape_,
+      symbol_table_), GetCurrentState());
+}
+
+void WideTuringMachine::Update() {
+  // 1 step is the same as a run of up to 1 step
+  RunSteps(1, false);
+}
+
+RunResult WideTuringMachine::Run(uint64_t max_steps) {
+  return RunSteps(max_steps, false);
+}
+
+RunResult WideTuringMachine::RunUntilHalt(uint64_t step_budget) {
+  return RunSteps(step_budget, true);
+}
+
+void WideTuringMachine::AddState(const State &state, const
+    std::vector<std::string> &halting_state_names) {
+  if (state_index_by_id_.find(state.GetId()) != state_index_by_id_.end()) {
+    return;
+  }
+  state_index_by_id_[state.GetId()] = states_.size();
+  states_.push_back(state);
+  const bool kIsHaltingState = std::find(halting_state_names.begin(),
+      halting_state_names.end(), state.GetStateName())
+      != halting_state_names.end();
+  is_halting_by_state_index_.push_back(kIsHaltingState ? 1 : 0);
+}
+
+size_t WideTuringMachine::GetStateIndex(const State &state) const {
+  return state_index_by_id_.at(state.GetId());
+}
+
+RunResult WideTuringMachine::RunSteps(uint64_t max_steps, bool
+    stop_at_halting_state) {
+  if (is_empty_) {
+    // an empty wide turing machine has nothing to run
+    return RunResult();
+  }
+  if (is_tape_narrow_) {
+    return RunStepsOnTape(narrow_tape_, max_steps, stop_at_halting_state);
+  }
+  return RunStepsOnTape(tape_, max_steps, stop_at_halting_state);
+}
+
+template <typename Cell>
+RunResult WideTuringMachine::RunStepsOnTape(BasicTape<Cell> &tape, uint64_t
+    max_steps, bool stop_at_halting_state) {
+  RunResult result;
+
+  // the state and step count are kept in locals during the loop so the
+  // compiler can keep them in registers
+  const WideTransition *transitions = transitions_.data();
+  size_t state_index = current_state_index_;
+  bool is_halted = is_halted_;
+  uint64_t num_steps_taken = 0;
+  while (num_steps_taken < max_steps) {
+    if (stop_at_halting_state && is_halted) {
+      break;
+    }
+    const WideTransition &kTransition = transitions[state_index
+        * alphabet_size_ + tape.Read()];
+    if (!kTransition.is_defined) {
+      break;
+    }
+    tape.Write(static_cast<Cell>(kTransition.write));
+    if (kTransition.scanner_offset < 0) {
+      tape.MoveLeft();
+    } else if (kTransition.scanner_offset > 0) {
+      tape.MoveRight();
+    }
+    state_index = kTransition.state_to_move_to;
+    is_halted = is_halted || is_halting_by_state_index_[state_index] != 0;
+    num_steps_taken += 1;
+  }
+  current_state_index_ = state_index;
+  is_halted_ = is_halted;
+  num_steps_ += num_steps_taken;
+
+  result.num_steps = num_steps_taken;
+  result.is_halted = is_halted_;
+  result.final_state_id = states_[current_state_index_].GetId();
+  result.index_of_scanner = tape.GetIndexOfScanner();
+  return result;
+}
+
+} // namespace turingmachinesimulator
@@ -0,0 +1,208 @@
+#include <catch2/catch.hpp>
+
+#include "block_macro_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Block Macro Machine Is Correctly Created
+ * Block Macro Machine Matches The Turing Machine
+ * Block Transitions Are Reused
+ */
+TEST_CASE("Test Block Macro Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const Direction kDirection = Direction('-', '1', 'r', kStartingState,
+      kStartingState);
+  const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+      {kDirection}, {'-', '0'}, '-', kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    BlockMacroMachine block_macro_machine = BlockMacroMachine(TuringMachine(),
+        4);
+    REQUIRE(block_macro_machine.IsEmpty());
+    REQUIRE(block_macro_machine.Run(10).num_steps == 0);
+  }
+
+  SECTION("Test Block Size Of 0", "[initialization][empty]") {
+    const BlockMacroMachine kBlockMacroMachine = BlockMacroMachine(
+        kTuringMachine, 0);
+    REQUIRE(kBlockMacroMachine.IsEmpty());
+  }
+
+  SECTION("Test Block Too Large To Pack", "[initialization][empty]") {
+    // '-', '0' and '1' take 2 bits per cell, so 32 cells fill a block
+    REQUIRE(BlockMacroMachine(kTuringMachine, 32).IsEmpty() == false);
+    REQUIRE(BlockMacroMachine(kTuringMachine, 33).IsEmpty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const BlockMacroMachine kBlockMacroMachine = BlockMacroMachine(
+        kTuringMachine, 3);
+    REQUIRE(kBlockMacroMachine.IsEmpty() == false);
+    REQUIRE(kBlockMacroMachine.GetTape() == kTuringMachine.GetTape());
+    REQUIRE(kBlockMacroMachine.GetIndexOfScanner() == 0);
+    REQUIRE(kBlockMacroMachine.GetCurrentState().Equals(kStartingState));
+    REQUIRE(kBlockMacroMachine.GetNumberOfSteps() == 0);
+    REQUIRE(kBlockMacroMachine.IsHalted() == false);
+  }
+}
+
+TEST_CASE("Test Block Macro Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    // the 4 state busy beaver halts after 107 steps
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    for (size_t block_size = 1; block_size <= 5; block_size++) {
+      BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+          block_size);
+      const RunResult kResult = block_macro_machine.RunUntilHalt(1000);
+      REQUIRE(kResult.num_steps == 107);
+      REQUIRE(kResult.is_halted);
+      REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    }
+    BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+        4);
+    block_macro_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(block_macro_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(block_macro_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(block_macro_machine.GetNumberOfSteps() == 107);
+  }
+
+  SECTION("Test 5 State Busy Beaver", "[run][halt][chain]") {
+    // the 5 state busy beaver halts after 47176870 steps, most of them in
+    // sweeps across runs of identical blocks
+    const State kStateE = State(6, "q6", glm::vec2(0, 0), 5,
+        kHaltingStateNames);
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateC),
+        Direction('0', '1', 'r', kStateB, kStateC),
+        Direction('1', '1', 'r', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateC, kStateD),
+        Direction('1', '0', 'l', kStateC, kStateE),
+        Direction('0', '1', 'l', kStateD, kStateA),
+        Direction('1', '1', 'l', kStateD, kStateD),
+        Direction('0', '1', 'r', kStateE, kHaltingState),
+        Direction('1', '0', 'l', kStateE, kStateA)};
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB, kStateC,
+        kStateD, kStateE, kHaltingState}, kDirections, {'0'}, '0',
+        kHaltingStateNames);
+    BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+        16);
+    const RunResult kResult = block_macro_machine.RunUntilHalt(100000000);
+    turing_machine.RunUntilHalt(100000000);
+    REQUIRE(kResult.num_steps == 47176870);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(block_macro_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(block_macro_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    const TuringMachine kTuringMachine = TuringMachine(kStates, kDirections,
+        {'0'}, '-', kHaltingStateNames);
+    for (size_t block_size = 1; block_size <= 8; block_size++) {
+      TuringMachine turing_machine = kTuringMachine;
+      BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+          block_size);
+      // uneven budgets make runs end in the middle of blocks
+      const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000};
+      for (uint64_t budget : kBudgets) {
+        turing_machine.Run(budget);
+        const RunResult kResult = block_macro_machine.Run(budget);
+        REQUIRE(kResult.num_steps == budget);
+        REQUIRE(block_macro_machine.GetTape() == turing_machine.GetTape());
+        REQUIRE(block_macro_machine.GetIndexOfScanner()
+            == turing_machine.GetIndexOfScanner());
+        REQUIRE(block_macro_machine.GetCurrentState().Equals(
+            turing_machine.GetCurrentState()));
+      }
+    }
+  }
+
+  SECTION("Test Machine That Gets Stuck", "[run][stuck]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'l', kStateA, kStateA),
+        Direction('x', 'y', 'n', kStateA, kStateB)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'-', '-', '-', 'x'}, '-', kHaltingStateNames);
+    BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+        2);
+    const RunResult kResult = block_macro_machine.Run(50);
+    turing_machine.Run(50);
+    REQUIRE(kResult.num_steps == 50);
+    REQUIRE(block_macro_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(block_macro_machine.GetIndexOfScanner() == 0);
+
+    // a direction that does not apply stops the run early
+    TuringMachine stuck_turing_machine = TuringMachine(kStates, kDirections,
+        {'x', '-'}, '-', kHaltingStateNames);
+    BlockMacroMachine stuck_block_macro_machine = BlockMacroMachine(
+        stuck_turing_machine, 2);
+    const RunResult kStuckResult = stuck_block_macro_machine.Run(50);
+    REQUIRE(kStuckResult.num_steps == 1);
+    REQUIRE(kStuckResult.is_halted == false);
+    REQUIRE(kStuckResult.final_state_id == kStateB.GetId());
+    REQUIRE(stuck_block_macro_machine.GetTape() == std::vector<char>({'y',
+        '-'}));
+  }
+}
+
+TEST_CASE("Test Block Transitions Are Reused") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+
+  SECTION("Test Sweeping Over Identical Blocks", "[cache]") {
+    // sweeps right and left over a tape of 1's forever
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('-', '-', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, std::vector<char>(64, '1'), '-', kHaltingStateNames);
+    BlockMacroMachine block_macro_machine = BlockMacroMachine(turing_machine,
+        8);
+    block_macro_machine.Run(100000);
+    turing_machine.Run(100000);
+    REQUIRE(block_macro_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(block_macro_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(block_macro_machine.GetNumberOfCachedBlockTransitions() < 20);
+  }
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include "chunked_tape.h"
+#include "tape.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Chunked Tape Is Correctly Created
+ * Chunked Tape Matches A Tape Across Chunks
+ * Copies Of A Chunked Tape Share Chunks Until They Are Written
+ */
+TEST_CASE("Test Chunked Tape Creation") {
+  SECTION("Test Empty Chunked Tape", "[initialization][empty]") {
+    const ChunkedTape kTape = ChunkedTape({}, '-');
+    REQUIRE(kTape.GetCells() == std::vector<char>({'-'}));
+    REQUIRE(kTape.GetSize() == 1);
+    REQUIRE(kTape.GetIndexOfScanner() == 0);
+    REQUIRE(kTape.GetPositionOfScanner() == 0);
+    REQUIRE(kTape.GetBlankCharacter() == '-');
+    REQUIRE(kTape.GetNumberOfChunks() == 1);
+  }
+
+  SECTION("Test Tape Longer Than A Chunk", "[initialization]") {
+    std::vector<char> cells;
+    for (size_t i = 0; i < ChunkedTape::kCellsPerChunk * 2 + 5; i++) {
+      cells.push_back(static_cast<char>('a' + i % 26));
+    }
+    const ChunkedTape kTape = ChunkedTape(cells, '-', 4100, 7);
+    REQUIRE(kTape.GetCells() == cells);
+    REQUIRE(kTape.GetNumberOfChunks() == 3);
+    REQUIRE(kTape.GetCell(4097) == cells[4097]);
+    REQUIRE(kTape.Read() == cells[4100]);
+    REQUIRE(kTape.GetIndexOfScanner() == 4100);
+    REQUIRE(kTape.GetPositionOfScanner() == 7);
+  }
+}
+
+TEST_CASE("Test Chunked Tape Matches A Tape Across Chunks") {
+  ChunkedTape chunked_tape = ChunkedTape({'0', '1'}, '-');
+  Tape tape = Tape({'0', '1'}, '-');
+
+  SECTION("Test Growing And Writing At Both Ends", "[tape expansion]") {
+    // zig-zags further out each time, so the tape grows by several chunks at
+    // both ends
+    for (size_t i = 1; i < 12000; i += 1000) {
+      for (size_t j = 0; j < i; j++) {
+        chunked_tape.Write(static_cast<char>('a' + j % 3));
+        chunked_tape.MoveRight();
+        tape.Write(static_cast<char>('a' + j % 3));
+        tape.MoveRight();
+      }
+      for (size_t j = 0; j < 2 * i; j++) {
+        chunked_tape.MoveLeft();
+        tape.MoveLeft();
+      }
+      REQUIRE(chunked_tape.Read() == tape.Read());
+      REQUIRE(chunked_tape.GetIndexOfScanner() == tape.GetIndexOfScanner());
+      REQUIRE(chunked_tape.GetPositionOfScanner()
+          == tape.GetPositionOfScanner());
+    }
+    REQUIRE(chunked_tape.GetCells() == tape.GetCells());
+    REQUIRE(chunked_tape.GetSize() == tape.GetSize());
+  }
+
+  SECTION("Test Skipping Across Chunks", "[skip]") {
+    const std::vector<char> kCells(10000, '1');
+    chunked_tape = ChunkedTape(kCells, '-');
+    REQUIRE(chunked_tape.SkipRight('1', 20000) == 9999);
+    REQUIRE(chunked_tape.GetIndexOfScanner() == 9999);
+    REQUIRE(chunked_tape.SkipLeft('1', 5000) == 5000);
+    REQUIRE(chunked_tape.GetIndexOfScanner() == 4999);
+    REQUIRE(chunked_tape.SkipLeft('0', 5000) == 0);
+  }
+}
+
+TEST_CASE("Test Copies Of A Chunked Tape Share Chunks") {
+  const std::vector<char> kCells(ChunkedTape::kCellsPerChunk * 4, '0');
+  ChunkedTape tape = ChunkedTape(kCells, '-');
+  REQUIRE(tape.GetNumberOfOwnedChunks() == 4);
+
+  SECTION("Test Copy Shares Every Chunk", "[copy]") {
+    const ChunkedTape kCopy = tape;
+    REQUIRE(tape.GetNumberOfOwnedChunks() == 0);
+    REQUIRE(kCopy.GetNumberOfOwnedChunks() == 0);
+    REQUIRE(kCopy.GetCells() == kCells);
+  }
+
+  SECTION("Test Writing Copies Only The Chunk Written", "[copy][write]") {
+    const ChunkedTape kCopy = tape;
+    tape.Write('1');
+    REQUIRE(tape.GetNumberOfOwnedChunks() == 1);
+    REQUIRE(kCopy.GetNumberOfOwnedChunks() == 1);
+    REQUIRE(tape.Read() == '1');
+    REQUIRE(kCopy.Read() == '0');
+    REQUIRE(kCopy.GetCells() == kCells);
+  }
+
+  SECTION("Test Writing The Same Character Keeps Chunks Shared", "[copy]") {
+    const ChunkedTape kCopy = tape;
+    tape.Write('0');
+    REQUIRE(tape.GetNumberOfOwnedChunks() == 0);
+  }
+
+  SECTION("Test Headroom Is Shared Until Written", "[copy][tape expansion]") {
+    tape = ChunkedTape({}, '-');
+    tape.MoveLeft();
+    REQUIRE(tape.GetNumberOfChunks() == 2);
+    REQUIRE(tape.GetNumberOfOwnedChunks() == 1);
+    tape.Write('x');
+    REQUIRE(tape.GetNumberOfOwnedChunks() == 2);
+    REQUIRE(tape.GetCells() == std::vector<char>({'x', '-'}));
+  }
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+#include "chunked_tape_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Chunked Tape Machine Is Correctly Created
+ * Chunked Tape Machine Matches The Turing Machine
+ * Copies Of A Chunked Tape Machine Run Independently
+ */
+TEST_CASE("Test Chunked Tape Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    ChunkedTapeMachine chunked_tape_machine = ChunkedTapeMachine(
+        TuringMachine());
+    REQUIRE(chunked_tape_machine.IsEmpty());
+    REQUIRE(chunked_tape_machine.Run(10).num_steps == 0);
+    REQUIRE(chunked_tape_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    TuringMachine turing_machine = TuringMachine({kStartingState},
+        {Direction('a', 'a', 'r', kStartingState, kStartingState)}, kTape, '-',
+        kHaltingStateNames);
+    turing_machine.Run(2);
+    const ChunkedTapeMachine kChunkedTapeMachine = ChunkedTapeMachine(
+        turing_machine);
+    REQUIRE(kChunkedTapeMachine.IsEmpty() == false);
+    REQUIRE(kChunkedTapeMachine.GetTape() == kTape);
+    REQUIRE(kChunkedTapeMachine.GetIndexOfScanner() == 1);
+    REQUIRE(kChunkedTapeMachine.GetPositionOfScanner() == 1);
+    REQUIRE(kChunkedTapeMachine.GetNumberOfSteps() == 1);
+    REQUIRE(kChunkedTapeMachine.GetCurrentState().Equals(kStartingState));
+  }
+
+  SECTION("Test Configuration Of A Trimmed Tape Is Copied",
+      "[initialization][trim]") {
+    // drifts right forever leaving only blanks behind, so the trimmed tape
+    // starts far to the right of the cell the machine started on
+    const State kStateTwo = State(2, "q2", glm::vec2(1, 1), 5,
+        kHaltingStateNames);
+    TuringMachine turing_machine = TuringMachine({kStartingState, kStateTwo},
+        {Direction('-', '1', 'r', kStartingState, kStateTwo),
+        Direction('-', '-', 'l', kStateTwo, kStateTwo),
+        Direction('1', '-', 'r', kStateTwo, kStartingState)}, {}, '-',
+        kHaltingStateNames);
+    turing_machine.SetMaxBlankMargin(8);
+    turing_machine.Run(10000);
+    ChunkedTapeMachine chunked_tape_machine = ChunkedTapeMachine(
+        turing_machine);
+    REQUIRE(chunked_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    chunked_tape_machine.Run(100);
+    turing_machine.Run(100);
+    REQUIRE(chunked_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+  }
+}
+
+TEST_CASE("Test Chunked Tape Machine Runs") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    ChunkedTapeMachine chunked_tape_machine = ChunkedTapeMachine(
+        turing_machine);
+    const RunResult kResult = chunked_tape_machine.RunUntilHalt(1000);
+    const RunResult kExpectedResult = turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kExpectedResult.final_state_id);
+    REQUIRE(kResult.index_of_scanner == kExpectedResult.index_of_scanner);
+    REQUIRE(chunked_tape_machine.GetTape() == turing_machine.GetTape());
+  }
+
+  SECTION("Test Forked Runs Diverge Without Sharing Writes", "[run][copy]") {
+    // writes 1s moving right forever, crossing many chunks
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA)};
+    TuringMachine turing_machine = TuringMachine({kStateA}, kDirections,
+        {'0'}, '0', kHaltingStateNames);
+    ChunkedTapeMachine chunked_tape_machine = ChunkedTapeMachine(
+        turing_machine);
+    chunked_tape_machine.Run(100000);
+    const ChunkedTapeMachine kSnapshot = chunked_tape_machine;
+    chunked_tape_machine.Run(10);
+    // only the chunk the scanner was in has been copied
+    REQUIRE(chunked_tape_machine.GetChunkedTape().GetNumberOfChunks()
+        - chunked_tape_machine.GetChunkedTape().GetNumberOfOwnedChunks()
+        >= chunked_tape_machine.GetChunkedTape().GetNumberOfChunks() - 2);
+    REQUIRE(kSnapshot.GetNumberOfSteps() == 100000);
+    REQUIRE(kSnapshot.GetTape().size() == 100001);
+    REQUIRE(chunked_tape_machine.GetTape().size() == 100011);
+    turing_machine.Run(100010);
+    REQUIRE(chunked_tape_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(chunked_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+  }
+}
@@ -0,0 +1,300 @@
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <thread>
+
+#include "execution_context.h"
+#include "turing_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Execution Context Is Correctly Created
+ * Execution Contexts Sharing A Program Run Independently
+ * Step Events Describe Every Change
+ * Fused Transitions Take The Same Steps As Single Transitions
+ */
+TEST_CASE("Test Execution Context Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Default Constructor", "[initialization][empty]") {
+    ExecutionContext execution_context = ExecutionContext();
+    REQUIRE(execution_context.IsEmpty());
+    REQUIRE(execution_context.Run(10).num_steps == 0);
+  }
+
+  SECTION("Test Empty Program Keeps Its Tape", "[initialization][empty]") {
+    const ExecutionContext kExecutionContext = ExecutionContext(
+        std::make_shared<const Program>(), {'a', 'b'}, '-');
+    REQUIRE(kExecutionContext.IsEmpty());
+    REQUIRE(kExecutionContext.GetTape() == std::vector<char>({'a', 'b'}));
+    REQUIRE(kExecutionContext.GetCurrentState().IsEmpty());
+  }
+
+  SECTION("Test Starts In The Starting State", "[initialization]") {
+    const std::shared_ptr<const Program> kProgram =
+        std::make_shared<const Program>(std::vector<State>({kStartingState}),
+        std::vector<Direction>(), kHaltingStateNames);
+    const ExecutionContext kExecutionContext = ExecutionContext(kProgram,
+        {'a'}, '-');
+    REQUIRE(kExecutionContext.IsEmpty() == false);
+    REQUIRE(kExecutionContext.GetCurrentState().Equals(kStartingState));
+    REQUIRE(kExecutionContext.GetProgram() == kProgram);
+    REQUIRE(kExecutionContext.GetConfigurationForConsole() == ";q1a");
+  }
+}
+
+TEST_CASE("Test Execution Contexts Sharing A Program Run Independently") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // adds 1 to a binary number, with the scanner starting on its first digit
+  const std::vector<State> kStates = {kStateA, kStateB, kHaltingState};
+  const std::vector<Direction> kDirections = {
+      Direction('0', '0', 'r', kStateA, kStateA),
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('-', '-', 'l', kStateA, kStateB),
+      Direction('1', '0', 'l', kStateB, kStateB),
+      Direction('0', '1', 'n', kStateB, kHaltingState),
+      Direction('-', '1', 'n', kStateB, kHaltingState)};
+  const std::shared_ptr<const Program> kProgram =
+      std::make_shared<const Program>(kStates, kDirections,
+      kHaltingStateNames);
+  const std::vector<std::vector<char>> kTapes = {{'0'}, {'1'}, {'1', '0'},
+      {'1', '1'}, {'1', '0', '1', '1'}, {'1', '1', '1', '1', '1'}};
+
+  SECTION("Test Contexts Match Separate Turing Machines", "[run][shared]") {
+    for (const std::vector<char> &kTape : kTapes) {
+      ExecutionContext execution_context = ExecutionContext(kProgram, kTape,
+          '-');
+      TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+          kTape, '-', kHaltingStateNames);
+      execution_context.RunUntilHalt(1000);
+      turing_machine.RunUntilHalt(1000);
+      REQUIRE(execution_context.IsHalted());
+      REQUIRE(execution_context.GetTape() == turing_machine.GetTape());
+      REQUIRE(execution_context.GetNumberOfSteps()
+          == turing_machine.GetNumberOfSteps());
+    }
+  }
+
+  SECTION("Test Contexts Run On Many Threads At Once", "[run][threads]") {
+    std::vector<ExecutionContext> execution_contexts;
+    for (const std::vector<char> &kTape : kTapes) {
+      execution_contexts.push_back(ExecutionContext(kProgram, kTape, '-'));
+    }
+    std::vector<std::thread> threads;
+    for (ExecutionContext &execution_context : execution_contexts) {
+      threads.push_back(std::thread([&execution_context]() {
+        execution_context.RunUntilHalt(1000);
+      }));
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    REQUIRE(execution_contexts[0].GetTape() == std::vector<char>({'1', '-'}));
+    REQUIRE(execution_contexts[3].GetTape() == std::vector<char>({'1', '0',
+        '0', '-'}));
+    REQUIRE(execution_contexts[5].GetTape() == std::vector<char>({'1', '0',
+        '0', '0', '0', '0', '-'}));
+  }
+
+  SECTION("Test Turing Machines Share A Program", "[run][shared]") {
+    const TuringMachine kTuringMachine = TuringMachine(kProgram, {'1'}, '-');
+    const TuringMachine kCopy = kTuringMachine;
+    REQUIRE(kCopy.GetProgram() == kProgram);
+    REQUIRE(kCopy.GetCurrentState().Equals(kStateA));
+  }
+}
+
+TEST_CASE("Test Step Events Describe Every Change") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kHaltingState};
+
+  SECTION("Test Events Of Each Kind", "[events]") {
+    // step 1 writes and moves left past the start of the tape, step 2 only
+    // changes state, step 3 halts without writing or moving
+    const std::vector<Direction> kDirections = {
+        Direction('a', 'b', 'l', kStateA, kStateA),
+        Direction('-', '-', 'n', kStateA, kStateB),
+        Direction('-', '-', 'n', kStateB, kHaltingState)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'a'},
+        '-', kHaltingStateNames);
+    std::vector<StepEvent> events;
+    turing_machine.Subscribe([&events](const std::vector<StepEvent> &batch) {
+      events.insert(events.end(), batch.begin(), batch.end());
+    });
+    REQUIRE(turing_machine.Run(10).num_steps == 3);
+    REQUIRE(events.size() == 5);
+    REQUIRE(events[0].type == StepEventType::kWrite);
+    REQUIRE(events[0].step == 1);
+    REQUIRE(events[0].position == 0);
+    REQUIRE(events[0].character == 'b');
+    REQUIRE(events[1].type == StepEventType::kMove);
+    REQUIRE(events[1].position == -1);
+    REQUIRE(events[2].type == StepEventType::kStateChange);
+    REQUIRE(events[2].step == 2);
+    REQUIRE(turing_machine.GetTransitionTable().GetState(
+        events[2].state_index).Equals(kStateB));
+    REQUIRE(events[3].type == StepEventType::kStateChange);
+    REQUIRE(events[4].type == StepEventType::kHalt);
+    REQUIRE(events[4].step == 3);
+  }
+
+  SECTION("Test Events Rebuild The Tape", "[events][run]") {
+    // sweeps back and forth, making the tape 1 cell longer on each pass
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '1', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {},
+        '-', kHaltingStateNames);
+    std::map<int64_t, char> cells_written;
+    int64_t position_of_scanner = 0;
+    size_t num_batches = 0;
+    turing_machine.Subscribe([&](const std::vector<StepEvent> &batch) {
+      num_batches += 1;
+      for (const StepEvent &kEvent : batch) {
+        if (kEvent.type == StepEventType::kWrite) {
+          cells_written[kEvent.position] = kEvent.character;
+        } else if (kEvent.type == StepEventType::kMove) {
+          position_of_scanner = kEvent.position;
+        }
+      }
+    });
+    turing_machine.Run(20000);
+    for (size_t i = 0; i < 5; i++) {
+      turing_machine.Update();
+    }
+    REQUIRE(num_batches > 2);
+    REQUIRE(position_of_scanner == turing_machine.GetPositionOfScanner());
+    const std::vector<char> kTape = turing_machine.GetTape();
+    const int64_t kPositionOfFirstCell = turing_machine.GetPositionOfScanner()
+        - static_cast<int64_t>(turing_machine.GetIndexOfScanner());
+    for (const std::pair<const int64_t, char> &kCell : cells_written) {
+      REQUIRE(kTape[kCell.first - kPositionOfFirstCell] == kCell.second);
+    }
+    REQUIRE(cells_written.size() == kTape.size());
+  }
+
+  SECTION("Test Unsubscribed Listener", "[events]") {
+    TuringMachine turing_machine = TuringMachine(kStates,
+        {Direction('-', '1', 'r', kStateA, kStateA)}, {}, '-',
+        kHaltingStateNames);
+    size_t num_events = 0;
+    const size_t kSubscriptionId = turing_machine.Subscribe(
+        [&num_events](const std::vector<StepEvent> &batch) {
+      num_events += batch.size();
+    });
+    turing_machine.Run(10);
+    REQUIRE(num_events == 20);
+    turing_machine.Unsubscribe(kSubscriptionId);
+    turing_machine.Run(10);
+    REQUIRE(num_events == 20);
+    REQUIRE(turing_machine.GetNumberOfSteps() == 20);
+  }
+
+  SECTION("Test Copies Do Not Notify The Original Listeners", "[events]") {
+    TuringMachine turing_machine = TuringMachine(kStates,
+        {Direction('-', '1', 'r', kStateA, kStateA)}, {}, '-',
+        kHaltingStateNames);
+    size_t num_events = 0;
+    turing_machine.Subscribe([&num_events](const std::vector<StepEvent>
+        &batch) {
+      num_events += batch.size();
+    });
+    TuringMachine copied_turing_machine = turing_machine;
+    copied_turing_machine.Run(5);
+    REQUIRE(num_events == 0);
+    REQUIRE(copied_turing_machine.GetNumberOfSteps() == 5);
+    TuringMachine assigned_turing_machine;
+    assigned_turing_machine = turing_machine;
+    assigned_turing_machine.Run(5);
+    REQUIRE(num_events == 0);
+    // the copies start counting subscription ids afresh
+    REQUIRE(copied_turing_machine.Subscribe([](const std::vector<StepEvent>
+        &) {}) == 0);
+    turing_machine.Run(5);
+    REQUIRE(num_events == 10);
+  }
+}
+
+TEST_CASE("Test Fused Transitions Take The Same Steps As Single Transitions") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kJumpState = State(3, "q3", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(4, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // A turns a 0 into a 1 by way of B without moving, then moves right
+  // through the jump state, until it reaches a blank
+  const std::shared_ptr<const Program> kProgram =
+      std::make_shared<const Program>(std::vector<State>({kStateA, kStateB,
+      kJumpState, kHaltingState}), std::vector<Direction>({
+      Direction('0', '2', 'n', kStateA, kStateB),
+      Direction('2', '1', 'r', kStateB, kJumpState),
+      Direction('1', '1', 'r', kStateA, kJumpState),
+      Direction('0', '0', 'n', kJumpState, kStateA),
+      Direction('1', '1', 'n', kJumpState, kStateA),
+      Direction('2', '2', 'n', kJumpState, kStateA),
+      Direction('-', '-', 'n', kJumpState, kStateA),
+      Direction('-', '-', 'n', kStateA, kHaltingState)}),
+      kHaltingStateNames);
+  // listeners need every step, so a context with 1 takes single transitions
+  const StepEventListener kListener = [](const std::vector<StepEvent> &) {};
+
+  SECTION("Test Runs To Halting", "[fuse][run]") {
+    const std::vector<char> kTape = {'0', '1', '0', '0', '1'};
+    ExecutionContext execution_context = ExecutionContext(kProgram, kTape,
+        '-');
+    ExecutionContext single_execution_context = ExecutionContext(kProgram,
+        kTape, '-');
+    single_execution_context.Subscribe(kListener);
+    const RunResult kResult = execution_context.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps
+        == single_execution_context.RunUntilHalt(1000).num_steps);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(execution_context.GetTape() == single_execution_context.GetTape());
+  }
+
+  SECTION("Test Step Budgets Inside Chains", "[fuse][run]") {
+    const std::vector<char> kTape = {'0', '0', '1', '0'};
+    ExecutionContext single_execution_context = ExecutionContext(kProgram,
+        kTape, '-');
+    single_execution_context.Subscribe(kListener);
+    for (uint64_t num_steps = 0; num_steps < 20; num_steps++) {
+      ExecutionContext execution_context = ExecutionContext(kProgram, kTape,
+          '-');
+      REQUIRE(execution_context.Run(num_steps).num_steps
+          == single_execution_context.GetNumberOfSteps());
+      REQUIRE(execution_context.GetCurrentStateIndex()
+          == single_execution_context.GetCurrentStateIndex());
+      REQUIRE(execution_context.GetTape()
+          == single_execution_context.GetTape());
+      single_execution_context.Run(1);
+    }
+  }
+
+  SECTION("Test Jump State Stops On Unread Character", "[fuse][jump]") {
+    ExecutionContext execution_context = ExecutionContext(kProgram, {'1',
+        'x'}, '-');
+    REQUIRE(execution_context.Run(100).num_steps == 1);
+    REQUIRE(execution_context.GetCurrentStateIndex() == 2);
+    REQUIRE(execution_context.GetIndexOfScanner() == 1);
+  }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "mapped_tape.h"
+#include "tape.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Mapped Tape Is Correctly Created
+ * Mapped Tape Matches A Tape While Chunks Are Paged Out
+ * Mapped Tape Maps Its Starting Cells From A File
+ */
+TEST_CASE("Test Mapped Tape Creation") {
+  MappedTapeOptions options;
+  options.chunk_shift = 12;
+  options.max_resident_chunks = 2;
+
+  SECTION("Test Empty Mapped Tape", "[initialization][empty]") {
+    const MappedTape kTape = MappedTape(std::vector<char>(), '-', options);
+    REQUIRE(kTape.IsEmpty() == false);
+    REQUIRE(kTape.GetCells() == std::vector<char>({'-'}));
+    REQUIRE(kTape.GetSize() == 1);
+    REQUIRE(kTape.GetIndexOfScanner() == 0);
+    REQUIRE(kTape.GetPositionOfScanner() == 0);
+    REQUIRE(kTape.GetBlankCharacter() == '-');
+    REQUIRE(kTape.GetNumberOfResidentChunks() == 1);
+  }
+
+  SECTION("Test Default Mapped Tape", "[initialization][empty]") {
+    const MappedTape kTape;
+    REQUIRE(kTape.IsEmpty());
+    REQUIRE(kTape.GetSize() == 0);
+  }
+
+  SECTION("Test Chunk Is At Least A Page", "[initialization]") {
+    options.chunk_shift = 1;
+    const MappedTape kTape = MappedTape({'0', '1'}, '-', options);
+    REQUIRE(kTape.GetNumberOfCellsPerChunk() >= 4096);
+    REQUIRE(kTape.GetCells() == std::vector<char>({'0', '1'}));
+  }
+
+  SECTION("Test Missing Scratch Directory", "[initialization][error]") {
+    options.scratch_directory = "/this/directory/does/not/exist";
+    const MappedTape kTape = MappedTape({'0', '1'}, '-', options);
+    REQUIRE(kTape.IsEmpty());
+    REQUIRE(kTape.GetErrorMessage() == "Could Not Create Scratch File");
+  }
+
+  SECTION("Test Moved Tape Keeps Its Cells", "[initialization]") {
+    MappedTape tape = MappedTape({'a', 'b', 'c'}, '-', 1, 0, options);
+    const MappedTape kMovedTape = std::move(tape);
+    REQUIRE(tape.IsEmpty());
+    REQUIRE(kMovedTape.GetCells() == std::vector<char>({'a', 'b', 'c'}));
+    REQUIRE(kMovedTape.Read() == 'b');
+  }
+}
+
+TEST_CASE("Test Mapped Tape Matches A Tape") {
+  MappedTapeOptions options;
+  options.chunk_shift = 12;
+  options.max_resident_chunks = 2;
+  MappedTape mapped_tape = MappedTape({'0', '1'}, '-', options);
+  Tape tape = Tape({'0', '1'}, '-');
+
+  SECTION("Test Growing And Writing At Both Ends", "[tape expansion]") {
+    // zig-zags further out each time, so the tape spans many more chunks
+    // than can be mapped at once
+    for (size_t i = 1; i < 30000; i += 3000) {
+      for (size_t j = 0; j < i; j++) {
+        mapped_tape.Write(static_cast<char>('a' + j % 3));
+        mapped_tape.MoveRight();
+        tape.Write(static_cast<char>('a' + j % 3));
+        tape.MoveRight();
+      }
+      for (size_t j = 0; j < 2 * i; j++) {
+        mapped_tape.MoveLeft();
+        tape.MoveLeft();
+      }
+      REQUIRE(mapped_tape.Read() == tape.Read());
+      REQUIRE(mapped_tape.GetIndexOfScanner() == tape.GetIndexOfScanner());
+      REQUIRE(mapped_tape.GetPositionOfScanner()
+          == tape.GetPositionOfScanner());
+      REQUIRE(mapped_tape.GetNumberOfResidentChunks() <= 2);
+    }
+    REQUIRE(mapped_tape.HasFailed() == false);
+    REQUIRE(mapped_tape.GetCells() == tape.GetCells());
+    REQUIRE(mapped_tape.GetCell(12345) == tape.GetCell(12345));
+    REQUIRE(mapped_tape.GetSize() == tape.GetSize());
+  }
+}
+
+TEST_CASE("Test Mapped Tape From A File") {
+  MappedTapeOptions options;
+  options.chunk_shift = 12;
+  options.max_resident_chunks = 1;
+  const std::string kInputPath = "test_mapped_tape_input.txt";
+  std::vector<char> cells;
+  for (size_t i = 0; i < 4096 * 3 + 100; i++) {
+    cells.push_back(static_cast<char>('0' + i % 10));
+  }
+  {
+    std::ofstream input_file(kInputPath, std::ios::binary);
+    input_file.write(cells.data(), static_cast<std::streamsize>(
+        cells.size()));
+  }
+
+  SECTION("Test Cells Come From The File", "[file]") {
+    const MappedTape kTape = MappedTape::FromFile(kInputPath, '-', options);
+    REQUIRE(kTape.IsEmpty() == false);
+    REQUIRE(kTape.GetCells() == cells);
+    REQUIRE(kTape.GetCell(4096 * 3 + 99) == cells.back());
+  }
+
+  SECTION("Test Writes Never Reach The File", "[file][write]") {
+    MappedTape tape = MappedTape::FromFile(kInputPath, '-', options);
+    // write every cell, leaving each chunk so that it is paged out
+    for (size_t i = 0; i < cells.size(); i++) {
+      tape.Write('x');
+      tape.MoveRight();
+    }
+    // moving past the last cell added a blank cell
+    std::vector<char> written_cells(cells.size(), 'x');
+    written_cells.push_back('-');
+    REQUIRE(tape.GetCells() == written_cells);
+    const MappedTape kFreshTape = MappedTape::FromFile(kInputPath, '-',
+        options);
+    REQUIRE(kFreshTape.GetCells() == cells);
+  }
+
+  SECTION("Test Missing File", "[file][error]") {
+    const MappedTape kTape = MappedTape::FromFile("missing_file.txt", '-',
+        options);
+    REQUIRE(kTape.IsEmpty());
+    REQUIRE(kTape.GetErrorMessage() == "Could Not Open Input File");
+  }
+  std::remove(kInputPath.c_str());
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch.hpp>
+
+#include "mapped_tape_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Mapped Tape Machine Is Correctly Created
+ * Mapped Tape Machine Matches The Turing Machine
+ */
+TEST_CASE("Test Mapped Tape Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  MappedTapeOptions options;
+  options.chunk_shift = 12;
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    MappedTapeMachine mapped_tape_machine = MappedTapeMachine(
+        TuringMachine(), options);
+    REQUIRE(mapped_tape_machine.IsEmpty());
+    REQUIRE(mapped_tape_machine.Run(10).num_steps == 0);
+    REQUIRE(mapped_tape_machine.GetTape().empty());
+    REQUIRE(mapped_tape_machine.GetConfigurationForConsole().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    TuringMachine turing_machine = TuringMachine({kStartingState},
+        {Direction('a', 'a', 'r', kStartingState, kStartingState)}, kTape, '-',
+        kHaltingStateNames);
+    turing_machine.Run(2);
+    const MappedTapeMachine kMappedTapeMachine = MappedTapeMachine(
+        turing_machine, options);
+    REQUIRE(kMappedTapeMachine.IsEmpty() == false);
+    REQUIRE(kMappedTapeMachine.GetTape() == kTape);
+    REQUIRE(kMappedTapeMachine.GetIndexOfScanner() == 1);
+    REQUIRE(kMappedTapeMachine.GetNumberOfSteps() == 1);
+    REQUIRE(kMappedTapeMachine.GetCurrentState().Equals(kStartingState));
+    REQUIRE(kMappedTapeMachine.GetConfigurationForConsole()
+        == turing_machine.GetConfigurationForConsole());
+    REQUIRE(kMappedTapeMachine.GetConfigurationForMarkdown()
+        == turing_machine.GetConfigurationForMarkdown());
+  }
+
+  SECTION("Test Configuration Of A Trimmed Tape Is Copied",
+      "[initialization][trim]") {
+    // drifts right forever leaving only blanks behind, so the trimmed tape
+    // starts far to the right of the cell the machine started on
+    const State kStateTwo = State(2, "q2", glm::vec2(1, 1), 5,
+        kHaltingStateNames);
+    TuringMachine turing_machine = TuringMachine({kStartingState, kStateTwo},
+        {Direction('-', '1', 'r', kStartingState, kStateTwo),
+        Direction('-', '-', 'l', kStateTwo, kStateTwo),
+        Direction('1', '-', 'r', kStateTwo, kStartingState)}, {}, '-',
+        kHaltingStateNames);
+    turing_machine.SetMaxBlankMargin(8);
+    turing_machine.Run(10000);
+    MappedTapeMachine mapped_tape_machine = MappedTapeMachine(turing_machine,
+        options);
+    REQUIRE(mapped_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    mapped_tape_machine.Run(100);
+    turing_machine.Run(100);
+    REQUIRE(mapped_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+  }
+
+  SECTION("Test Tape That Could Not Be Created", "[initialization][error]") {
+    options.scratch_directory = "/this/directory/does/not/exist";
+    const MappedTapeMachine kMappedTapeMachine = MappedTapeMachine(
+        TuringMachine({kStartingState}, {}, {'a'}, '-', kHaltingStateNames),
+        options);
+    REQUIRE(kMappedTapeMachine.IsEmpty());
+    REQUIRE(kMappedTapeMachine.GetErrorMessage()
+        == "Could Not Create Scratch File");
+  }
+}
+
+TEST_CASE("Test Mapped Tape Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+  MappedTapeOptions options;
+  options.chunk_shift = 12;
+  options.max_resident_chunks = 2;
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    MappedTapeMachine mapped_tape_machine = MappedTapeMachine(turing_machine,
+        options);
+    const RunResult kResult = mapped_tape_machine.RunUntilHalt(1000);
+    const RunResult kExpectedResult = turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kExpectedResult.final_state_id);
+    REQUIRE(kResult.index_of_scanner == kExpectedResult.index_of_scanner);
+    REQUIRE(mapped_tape_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(mapped_tape_machine.GetConfigurationForConsole()
+        == turing_machine.GetConfigurationForConsole());
+  }
+
+  SECTION("Test Sweeping Over Many Chunks", "[run][left][right]") {
+    // sweeps back and forth forever, adding a 1 at each end of the tape, so
+    // every sweep pages every chunk in and out
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('0', '1', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, std::vector<char>(10000, '1'), '0', kHaltingStateNames);
+    MappedTapeMachine mapped_tape_machine = MappedTapeMachine(turing_machine,
+        options);
+    const RunResult kResult = mapped_tape_machine.Run(200000);
+    const RunResult kExpectedResult = turing_machine.Run(200000);
+    REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+    REQUIRE(kResult.final_state_id == kExpectedResult.final_state_id);
+    REQUIRE(mapped_tape_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    REQUIRE(mapped_tape_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(mapped_tape_machine.GetMappedTape().GetNumberOfResidentChunks()
+        <= 2);
+  }
+}
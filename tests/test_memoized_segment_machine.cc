@@ -0,0 +1,253 @@
+#include <catch2/catch.hpp>
+
+#include "memoized_segment_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Memoized Segment Machine Is Correctly Created
+ * Memoized Segment Machine Matches The Turing Machine
+ * Very Long Runs Of Regular Machines Finish
+ * Segments And Memoized Results Stay Within The Max Table Size
+ */
+TEST_CASE("Test Memoized Segment Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const Direction kDirection = Direction('-', '1', 'r', kStartingState,
+      kStartingState);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        TuringMachine());
+    REQUIRE(memoized_segment_machine.IsEmpty());
+    REQUIRE(memoized_segment_machine.Run(10).num_steps == 0);
+    REQUIRE(memoized_segment_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, kTape, '-', kHaltingStateNames);
+    const MemoizedSegmentMachine kMemoizedSegmentMachine =
+        MemoizedSegmentMachine(kTuringMachine);
+    REQUIRE(kMemoizedSegmentMachine.IsEmpty() == false);
+    REQUIRE(kMemoizedSegmentMachine.GetTape() == kTape);
+    REQUIRE(kMemoizedSegmentMachine.GetIndexOfScanner() == 0);
+    REQUIRE(kMemoizedSegmentMachine.GetCurrentState().Equals(kStartingState));
+  }
+
+  SECTION("Test Identical Segments Are Shared", "[initialization][segments]") {
+    // 8 blank cells are 1 cell segment, then 1 segment for each level above
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, std::vector<char>(8, '-'), '-', kHaltingStateNames);
+    const MemoizedSegmentMachine kMemoizedSegmentMachine =
+        MemoizedSegmentMachine(kTuringMachine);
+    REQUIRE(kMemoizedSegmentMachine.GetNumberOfSegments() == 4);
+  }
+}
+
+TEST_CASE("Test Memoized Segment Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        turing_machine);
+    const RunResult kResult = memoized_segment_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(memoized_segment_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(memoized_segment_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'0', '1', '1'}, '-', kHaltingStateNames);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        turing_machine);
+    // uneven budgets make runs end in the middle of segments
+    const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000, 65536};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      const RunResult kResult = memoized_segment_machine.Run(budget);
+      REQUIRE(kResult.num_steps == budget);
+      REQUIRE(memoized_segment_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(memoized_segment_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(memoized_segment_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+    }
+  }
+
+  SECTION("Test Machine That Gets Stuck", "[run][stuck][no move]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'l', kStateA, kStateA),
+        Direction('x', 'y', 'n', kStateA, kStateB),
+        Direction('y', 'z', 'n', kStateB, kStateC)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'x', '-'}, '-', kHaltingStateNames);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        turing_machine);
+    const RunResult kResult = memoized_segment_machine.Run(50);
+    REQUIRE(kResult.num_steps == 2);
+    REQUIRE(kResult.final_state_id == kStateC.GetId());
+    REQUIRE(memoized_segment_machine.GetTape() == std::vector<char>({'z',
+        '-'}));
+  }
+
+  SECTION("Test Halting State With Directions", "[run][halt]") {
+    // Run keeps following directions out of a halting state, RunUntilHalt
+    // stops as soon as the machine halts
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'r', kStateA, kHaltingState),
+        Direction('-', '2', 'l', kHaltingState, kStateA),
+        Direction('1', '3', 'r', kStateA, kHaltingState),
+        Direction('2', '4', 'r', kHaltingState, kStateB)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {},
+        '-', kHaltingStateNames);
+    MemoizedSegmentMachine run_machine = MemoizedSegmentMachine(
+        turing_machine);
+    MemoizedSegmentMachine halt_machine = MemoizedSegmentMachine(
+        turing_machine);
+    REQUIRE(halt_machine.RunUntilHalt(10).num_steps == 1);
+    REQUIRE(run_machine.Run(10).num_steps == 4);
+    turing_machine.Run(10);
+    REQUIRE(run_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(run_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(run_machine.IsHalted());
+  }
+}
+
+TEST_CASE("Test Very Long Runs Of Regular Machines Finish") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+
+  SECTION("Test Machine That Moves Right Forever", "[run][right][memo]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'r', kStateA, kStateA)};
+    const TuringMachine kTuringMachine = TuringMachine({kStateA},
+        kDirections, {}, '-', kHaltingStateNames);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        kTuringMachine);
+    const uint64_t kNumSteps = 1000000000000;
+    const RunResult kResult = memoized_segment_machine.Run(kNumSteps);
+    REQUIRE(kResult.num_steps == kNumSteps);
+    REQUIRE(kResult.index_of_scanner == kNumSteps);
+    REQUIRE(memoized_segment_machine.GetNumberOfSegments() < 200);
+  }
+
+  SECTION("Test Machine That Cycles Forever", "[run][cycle]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '-', 'r', kStateA, kStateB),
+        Direction('-', '-', 'l', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-', '-', '-', '-'}, '-', kHaltingStateNames);
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        turing_machine);
+    const uint64_t kNumSteps = 1000000000001;
+    const RunResult kResult = memoized_segment_machine.Run(kNumSteps);
+    turing_machine.Run(1001);
+    REQUIRE(kResult.num_steps == kNumSteps);
+    REQUIRE(memoized_segment_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(memoized_segment_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(memoized_segment_machine.GetCurrentState().Equals(kStateB));
+  }
+}
+
+TEST_CASE("Test Memoized Segment Machine Tables Stay Bounded") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  // sweeps right shifting the tape 1 cell (the state holds the cell before),
+  // then sweeps back left, so the segments of the tape keep changing
+  const std::vector<Direction> kDirections = {
+      Direction('0', '0', 'r', kStateA, kStateA),
+      Direction('1', '0', 'r', kStateA, kStateB),
+      Direction('0', '1', 'r', kStateB, kStateA),
+      Direction('1', '1', 'r', kStateB, kStateB),
+      Direction('-', '0', 'l', kStateA, kStateC),
+      Direction('-', '1', 'l', kStateB, kStateC),
+      Direction('0', '0', 'l', kStateC, kStateC),
+      Direction('1', '1', 'l', kStateC, kStateC),
+      Direction('-', '-', 'r', kStateC, kStateA)};
+  std::vector<char> tape;
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < 256; i++) {
+    seed = seed * 1103515245 + 12345;
+    tape.push_back((seed >> 16) % 2 == 0 ? '0' : '1');
+  }
+
+  SECTION("Test Shifting Machine With A Small Max Table Size",
+      "[run][memo][collect]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB, kStateC},
+        kDirections, tape, '-', kHaltingStateNames);
+    const size_t kMaxTableSize = 1024;
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        turing_machine, kMaxTableSize);
+    size_t max_num_segments = 0;
+    for (size_t i = 0; i < 100; i++) {
+      turing_machine.Run(20011);
+      REQUIRE(memoized_segment_machine.Run(20011).num_steps == 20011);
+      REQUIRE(memoized_segment_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(memoized_segment_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(memoized_segment_machine.GetNumberOfMemoizedResults()
+          <= kMaxTableSize);
+      max_num_segments = std::max(max_num_segments,
+          memoized_segment_machine.GetNumberOfSegments());
+    }
+    // the segments are collected once there are kMaxTableSize of them, and
+    // only a few more are made while the evaluation under way stops
+    REQUIRE(max_num_segments > kMaxTableSize);
+    REQUIRE(max_num_segments < kMaxTableSize + 128);
+  }
+
+  SECTION("Test Shifting Machine With The Default Max Table Size",
+      "[run][memo]") {
+    // the same run keeps over 3 times as many segments when none are
+    // collected
+    MemoizedSegmentMachine memoized_segment_machine = MemoizedSegmentMachine(
+        TuringMachine({kStateA, kStateB, kStateC}, kDirections, tape, '-',
+        kHaltingStateNames));
+    REQUIRE(memoized_segment_machine.Run(2001100).num_steps == 2001100);
+    REQUIRE(memoized_segment_machine.GetNumberOfSegments() > 3 * 1024);
+  }
+}
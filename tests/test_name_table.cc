@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <type_traits>
+
+#include "name_table.h"
+#include "state.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Names Are Correctly Interned
+ * Lists Of Names Are Correctly Interned
+ * States Only Store Interned Names
+ */
+TEST_CASE("Test Names Are Correctly Interned") {
+  SECTION("Test Empty Name", "[names]") {
+    REQUIRE(NameTable::InternName("") == 0);
+    REQUIRE(NameTable::GetName(0).empty());
+  }
+
+  SECTION("Test Same Name Has Same Id", "[names]") {
+    const uint32_t kNameId = NameTable::InternName("qInterned");
+    REQUIRE(NameTable::InternName("qInterned") == kNameId);
+    REQUIRE(NameTable::GetName(kNameId) == "qInterned");
+  }
+
+  SECTION("Test Different Names Have Different Ids", "[names]") {
+    REQUIRE(NameTable::InternName("qFirst") != NameTable::InternName(
+        "qSecond"));
+  }
+
+  SECTION("Test Unknown Id", "[names]") {
+    REQUIRE(NameTable::GetName(4000000000u).empty());
+  }
+
+  SECTION("Test Names Are Not Moved By Later Names", "[names]") {
+    const std::string &kName = NameTable::GetName(NameTable::InternName(
+        "qKept"));
+    for (size_t i = 0; i < 1000; i++) {
+      NameTable::InternName("qLater" + std::to_string(i));
+    }
+    REQUIRE(&kName == &NameTable::GetName(NameTable::InternName("qKept")));
+    REQUIRE(kName == "qKept");
+  }
+}
+
+TEST_CASE("Test Lists Of Names Are Correctly Interned") {
+  SECTION("Test Order And Repeats Do Not Matter", "[name lists]") {
+    const uint32_t kNameListId = NameTable::InternNameList({"qh", "qAccept",
+        "qReject"});
+    REQUIRE(NameTable::InternNameList({"qReject", "qh", "qAccept", "qh"})
+        == kNameListId);
+  }
+
+  SECTION("Test List Contains Its Names", "[name lists]") {
+    const uint32_t kNameListId = NameTable::InternNameList({"qh", "qAccept"});
+    REQUIRE(NameTable::NameListContains(kNameListId, NameTable::InternName(
+        "qAccept")));
+    REQUIRE(NameTable::NameListContains(kNameListId, NameTable::InternName(
+        "q1")) == false);
+  }
+}
+
+TEST_CASE("Test States Only Store Interned Names") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+
+  SECTION("Test States Are Trivially Copyable", "[state][copy]") {
+    REQUIRE(std::is_trivially_copyable<State>::value);
+  }
+
+  SECTION("Test Renaming A Copy Keeps The Original Name", "[state][copy]") {
+    const State kState = State(1, "q2", glm::vec2(0, 0), 5,
+        kHaltingStateNames);
+    State copy = kState;
+    copy.SetStateName("q3");
+    REQUIRE(kState.GetStateName() == "q2");
+    REQUIRE(copy.GetStateName() == "q3");
+  }
+}
@@ -0,0 +1,315 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "native_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Native Machine Is Correctly Created
+ * Native Machine Matches The Turing Machine
+ * Native Machine Falls Back To The Interpreter
+ */
+TEST_CASE("Test Native Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const Direction kDirection = Direction('-', '1', 'r', kStartingState,
+      kStartingState);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    NativeMachine native_machine = NativeMachine(TuringMachine());
+    REQUIRE(native_machine.IsEmpty());
+    REQUIRE(native_machine.Run(10).num_steps == 0);
+    REQUIRE(native_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, kTape, '-', kHaltingStateNames);
+    const NativeMachine kNativeMachine = NativeMachine(kTuringMachine);
+    REQUIRE(kNativeMachine.IsEmpty() == false);
+    REQUIRE(kNativeMachine.GetTape() == kTape);
+    REQUIRE(kNativeMachine.GetIndexOfScanner() == 0);
+    REQUIRE(kNativeMachine.GetCurrentState().Equals(kStartingState));
+  }
+
+#ifndef _WIN32
+  const std::string kCacheDirectory = "/tmp/turing-machine-simulator-test-"
+      + std::to_string(getpid()) + "-cache";
+
+  SECTION("Test Cache Directory Is Created With Its Parents",
+      "[initialization][cache]") {
+    // the quotes and spaces are passed to the compiler as they are
+    const std::string kTestDirectory = "/tmp/turing-machine-simulator-test-"
+        + std::to_string(getpid());
+    const std::string kNestedCacheDirectory = kTestDirectory + "/it's a/"
+        "$(false) cache";
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, {}, '-', kHaltingStateNames);
+    const NativeMachine kNativeMachine = NativeMachine(kTuringMachine, "cc",
+        kNestedCacheDirectory);
+    struct stat cache_directory_stat;
+    REQUIRE(stat(kNestedCacheDirectory.c_str(), &cache_directory_stat) == 0);
+    REQUIRE(S_ISDIR(cache_directory_stat.st_mode));
+    REQUIRE(kNativeMachine.GetArtifactPath().find(kNestedCacheDirectory) == 0);
+    REQUIRE(kNativeMachine.IsCompiled()
+        == NativeMachine(kTuringMachine).IsCompiled());
+    std::remove(kNativeMachine.GetArtifactPath().c_str());
+    rmdir(kNestedCacheDirectory.c_str());
+    rmdir((kTestDirectory + "/it's a").c_str());
+    rmdir(kTestDirectory.c_str());
+  }
+
+  SECTION("Test Compiler With Arguments", "[initialization]") {
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, {}, '-', kHaltingStateNames);
+    const NativeMachine kNativeMachine = NativeMachine(kTuringMachine,
+        "cc  -w", kCacheDirectory);
+    REQUIRE(kNativeMachine.IsCompiled()
+        == NativeMachine(kTuringMachine).IsCompiled());
+    std::remove(kNativeMachine.GetArtifactPath().c_str());
+    rmdir(kCacheDirectory.c_str());
+  }
+
+  SECTION("Test Planted Artifacts Are Not Loaded", "[initialization][cache]") {
+    // the machine planted in place of the cached machine writes 2s instead
+    // of 1s, so running it would change the tape
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, {}, '-', kHaltingStateNames);
+    const TuringMachine kPlantedTuringMachine = TuringMachine(
+        {kStartingState}, {Direction('-', '2', 'r', kStartingState,
+        kStartingState)}, {}, '-', kHaltingStateNames);
+    const NativeMachine kPlantedNativeMachine = NativeMachine(
+        kPlantedTuringMachine, "cc", kCacheDirectory);
+    const std::string kPlantedPath = kPlantedNativeMachine.GetArtifactPath();
+    const std::string kArtifactPath = NativeMachine(kTuringMachine, "cc",
+        kCacheDirectory).GetArtifactPath();
+    TuringMachine turing_machine = kTuringMachine;
+    turing_machine.Run(3);
+
+    // a symbolic link to a machine, then a copy of it anyone can write
+    for (bool is_link : {true, false}) {
+      std::remove(kArtifactPath.c_str());
+      if (is_link) {
+        REQUIRE(symlink(kPlantedPath.c_str(), kArtifactPath.c_str()) == 0);
+      } else {
+        std::ifstream planted_file(kPlantedPath, std::ios::binary);
+        std::ofstream artifact_file(kArtifactPath, std::ios::binary);
+        artifact_file << planted_file.rdbuf();
+        artifact_file.close();
+        REQUIRE(chmod(kArtifactPath.c_str(), 0666) == 0);
+      }
+      NativeMachine native_machine = NativeMachine(kTuringMachine, "cc",
+          kCacheDirectory);
+      native_machine.Run(3);
+      REQUIRE(native_machine.GetTape() == turing_machine.GetTape());
+      if (native_machine.IsCompiled()) {
+        struct stat artifact_stat;
+        REQUIRE(lstat(kArtifactPath.c_str(), &artifact_stat) == 0);
+        REQUIRE(S_ISREG(artifact_stat.st_mode));
+        REQUIRE((artifact_stat.st_mode & (S_IWGRP | S_IWOTH)) == 0);
+      }
+    }
+    std::remove(kArtifactPath.c_str());
+    std::remove(kPlantedPath.c_str());
+    rmdir(kCacheDirectory.c_str());
+  }
+
+  SECTION("Test Cache Directory Others Can Write", "[initialization][cache]") {
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, {}, '-', kHaltingStateNames);
+    REQUIRE(mkdir(kCacheDirectory.c_str(), 0700) == 0);
+    REQUIRE(chmod(kCacheDirectory.c_str(), 0777) == 0);
+    const NativeMachine kNativeMachine = NativeMachine(kTuringMachine, "cc",
+        kCacheDirectory);
+    REQUIRE(kNativeMachine.IsCompiled() == false);
+    REQUIRE(kNativeMachine.GetErrorMessage()
+        == "The Cache Directory Is Not Private");
+    rmdir(kCacheDirectory.c_str());
+  }
+#endif
+
+  SECTION("Test Compiled Machines Are Cached", "[initialization][cache]") {
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState},
+        {kDirection}, {}, '-', kHaltingStateNames);
+    const NativeMachine kFirstNativeMachine = NativeMachine(kTuringMachine);
+    const NativeMachine kSecondNativeMachine = NativeMachine(kTuringMachine);
+    REQUIRE(kFirstNativeMachine.GetArtifactPath()
+        == kSecondNativeMachine.GetArtifactPath());
+    REQUIRE(kFirstNativeMachine.IsCompiled()
+        == kSecondNativeMachine.IsCompiled());
+  }
+}
+
+TEST_CASE("Test Native Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    NativeMachine native_machine = NativeMachine(turing_machine);
+    const RunResult kResult = native_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(native_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(native_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'0', '1', '1'}, '-', kHaltingStateNames);
+    NativeMachine native_machine = NativeMachine(turing_machine);
+    const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      const RunResult kResult = native_machine.Run(budget);
+      REQUIRE(kResult.num_steps == budget);
+      REQUIRE(native_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(native_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(native_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+      REQUIRE(native_machine.GetNumberOfSteps()
+          == turing_machine.GetNumberOfSteps());
+    }
+  }
+
+  SECTION("Test Machine That Gets Stuck", "[run][stuck][no move]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'l', kStateA, kStateA),
+        Direction('x', 'y', 'n', kStateA, kStateB),
+        Direction('y', 'z', 'n', kStateB, kStateC)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'x', '-'}, '-', kHaltingStateNames);
+    NativeMachine native_machine = NativeMachine(turing_machine);
+    const RunResult kResult = native_machine.Run(50);
+    REQUIRE(kResult.num_steps == 2);
+    REQUIRE(kResult.final_state_id == kStateC.GetId());
+    REQUIRE(native_machine.GetTape() == std::vector<char>({'z', '-'}));
+  }
+
+  SECTION("Test Halting State With Directions", "[run][halt]") {
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'r', kStateA, kHaltingState),
+        Direction('-', '2', 'l', kHaltingState, kStateA),
+        Direction('1', '3', 'r', kStateA, kHaltingState),
+        Direction('2', '4', 'r', kHaltingState, kStateB)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {},
+        '-', kHaltingStateNames);
+    NativeMachine run_machine = NativeMachine(turing_machine);
+    NativeMachine halt_machine = NativeMachine(turing_machine);
+    REQUIRE(halt_machine.RunUntilHalt(10).num_steps == 1);
+    REQUIRE(run_machine.Run(10).num_steps == 4);
+    turing_machine.Run(10);
+    REQUIRE(run_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(run_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(run_machine.IsHalted());
+  }
+}
+
+TEST_CASE("Test Native Machine Falls Back To The Interpreter") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const std::vector<Direction> kDirections = {
+      Direction('-', '1', 'l', kStateA, kStateB),
+      Direction('-', '-', 'l', kStateB, kStateA)};
+  TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+      kDirections, {}, '-', kHaltingStateNames);
+#ifdef _WIN32
+  const std::string kCacheDirectory = ".";
+#else
+  const std::string kCacheDirectory = "/tmp/turing-machine-simulator-test-"
+      + std::to_string(getpid()) + "-cache";
+#endif
+
+  SECTION("Test Missing Compiler", "[fallback]") {
+    NativeMachine native_machine = NativeMachine(turing_machine,
+        "no-such-compiler-for-turing-machines", kCacheDirectory);
+    REQUIRE(native_machine.IsCompiled() == false);
+    REQUIRE(native_machine.GetErrorMessage().empty() == false);
+#ifndef _WIN32
+    REQUIRE(native_machine.GetErrorMessage() == "Could Not Compile Machine");
+    rmdir(kCacheDirectory.c_str());
+#endif
+    const RunResult kResult = native_machine.Run(1000);
+    turing_machine.Run(1000);
+    REQUIRE(kResult.num_steps == 1000);
+    REQUIRE(native_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(native_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Fallback Does Not Notify Listeners", "[fallback]") {
+    size_t num_events = 0;
+    turing_machine.Subscribe([&num_events](const std::vector<StepEvent>
+        &batch) {
+      num_events += batch.size();
+    });
+    NativeMachine native_machine = NativeMachine(turing_machine,
+        "no-such-compiler-for-turing-machines", "/tmp");
+    REQUIRE(native_machine.Run(10).num_steps == 10);
+    REQUIRE(native_machine.RunUntilHalt(10).num_steps == 10);
+    REQUIRE(native_machine.GetNumberOfSteps() == 20);
+    REQUIRE(num_events == 0);
+  }
+
+#ifndef _WIN32
+  SECTION("Test Cache Directory That Cannot Be Created", "[fallback]") {
+    NativeMachine native_machine = NativeMachine(turing_machine, "cc",
+        "/dev/null/turing-machine-simulator-cache");
+    REQUIRE(native_machine.IsCompiled() == false);
+    REQUIRE(native_machine.GetErrorMessage()
+        == "Could Not Create The Cache Directory");
+    REQUIRE(native_machine.Run(10).num_steps == 10);
+  }
+#endif
+
+  SECTION("Test Generated Source", "[source]") {
+    const NativeMachine kNativeMachine = NativeMachine(turing_machine,
+        "no-such-compiler-for-turing-machines", "/tmp");
+    REQUIRE(kNativeMachine.GetSource().find("uint64_t run(")
+        != std::string::npos);
+  }
+}
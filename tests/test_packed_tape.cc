@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include "packed_tape.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Packed Tape Is Correctly Created
+ * Scanner Correctly Reads, Writes, And Grows The Packed Tape
+ * Runs Of Cells Are Correctly Skipped
+ */
+TEST_CASE("Test Packed Tape Creation") {
+  SECTION("Test Empty Tape", "[initialization][empty]") {
+    const PackedTape kTape = PackedTape({}, '-', {'0', '1'});
+    REQUIRE(kTape.GetCells() == std::vector<char>{'-'});
+    REQUIRE(kTape.GetIndexOfScanner() == 0);
+    REQUIRE(kTape.GetBlankCharacter() == '-');
+  }
+
+  SECTION("Test Blank Character Is Code 0", "[initialization][alphabet]") {
+    const PackedTape kTape = PackedTape({'1', '0'}, '0', {'1'});
+    REQUIRE(kTape.GetAlphabet() == std::vector<char>{'0', '1'});
+    REQUIRE(kTape.GetCode('0') == 0);
+    REQUIRE(kTape.GetCode('1') == 1);
+    REQUIRE(kTape.GetCharacter(1) == '1');
+    REQUIRE(kTape.Read() == 1);
+  }
+
+  SECTION("Test Bits Per Cell", "[initialization][alphabet]") {
+    REQUIRE(PackedTape({}, '0', {'1'}).GetBitsPerCell() == 1);
+    REQUIRE(PackedTape({}, '-', {'0', '1'}).GetBitsPerCell() == 2);
+    REQUIRE(PackedTape({'a', 'b'}, '-', {'0', '1'}).GetBitsPerCell() == 4);
+    std::vector<char> alphabet;
+    for (char character = 'a'; character <= 'z'; character++) {
+      alphabet.push_back(character);
+    }
+    REQUIRE(PackedTape({}, '-', alphabet).GetBitsPerCell() == 8);
+  }
+
+  SECTION("Test Cells Of The Tape Are Kept", "[initialization]") {
+    const std::vector<char> kCells = {'0', '1', '1', '-', '0', '1'};
+    const PackedTape kTape = PackedTape(kCells, '-', {});
+    REQUIRE(kTape.GetCells() == kCells);
+    REQUIRE(kTape.GetCell(3) == '-');
+    REQUIRE(kTape.GetSize() == 6);
+  }
+
+  SECTION("Test Long Tape Uses Fewer Bytes", "[initialization][memory]") {
+    const std::vector<char> kCells(64000, '1');
+    const PackedTape kTape = PackedTape(kCells, '0', {});
+    REQUIRE(kTape.GetCells() == kCells);
+    REQUIRE(kTape.GetNumberOfBytes() == 8000);
+  }
+}
+
+TEST_CASE("Test Scanner Correctly Reads, Writes, And Grows The Packed Tape") {
+  SECTION("Test Write", "[write]") {
+    PackedTape tape = PackedTape({'a', 'b', 'c'}, '-', {});
+    tape.MoveRight();
+    tape.Write(tape.GetCode('c'));
+    REQUIRE(tape.GetCells() == std::vector<char>{'a', 'c', 'c'});
+    tape.Write(tape.GetCode('-'));
+    REQUIRE(tape.GetCells() == std::vector<char>{'a', '-', 'c'});
+  }
+
+  SECTION("Test Writing Across Words", "[write][right]") {
+    // 2 bits per cell, so the tape is 3 words long
+    PackedTape tape = PackedTape({}, '-', {'0', '1'});
+    std::vector<char> expected_cells;
+    for (size_t i = 0; i < 70; i++) {
+      const char kCharacter = i % 3 == 0 ? '1' : '0';
+      tape.Write(tape.GetCode(kCharacter));
+      expected_cells.push_back(kCharacter);
+      if (i < 69) {
+        tape.MoveRight();
+      }
+    }
+    REQUIRE(tape.GetCells() == expected_cells);
+    REQUIRE(tape.GetIndexOfScanner() == 69);
+  }
+
+  SECTION("Test Growing Past The Headroom At Both Ends", "[grow][left]") {
+    PackedTape tape = PackedTape({'1'}, '0', {});
+    for (size_t i = 0; i < 300; i++) {
+      tape.MoveLeft();
+    }
+    tape.Write(tape.GetCode('1'));
+    REQUIRE(tape.GetPositionOfScanner() == -300);
+    for (size_t i = 0; i < 600; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.GetPositionOfScanner() == 300);
+    REQUIRE(tape.GetSize() == 601);
+    REQUIRE(tape.GetIndexOfScanner() == 600);
+    REQUIRE(tape.GetCell(0) == '1');
+    REQUIRE(tape.GetCell(300) == '1');
+    REQUIRE(tape.GetCell(1) == '0');
+    REQUIRE(tape.GetCell(600) == '0');
+  }
+}
+
+TEST_CASE("Test Runs Of Cells Are Correctly Skipped") {
+  // 200 cells of '1' between a '-' at index 0 and a '-' at index 201
+  std::vector<char> cells(202, '1');
+  cells.front() = '-';
+  cells.back() = '-';
+
+  SECTION("Test Skipping Right To Another Code", "[skip][right]") {
+    PackedTape tape = PackedTape(cells, '-', {'0'});
+    tape.MoveRight();
+    REQUIRE(tape.SkipRight(tape.GetCode('1'), 1000) == 200);
+    REQUIRE(tape.GetIndexOfScanner() == 201);
+    REQUIRE(tape.SkipRight(tape.GetCode('1'), 1000) == 0);
+  }
+
+  SECTION("Test Skipping Right Stops After Max Cells", "[skip][right]") {
+    PackedTape tape = PackedTape(cells, '-', {'0'});
+    tape.MoveRight();
+    REQUIRE(tape.SkipRight(tape.GetCode('1'), 37) == 37);
+    REQUIRE(tape.GetIndexOfScanner() == 38);
+    REQUIRE(tape.SkipRight(tape.GetCode('1'), 100) == 100);
+    REQUIRE(tape.GetIndexOfScanner() == 138);
+  }
+
+  SECTION("Test Skipping Right Stops On The Last Cell", "[skip][right]") {
+    PackedTape tape = PackedTape({'1', '1', '1', '1'}, '-', {});
+    REQUIRE(tape.SkipRight(tape.GetCode('1'), 1000) == 3);
+    REQUIRE(tape.GetIndexOfScanner() == 3);
+    REQUIRE(tape.GetSize() == 4);
+  }
+
+  SECTION("Test Skipping Left To Another Code", "[skip][left]") {
+    PackedTape tape = PackedTape(cells, '-', {'0'});
+    for (size_t i = 0; i < 200; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.SkipLeft(tape.GetCode('1'), 1000) == 200);
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    REQUIRE(tape.SkipLeft(tape.GetCode('-'), 1000) == 0);
+  }
+
+  SECTION("Test Skipping Left Stops After Max Cells", "[skip][left]") {
+    PackedTape tape = PackedTape(cells, '-', {'0'});
+    for (size_t i = 0; i < 200; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.SkipLeft(tape.GetCode('1'), 70) == 70);
+    REQUIRE(tape.GetIndexOfScanner() == 130);
+    REQUIRE(tape.SkipLeft(tape.GetCode('1'), 1000) == 130);
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+  }
+
+  SECTION("Test Skipping Left Stops On The First Cell", "[skip][left]") {
+    PackedTape tape = PackedTape({'1', '1', '1', '1'}, '-', {});
+    for (size_t i = 0; i < 3; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.SkipLeft(tape.GetCode('1'), 1000) == 3);
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+  }
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+
+#include "packed_tape_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Packed Tape Machine Is Correctly Created
+ * Packed Tape Machine Matches The Turing Machine
+ */
+TEST_CASE("Test Packed Tape Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kHaltingState = State(2, "qh",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(TuringMachine());
+    REQUIRE(packed_tape_machine.IsEmpty());
+    REQUIRE(packed_tape_machine.Run(10).num_steps == 0);
+    REQUIRE(packed_tape_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    TuringMachine turing_machine = TuringMachine({kStartingState},
+        {Direction('a', 'a', 'r', kStartingState, kStartingState)}, kTape, '-',
+        kHaltingStateNames);
+    turing_machine.Run(2);
+    const PackedTapeMachine kPackedTapeMachine = PackedTapeMachine(
+        turing_machine);
+    REQUIRE(kPackedTapeMachine.IsEmpty() == false);
+    REQUIRE(kPackedTapeMachine.GetTape() == kTape);
+    REQUIRE(kPackedTapeMachine.GetIndexOfScanner() == 1);
+    REQUIRE(kPackedTapeMachine.GetNumberOfSteps() == 1);
+    REQUIRE(kPackedTapeMachine.GetCurrentState().Equals(kStartingState));
+  }
+
+  SECTION("Test Alphabet Comes From The Directions", "[initialization]") {
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState,
+        kHaltingState}, {Direction('0', '1', 'r', kStartingState,
+        kStartingState), Direction('-', '-', 'n', kStartingState,
+        kHaltingState)}, {}, '-', kHaltingStateNames);
+    const PackedTapeMachine kPackedTapeMachine = PackedTapeMachine(
+        kTuringMachine);
+    REQUIRE(kPackedTapeMachine.GetPackedTape().GetAlphabet()
+        == std::vector<char>{'-', '0', '1'});
+    REQUIRE(kPackedTapeMachine.GetPackedTape().GetBitsPerCell() == 2);
+  }
+}
+
+TEST_CASE("Test Packed Tape Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(turing_machine);
+    const RunResult kResult = packed_tape_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(packed_tape_machine.GetPackedTape().GetBitsPerCell() == 1);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(packed_tape_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(packed_tape_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][sweep]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'0', '1', '1'}, '-', kHaltingStateNames);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(turing_machine);
+    const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      const RunResult kResult = packed_tape_machine.Run(budget);
+      REQUIRE(kResult.num_steps == budget);
+      REQUIRE(packed_tape_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(packed_tape_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(packed_tape_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+      REQUIRE(packed_tape_machine.GetNumberOfSteps()
+          == turing_machine.GetNumberOfSteps());
+    }
+  }
+
+  SECTION("Test Long Sweeps In Both Directions", "[run][sweep]") {
+    // sweeps back and forth over a growing block of 1s, so most steps are
+    // skipped a word at a time
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('0', '1', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        std::vector<char>(500, '1'), '0', kHaltingStateNames);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(turing_machine);
+    const uint64_t kBudgets[] = {3, 499, 501, 2000, 100000};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      packed_tape_machine.Run(budget);
+      REQUIRE(packed_tape_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(packed_tape_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(packed_tape_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+    }
+  }
+
+  SECTION("Test Sweep Into A Halting State", "[run][sweep][halt]") {
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'r', kStateA, kHaltingState),
+        Direction('-', '-', 'r', kHaltingState, kHaltingState)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        std::vector<char>(100, '1'), '-', kHaltingStateNames);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(turing_machine);
+    const RunResult kResult = packed_tape_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 101);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(packed_tape_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    packed_tape_machine.Run(50);
+    turing_machine.Run(50);
+    REQUIRE(packed_tape_machine.GetTape() == turing_machine.GetTape());
+  }
+
+  SECTION("Test Character No Direction Reads", "[run][stuck]") {
+    TuringMachine turing_machine = TuringMachine(kStates,
+        {Direction('1', '1', 'r', kStateA, kStateA)}, {'1', '1', 'x', '1'},
+        '-', kHaltingStateNames);
+    PackedTapeMachine packed_tape_machine = PackedTapeMachine(turing_machine);
+    const RunResult kResult = packed_tape_machine.Run(100);
+    REQUIRE(kResult.num_steps == turing_machine.Run(100).num_steps);
+    REQUIRE(kResult.index_of_scanner == 2);
+  }
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+
+#include "program.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Program Is Correctly Created
+ * Program Correctly Reports Errors
+ */
+TEST_CASE("Test Program Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kNthState = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Default Constructor", "[initialization][empty]") {
+    const Program kProgram = Program();
+    REQUIRE(kProgram.IsEmpty());
+    REQUIRE(kProgram.GetTransitionTable().IsEmpty());
+  }
+
+  SECTION("Test Valid Program", "[initialization]") {
+    const Program kProgram = Program({kNthState, kStartingState,
+        kHaltingState}, {Direction('-', '1', 'r', kStartingState, kNthState),
+        Direction('-', '1', 'r', kNthState, kHaltingState)},
+        kHaltingStateNames);
+    REQUIRE(kProgram.IsEmpty() == false);
+    REQUIRE(kProgram.GetErrorMessage().empty());
+    REQUIRE(kProgram.GetTransitionTable().GetState(
+        kProgram.GetStartingStateIndex()).Equals(kStartingState));
+    REQUIRE(kProgram.GetHaltingStates().size() == 1);
+    REQUIRE(kProgram.GetHaltingStates()[0].Equals(kHaltingState));
+    REQUIRE(kProgram.GetDirectionsByStateMap().size() == 2);
+  }
+}
+
+TEST_CASE("Test Program Correctly Reports Errors") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kNthState = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test No Starting State", "[error]") {
+    const Program kProgram = Program({kNthState}, {}, kHaltingStateNames);
+    REQUIRE(kProgram.IsEmpty());
+    REQUIRE(kProgram.GetErrorMessage() == "Must Have Starting State");
+  }
+
+  SECTION("Test 2 Starting States", "[error]") {
+    const State kOtherStartingState = State(3, "q1", glm::vec2(0, 0), 5,
+        kHaltingStateNames);
+    const Program kProgram = Program({kStartingState, kOtherStartingState},
+        {}, kHaltingStateNames);
+    REQUIRE(kProgram.IsEmpty());
+    REQUIRE(kProgram.GetErrorMessage()
+        == "Cannot Have More Than 1 Starting State");
+  }
+
+  SECTION("Test 2 Directions With Same Read Condition", "[error]") {
+    const Program kProgram = Program({kStartingState, kNthState},
+        {Direction('-', '1', 'r', kStartingState, kNthState),
+        Direction('-', '0', 'l', kStartingState, kStartingState)},
+        kHaltingStateNames);
+    REQUIRE(kProgram.IsEmpty());
+    REQUIRE(kProgram.GetErrorMessage() == "Must Not Have 2 Directions With "
+        "Same Read Condition From The Same State");
+  }
+}
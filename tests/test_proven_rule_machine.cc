@@ -0,0 +1,349 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+
+#include "proven_rule_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Proven Rule Machine Is Correctly Created
+ * Proven Rule Machine Matches The Turing Machine
+ * Proven Rules Take Very Long Runs At Once
+ * Turing Machine Runs With Proven Rules In Proven Rules Mode
+ */
+TEST_CASE("Test Proven Rule Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(TuringMachine());
+    REQUIRE(proven_rule_machine.IsEmpty());
+    REQUIRE(proven_rule_machine.Run(10).num_steps == 0);
+    REQUIRE(proven_rule_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    TuringMachine turing_machine = TuringMachine({kStartingState},
+        {Direction('a', 'a', 'r', kStartingState, kStartingState)}, kTape, '-',
+        kHaltingStateNames);
+    turing_machine.Run(2);
+    const ProvenRuleMachine kProvenRuleMachine = ProvenRuleMachine(
+        turing_machine);
+    REQUIRE(kProvenRuleMachine.IsEmpty() == false);
+    REQUIRE(kProvenRuleMachine.GetTape() == kTape);
+    REQUIRE(kProvenRuleMachine.GetIndexOfScanner() == 1);
+    REQUIRE(kProvenRuleMachine.GetPositionOfScanner() == 1);
+    REQUIRE(kProvenRuleMachine.GetNumberOfSteps() == 1);
+    REQUIRE(kProvenRuleMachine.GetCurrentState().Equals(kStartingState));
+  }
+
+  SECTION("Test Step Counts Are Written In Decimal", "[step count]") {
+    REQUIRE(StepCountToString(0) == "0");
+    REQUIRE(StepCountToString(1234567) == "1234567");
+    const StepCount kTwoToThe64 = static_cast<StepCount>(
+        std::numeric_limits<uint64_t>::max()) + 1;
+    REQUIRE(StepCountToString(kTwoToThe64) == "18446744073709551616");
+  }
+}
+
+TEST_CASE("Test Proven Rule Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateE = State(5, "q5", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(6, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kStateE, kHaltingState};
+  // moves the 1s left of the 0 to the right of it 1 at a time
+  const std::vector<Direction> kMoveBlockDirections = {
+      Direction('1', '-', 'r', kStateA, kStateB),
+      Direction('0', '0', 'n', kStateA, kHaltingState),
+      Direction('1', '1', 'r', kStateB, kStateB),
+      Direction('0', '0', 'r', kStateB, kStateC),
+      Direction('1', '1', 'r', kStateC, kStateC),
+      Direction('-', '1', 'l', kStateC, kStateD),
+      Direction('1', '1', 'l', kStateD, kStateD),
+      Direction('0', '0', 'l', kStateD, kStateE),
+      Direction('1', '1', 'l', kStateE, kStateE),
+      Direction('-', '-', 'r', kStateE, kStateA)};
+  // sweeps back and forth forever, adding a 1 at each end of the tape
+  const std::vector<Direction> kSweepDirections = {
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('-', '1', 'l', kStateA, kStateB),
+      Direction('1', '1', 'l', kStateB, kStateB),
+      Direction('-', '1', 'r', kStateB, kStateA)};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(turing_machine);
+    const RunResult kResult = proven_rule_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(proven_rule_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(proven_rule_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+  }
+
+  SECTION("Test Moving A Block", "[run][halt][rule]") {
+    std::vector<char> tape(30, '1');
+    tape.push_back('0');
+    TuringMachine turing_machine = TuringMachine(kStates,
+        kMoveBlockDirections, tape, '-', kHaltingStateNames);
+    ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(turing_machine);
+    const RunResult kResult = proven_rule_machine.RunUntilHalt(100000);
+    const RunResult kExpectedResult = turing_machine.RunUntilHalt(100000);
+    // each of the 30 rounds takes 2 * 30 + 3 steps, then 1 step halts
+    REQUIRE(kResult.num_steps == 30 * 63 + 1);
+    REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(proven_rule_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(proven_rule_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(proven_rule_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    REQUIRE(proven_rule_machine.GetNumberOfProvenRules() > 0);
+    REQUIRE(proven_rule_machine.GetNumberOfRuleApplications() > 0);
+  }
+
+  SECTION("Test Moving A Block With Step Budgets", "[run][rule]") {
+    std::vector<char> tape(25, '1');
+    tape.push_back('0');
+    for (uint64_t budget : {1, 7, 63, 200, 777, 1000, 1303}) {
+      TuringMachine turing_machine = TuringMachine(kStates,
+          kMoveBlockDirections, tape, '-', kHaltingStateNames);
+      ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(
+          turing_machine);
+      // budgets that run out in the middle of rules and chains
+      while (!turing_machine.IsHalted()) {
+        const RunResult kResult = proven_rule_machine.RunUntilHalt(budget);
+        const RunResult kExpectedResult = turing_machine.RunUntilHalt(budget);
+        REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+        REQUIRE(kResult.is_halted == kExpectedResult.is_halted);
+        REQUIRE(kResult.final_state_id == kExpectedResult.final_state_id);
+        REQUIRE(proven_rule_machine.GetTape() == turing_machine.GetTape());
+        REQUIRE(proven_rule_machine.GetPositionOfScanner()
+            == turing_machine.GetPositionOfScanner());
+      }
+    }
+  }
+
+  SECTION("Test Sweeping Forever With Step Budgets", "[run][rule]") {
+    for (uint64_t budget : {5, 99, 1024, 4321, 100000}) {
+      TuringMachine turing_machine = TuringMachine(kStates, kSweepDirections,
+          {'-'}, '-', kHaltingStateNames);
+      ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(
+          turing_machine);
+      for (size_t i = 0; i < 3; i++) {
+        const RunResult kResult = proven_rule_machine.Run(budget);
+        const RunResult kExpectedResult = turing_machine.Run(budget);
+        REQUIRE(kResult.num_steps == budget);
+        REQUIRE(kExpectedResult.num_steps == budget);
+        REQUIRE(kResult.final_state_id == kExpectedResult.final_state_id);
+        REQUIRE(proven_rule_machine.GetTape() == turing_machine.GetTape());
+        REQUIRE(proven_rule_machine.GetPositionOfScanner()
+            == turing_machine.GetPositionOfScanner());
+      }
+    }
+  }
+}
+
+TEST_CASE("Test Proven Rules Take Very Long Runs At Once") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateE = State(5, "q5", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(6, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kStateE, kHaltingState};
+
+  SECTION("Test Moving A Block Of A Million Cells", "[run][halt][rule]") {
+    const std::vector<Direction> kDirections = {
+        Direction('1', '-', 'r', kStateA, kStateB),
+        Direction('0', '0', 'n', kStateA, kHaltingState),
+        Direction('1', '1', 'r', kStateB, kStateB),
+        Direction('0', '0', 'r', kStateB, kStateC),
+        Direction('1', '1', 'r', kStateC, kStateC),
+        Direction('-', '1', 'l', kStateC, kStateD),
+        Direction('1', '1', 'l', kStateD, kStateD),
+        Direction('0', '0', 'l', kStateD, kStateE),
+        Direction('1', '1', 'l', kStateE, kStateE),
+        Direction('-', '-', 'r', kStateE, kStateA)};
+    const uint64_t kNumCells = 1000000;
+    std::vector<char> tape(kNumCells, '1');
+    tape.push_back('0');
+    ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(TuringMachine(
+        kStates, kDirections, tape, '-', kHaltingStateNames));
+    const RunResult kResult = proven_rule_machine.RunUntilHalt(
+        std::numeric_limits<uint64_t>::max());
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.num_steps == kNumCells * (2 * kNumCells + 3) + 1);
+    REQUIRE(kResult.index_of_scanner == kNumCells);
+    REQUIRE(proven_rule_machine.GetPositionOfScanner() == 1000000);
+    std::vector<char> expected_tape(kNumCells, '-');
+    expected_tape.push_back('0');
+    expected_tape.insert(expected_tape.end(), kNumCells, '1');
+    REQUIRE(proven_rule_machine.GetTape() == expected_tape);
+  }
+
+  SECTION("Test Step Counts Past 64 Bits", "[run][rule][step count]") {
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '1', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    ProvenRuleMachine proven_rule_machine = ProvenRuleMachine(TuringMachine(
+        kStates, kDirections, {'-'}, '-', kHaltingStateNames));
+    const uint64_t kMaxSteps = std::numeric_limits<uint64_t>::max();
+    REQUIRE(proven_rule_machine.Run(kMaxSteps).num_steps == kMaxSteps);
+    REQUIRE(proven_rule_machine.Run(kMaxSteps).num_steps == kMaxSteps);
+    REQUIRE(StepCountToString(proven_rule_machine.GetNumberOfSteps())
+        == "36893488147419103230");
+    // the tape is billions of cells long but only a few runs
+    REQUIRE(proven_rule_machine.GetRunLengthTape().GetNumberOfRuns() <= 2);
+    REQUIRE(proven_rule_machine.GetRunLengthTape().GetSize() > 1000000000);
+  }
+}
+
+TEST_CASE("Test Turing Machine Runs With Proven Rules") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const std::vector<Direction> kDirections = {
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('-', '1', 'l', kStateA, kStateB),
+      Direction('1', '1', 'l', kStateB, kStateB),
+      Direction('-', '1', 'r', kStateB, kStateA)};
+
+  SECTION("Test Run Mode Defaults To Step By Step", "[run mode]") {
+    REQUIRE(TuringMachine().GetRunMode() == RunMode::kStepByStep);
+  }
+
+  SECTION("Test Proven Rules Mode Matches Step By Step", "[run mode]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    TuringMachine proven_rules_turing_machine = turing_machine;
+    proven_rules_turing_machine.SetRunMode(RunMode::kProvenRules);
+    REQUIRE(proven_rules_turing_machine.GetRunMode() == RunMode::kProvenRules);
+    for (uint64_t budget : {10, 1000, 50000}) {
+      const RunResult kResult = proven_rules_turing_machine.Run(budget);
+      const RunResult kExpectedResult = turing_machine.Run(budget);
+      REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+      REQUIRE(kResult.index_of_scanner == kExpectedResult.index_of_scanner);
+      REQUIRE(proven_rules_turing_machine.GetTape()
+          == turing_machine.GetTape());
+      REQUIRE(proven_rules_turing_machine.GetPositionOfScanner()
+          == turing_machine.GetPositionOfScanner());
+      REQUIRE(proven_rules_turing_machine.GetNumberOfSteps()
+          == turing_machine.GetNumberOfSteps());
+      REQUIRE(proven_rules_turing_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+    }
+  }
+
+  SECTION("Test Long Run In Proven Rules Mode", "[run mode][rule]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    turing_machine.SetRunMode(RunMode::kProvenRules);
+    // a million passes of the sweep, about 10^12 steps
+    REQUIRE(turing_machine.Run(1000000000000).num_steps == 1000000000000);
+    REQUIRE(turing_machine.GetNumberOfSteps() == 1000000000000);
+    REQUIRE(turing_machine.GetTape().size() > 1000000);
+  }
+
+  SECTION("Test Step Counts Past 64 Bits Saturate", "[run mode][step count]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    turing_machine.SetRunMode(RunMode::kProvenRules);
+    const uint64_t kMaxSteps = std::numeric_limits<uint64_t>::max();
+    REQUIRE(turing_machine.Run(kMaxSteps).num_steps == kMaxSteps);
+    REQUIRE(turing_machine.Run(kMaxSteps).num_steps == kMaxSteps);
+    REQUIRE(turing_machine.GetNumberOfSteps() == kMaxSteps);
+    REQUIRE(StepCountToString(turing_machine.GetExactNumberOfSteps())
+        == "36893488147419103230");
+  }
+
+  SECTION("Test Short Runs Continue The Same Machine", "[run mode][rule]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    TuringMachine proven_rules_turing_machine = turing_machine;
+    proven_rules_turing_machine.SetRunMode(RunMode::kProvenRules);
+    for (size_t run = 0; run < 100; run++) {
+      REQUIRE(proven_rules_turing_machine.Run(1000).num_steps == 1000);
+      REQUIRE(proven_rules_turing_machine.GetNumberOfSteps()
+          == 1000 * (run + 1));
+      REQUIRE(proven_rules_turing_machine.IsHalted() == false);
+    }
+    turing_machine.Run(100000);
+    REQUIRE(proven_rules_turing_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(proven_rules_turing_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(proven_rules_turing_machine.GetCurrentState().Equals(
+        turing_machine.GetCurrentState()));
+  }
+
+  SECTION("Test Copies And Steps After Proven Rules", "[run mode]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    TuringMachine proven_rules_turing_machine = turing_machine;
+    proven_rules_turing_machine.SetRunMode(RunMode::kProvenRules);
+    proven_rules_turing_machine.Run(5000);
+    turing_machine.Run(5000);
+
+    // the copy runs on its own, leaving the original where it was
+    TuringMachine copy = proven_rules_turing_machine;
+    copy.Run(5000);
+    REQUIRE(copy.GetNumberOfSteps() == 10000);
+    REQUIRE(proven_rules_turing_machine.GetNumberOfSteps() == 5000);
+    REQUIRE(proven_rules_turing_machine.GetTape() == turing_machine.GetTape());
+
+    // steps taken 1 at a time continue from the proven rules
+    proven_rules_turing_machine.Update();
+    turing_machine.Update();
+    proven_rules_turing_machine.Run(777);
+    turing_machine.Run(777);
+    REQUIRE(proven_rules_turing_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(proven_rules_turing_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    REQUIRE(proven_rules_turing_machine.GetNumberOfSteps() == 5778);
+  }
+
+  SECTION("Test Listeners Keep Step By Step Runs", "[run mode][events]") {
+    TuringMachine turing_machine = TuringMachine({kStateA, kStateB},
+        kDirections, {'-'}, '-', kHaltingStateNames);
+    turing_machine.SetRunMode(RunMode::kProvenRules);
+    uint64_t num_events = 0;
+    turing_machine.Subscribe([&num_events](const std::vector<StepEvent>
+        &events) {
+      num_events += events.size();
+    });
+    REQUIRE(turing_machine.Run(100).num_steps == 100);
+    REQUIRE(num_events >= 100);
+  }
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include "run_length_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Run Length Machine Is Correctly Created
+ * Run Length Machine Matches The Turing Machine
+ * Chain Steps Cross Long Blocks At Once
+ */
+TEST_CASE("Test Run Length Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    RunLengthMachine run_length_machine = RunLengthMachine(TuringMachine());
+    REQUIRE(run_length_machine.IsEmpty());
+    REQUIRE(run_length_machine.Run(10).num_steps == 0);
+    REQUIRE(run_length_machine.GetTape().empty());
+  }
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c', 'd', 'e'};
+    TuringMachine turing_machine = TuringMachine({kStartingState},
+        {Direction('a', 'a', 'r', kStartingState, kStartingState)}, kTape, '-',
+        kHaltingStateNames);
+    turing_machine.Run(2);
+    const RunLengthMachine kRunLengthMachine = RunLengthMachine(
+        turing_machine);
+    REQUIRE(kRunLengthMachine.IsEmpty() == false);
+    REQUIRE(kRunLengthMachine.GetTape() == kTape);
+    REQUIRE(kRunLengthMachine.GetIndexOfScanner() == 1);
+    REQUIRE(kRunLengthMachine.GetNumberOfSteps() == 1);
+    REQUIRE(kRunLengthMachine.GetCurrentState().Equals(kStartingState));
+  }
+}
+
+TEST_CASE("Test Run Length Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    RunLengthMachine run_length_machine = RunLengthMachine(turing_machine);
+    const RunResult kResult = run_length_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(run_length_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(run_length_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][chain]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'0', '1', '1'}, '-', kHaltingStateNames);
+    RunLengthMachine run_length_machine = RunLengthMachine(turing_machine);
+    const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      const RunResult kResult = run_length_machine.Run(budget);
+      REQUIRE(kResult.num_steps == budget);
+      REQUIRE(run_length_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(run_length_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(run_length_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+      REQUIRE(run_length_machine.GetNumberOfSteps()
+          == turing_machine.GetNumberOfSteps());
+    }
+  }
+
+  SECTION("Test Chain Into Blanks Past The End", "[run][chain][grow]") {
+    TuringMachine turing_machine = TuringMachine(kStates, {
+        Direction('-', 'x', 'l', kStateA, kStateA)}, {'-', '1'}, '-',
+        kHaltingStateNames);
+    RunLengthMachine run_length_machine = RunLengthMachine(turing_machine);
+    const uint64_t kBudgets[] = {1, 2, 30};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      REQUIRE(run_length_machine.Run(budget).num_steps == budget);
+      REQUIRE(run_length_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(run_length_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+    }
+  }
+
+  SECTION("Test Chain Into A Halting State", "[run][chain][halt]") {
+    const std::vector<Direction> kDirections = {
+        Direction('1', '0', 'r', kStateA, kStateA),
+        Direction('-', '-', 'r', kStateA, kHaltingState),
+        Direction('-', '-', 'r', kHaltingState, kHaltingState)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        std::vector<char>(100, '1'), '-', kHaltingStateNames);
+    RunLengthMachine run_length_machine = RunLengthMachine(turing_machine);
+    const RunResult kResult = run_length_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 101);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(run_length_machine.GetTape() == turing_machine.GetTape());
+    run_length_machine.Run(50);
+    turing_machine.Run(50);
+    REQUIRE(run_length_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(run_length_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+  }
+}
+
+TEST_CASE("Test Chain Steps Cross Long Blocks At Once") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Sweeping A Block Of A Million Cells", "[run][chain]") {
+    // sweeps back and forth, making the block of 1s 1 cell longer on each
+    // pass; each pass is 1 chain step and 1 normal step
+    const std::vector<Direction> kDirections = {
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '1', 'l', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateB, kStateB),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    const uint64_t kBlockSize = 1000000;
+    const TuringMachine kTuringMachine = TuringMachine({kStateA, kStateB,
+        kHaltingState}, kDirections, std::vector<char>(kBlockSize, '1'), '-',
+        kHaltingStateNames);
+    RunLengthMachine run_length_machine = RunLengthMachine(kTuringMachine);
+    // 10 passes, each is a chain across the block (except the cell added by
+    // the pass before) and 1 step adding a cell
+    uint64_t num_steps = 0;
+    for (uint64_t i = 0; i < 10; i++) {
+      num_steps += (i == 0 ? kBlockSize + 1 : kBlockSize + i);
+    }
+    const RunResult kResult = run_length_machine.Run(num_steps);
+    REQUIRE(kResult.num_steps == num_steps);
+    REQUIRE(run_length_machine.GetNumberOfChainSteps() == 10);
+    REQUIRE(run_length_machine.GetRunLengthTape().GetSize()
+        == kBlockSize + 10);
+    REQUIRE(run_length_machine.GetRunLengthTape().GetNumberOfRuns() <= 2);
+  }
+}
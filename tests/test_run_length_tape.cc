@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include "run_length_tape.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Run Length Tape Is Correctly Created
+ * Scanner Correctly Moves Across The Run Length Tape
+ * Chain Steps Correctly Rewrite Runs
+ */
+TEST_CASE("Test Run Length Tape Creation") {
+  SECTION("Test Empty Tape", "[initialization][empty]") {
+    const RunLengthTape kTape = RunLengthTape({}, '-', 0);
+    REQUIRE(kTape.GetCells() == std::vector<char>{'-'});
+    REQUIRE(kTape.GetNumberOfRuns() == 0);
+  }
+
+  SECTION("Test Default Tape", "[initialization][empty]") {
+    const RunLengthTape kTape = RunLengthTape();
+    REQUIRE(kTape.GetCells().empty());
+    REQUIRE(kTape.GetSize() == 0);
+  }
+
+  SECTION("Test Cells Are Stored As Runs", "[initialization][runs]") {
+    const std::vector<char> kCells = {'1', '1', '1', '0', '0', '1', '1'};
+    const RunLengthTape kTape = RunLengthTape(kCells, '0', 4);
+    REQUIRE(kTape.GetCells() == kCells);
+    REQUIRE(kTape.Read() == '0');
+    REQUIRE(kTape.GetIndexOfScanner() == 4);
+    REQUIRE(kTape.GetSize() == 7);
+    // 111 and 0 to the left of the scanner, 11 to the right
+    REQUIRE(kTape.GetNumberOfRuns() == 3);
+  }
+}
+
+TEST_CASE("Test Scanner Correctly Moves Across The Run Length Tape") {
+  SECTION("Test Moving And Writing", "[write][left][right]") {
+    RunLengthTape tape = RunLengthTape({'a', 'b', 'c'}, '-', 0);
+    tape.MoveRight();
+    tape.Write('x');
+    tape.MoveRight();
+    REQUIRE(tape.Read() == 'c');
+    tape.MoveLeft();
+    tape.MoveLeft();
+    REQUIRE(tape.Read() == 'a');
+    REQUIRE(tape.GetCells() == std::vector<char>({'a', 'x', 'c'}));
+  }
+
+  SECTION("Test Growing At Both Ends", "[grow][left][right]") {
+    RunLengthTape tape = RunLengthTape({'1'}, '-', 0);
+    tape.MoveLeft();
+    tape.MoveLeft();
+    REQUIRE(tape.Read() == '-');
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    for (size_t i = 0; i < 4; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.GetCells() == std::vector<char>({'-', '-', '1', '-', '-'}));
+    REQUIRE(tape.GetIndexOfScanner() == 4);
+  }
+}
+
+TEST_CASE("Test Chain Steps Correctly Rewrite Runs") {
+  SECTION("Test Chain Right Stops At Another Character", "[chain][right]") {
+    RunLengthTape tape = RunLengthTape({'1', '1', '1', '1', '0', '1'}, '-',
+        1);
+    REQUIRE(tape.ChainRight('x', 100) == 3);
+    REQUIRE(tape.Read() == '0');
+    REQUIRE(tape.GetIndexOfScanner() == 4);
+    REQUIRE(tape.GetCells() == std::vector<char>({'1', 'x', 'x', 'x', '0',
+        '1'}));
+  }
+
+  SECTION("Test Chain Left Stops At Another Character", "[chain][left]") {
+    RunLengthTape tape = RunLengthTape({'0', '1', '1', '1', '1'}, '-', 3);
+    REQUIRE(tape.ChainLeft('1', 100) == 3);
+    REQUIRE(tape.Read() == '0');
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    REQUIRE(tape.GetCells() == std::vector<char>({'0', '1', '1', '1', '1'}));
+    REQUIRE(tape.GetNumberOfRuns() == 1);
+  }
+
+  SECTION("Test Chain Stops After Max Cells", "[chain][right]") {
+    RunLengthTape tape = RunLengthTape(std::vector<char>(1000000, '1'), '-',
+        0);
+    REQUIRE(tape.ChainRight('0', 10) == 10);
+    REQUIRE(tape.GetIndexOfScanner() == 10);
+    REQUIRE(tape.Read() == '1');
+    REQUIRE(tape.GetNumberOfRuns() == 2);
+  }
+
+  SECTION("Test Chain Past The End Of The Tape", "[chain][right][grow]") {
+    // a run of blanks reaching past the end of the tape never ends
+    RunLengthTape tape = RunLengthTape({'1', '-', '-'}, '-', 1);
+    REQUIRE(tape.ChainRight('x', 5) == 5);
+    REQUIRE(tape.GetCells() == std::vector<char>({'1', 'x', 'x', 'x', 'x',
+        'x', '-'}));
+    REQUIRE(tape.GetIndexOfScanner() == 6);
+  }
+
+  SECTION("Test Chain Past The Start Of The Tape", "[chain][left][grow]") {
+    RunLengthTape tape = RunLengthTape({'-', '1'}, '-', 0);
+    REQUIRE(tape.ChainLeft('-', 3) == 3);
+    REQUIRE(tape.GetCells() == std::vector<char>({'-', '-', '-', '-', '1'}));
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+  }
+}
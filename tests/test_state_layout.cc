@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "state_layout.h"
+#include "turing_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Hot States Are Put Next To Each Other
+ * Turing Machines Behave The Same After Renumbering
+ */
+TEST_CASE("Test Hot States Are Put Next To Each Other") {
+  // cycles through the hot states while drifting right over blanks; the cold
+  // states, which are never run, sit between the hot states
+  const std::vector<std::string> kHaltingStateNames = {"qh"};
+  std::vector<State> states;
+  std::vector<State> hot_states;
+  for (int id = 1; id <= 128; id++) {
+    states.push_back(State(id, "q" + std::to_string(id), glm::vec2(0, 0), 5,
+        kHaltingStateNames));
+    if (id % 16 == 1) {
+      hot_states.push_back(states.back());
+    }
+  }
+  std::vector<Direction> directions;
+  for (size_t hot_state = 0; hot_state < hot_states.size(); hot_state++) {
+    directions.push_back(Direction('-', '-', 'r', hot_states[hot_state],
+        hot_states[(hot_state + 1) % hot_states.size()]));
+  }
+  for (const State &kState : states) {
+    directions.push_back(Direction('1', '1', 'l', kState, kState));
+  }
+  const std::shared_ptr<const Program> kProgram =
+      std::make_shared<const Program>(states, directions, kHaltingStateNames);
+
+  SECTION("Test Spread Of Table Accesses", "[layout][report]") {
+    StateLayoutProfiler profiler = StateLayoutProfiler(kProgram);
+    profiler.Profile(Tape({}, '-'), kProgram->GetStartingStateIndex(), 1000);
+    const StateLayoutReport kReport = profiler.GetReport();
+    REQUIRE(kReport.num_steps_profiled == 1000);
+    REQUIRE(kReport.mean_access_distance_after
+        < kReport.mean_access_distance_before);
+    REQUIRE(kReport.far_access_rate_before == 1);
+    // only the step from the last hot state back to the first is far
+    REQUIRE(kReport.far_access_rate_after < 0.2);
+  }
+
+  SECTION("Test Hot States Come First In Order", "[layout][order]") {
+    StateLayoutProfiler profiler = StateLayoutProfiler(kProgram);
+    profiler.Profile(Tape({}, '-'), kProgram->GetStartingStateIndex(), 100);
+    const std::vector<size_t> kStateOrder = profiler.GetStateOrder();
+    REQUIRE(kStateOrder.size() == states.size());
+    for (size_t hot_state = 0; hot_state < 8; hot_state++) {
+      REQUIRE(kStateOrder[hot_state] == hot_state * 16);
+    }
+    std::vector<size_t> sorted_state_order = kStateOrder;
+    std::sort(sorted_state_order.begin(), sorted_state_order.end());
+    for (size_t state = 0; state < sorted_state_order.size(); state++) {
+      REQUIRE(sorted_state_order[state] == state);
+    }
+  }
+
+  SECTION("Test Order Without Profiling", "[layout][order][empty]") {
+    const StateLayoutProfiler kProfiler = StateLayoutProfiler(kProgram);
+    const std::vector<size_t> kStateOrder = kProfiler.GetStateOrder();
+    for (size_t state = 0; state < kStateOrder.size(); state++) {
+      REQUIRE(kStateOrder[state] == state);
+    }
+    REQUIRE(kProfiler.GetReport().num_steps_profiled == 0);
+  }
+}
+
+TEST_CASE("Test Turing Machines Behave The Same After Renumbering") {
+  // cycles through the hot states while drifting right over blanks; the cold
+  // states, which are never run, sit between the hot states
+  const std::vector<std::string> kHaltingStateNames = {"qh"};
+  std::vector<State> states;
+  std::vector<State> hot_states;
+  for (int id = 1; id <= 40; id++) {
+    states.push_back(State(id, "q" + std::to_string(id), glm::vec2(0, 0), 5,
+        kHaltingStateNames));
+    if (id % 8 == 1) {
+      hot_states.push_back(states.back());
+    }
+  }
+  std::vector<Direction> directions;
+  for (size_t hot_state = 0; hot_state < hot_states.size(); hot_state++) {
+    directions.push_back(Direction('-', '-', 'r', hot_states[hot_state],
+        hot_states[(hot_state + 1) % hot_states.size()]));
+  }
+  for (const State &kState : states) {
+    directions.push_back(Direction('1', '1', 'l', kState, kState));
+  }
+  TuringMachine turing_machine = TuringMachine(states, directions, {'1',
+      '-', '-'}, '-', kHaltingStateNames);
+  turing_machine.Run(3);
+  TuringMachine unoptimized_turing_machine = turing_machine;
+
+  SECTION("Test Run After Renumbering", "[layout][run]") {
+    const int kStateId = turing_machine.GetCurrentStateId();
+    const StateLayoutReport kReport = turing_machine.OptimizeStateLayout(500);
+    REQUIRE(kReport.num_steps_profiled == 500);
+    REQUIRE(turing_machine.GetCurrentStateId() == kStateId);
+    REQUIRE(turing_machine.GetNumberOfSteps() == 3);
+    REQUIRE(turing_machine.GetProgram()
+        != unoptimized_turing_machine.GetProgram());
+    turing_machine.Run(10000);
+    unoptimized_turing_machine.Run(10000);
+    REQUIRE(turing_machine.GetTape() == unoptimized_turing_machine.GetTape());
+    REQUIRE(turing_machine.GetPositionOfScanner()
+        == unoptimized_turing_machine.GetPositionOfScanner());
+    REQUIRE(turing_machine.GetCurrentStateId()
+        == unoptimized_turing_machine.GetCurrentStateId());
+  }
+
+  SECTION("Test Empty Turing Machine", "[layout][empty]") {
+    TuringMachine empty_turing_machine = TuringMachine();
+    REQUIRE(empty_turing_machine.OptimizeStateLayout(100).num_steps_profiled
+        == 0);
+    REQUIRE(empty_turing_machine.IsEmpty());
+  }
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+
+#include "static_turing_machine.h"
+#include "turing_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Static Turing Machine Is Correctly Created
+ * Static Turing Machine Matches The Turing Machine
+ */
+TEST_CASE("Test Static Turing Machine Creation") {
+  typedef StaticTuringMachine<StaticHaltingStates<2>,
+      StaticDirection<1, '-', '1', 'r', 1>> WriteOnesMachine;
+
+  SECTION("Test Configuration Is Copied", "[initialization]") {
+    const std::vector<char> kTape = {'a', 'b', 'c'};
+    const WriteOnesMachine kStaticTuringMachine = WriteOnesMachine(1, kTape,
+        '-');
+    REQUIRE(kStaticTuringMachine.GetTape() == kTape);
+    REQUIRE(kStaticTuringMachine.GetIndexOfScanner() == 0);
+    REQUIRE(kStaticTuringMachine.GetCurrentStateId() == 1);
+    REQUIRE(kStaticTuringMachine.IsHalted() == false);
+    REQUIRE(kStaticTuringMachine.GetConfigurationForConsole({State(1, "q1",
+        glm::vec2(0, 0), 5, {})}) == ";q1abc");
+  }
+
+  SECTION("Test Starting State Without Directions", "[initialization][stuck]") {
+    WriteOnesMachine static_turing_machine = WriteOnesMachine(3, {}, '-');
+    REQUIRE(static_turing_machine.Run(10).num_steps == 0);
+    REQUIRE(static_turing_machine.GetCurrentStateId() == 3);
+  }
+}
+
+TEST_CASE("Test Static Turing Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    typedef StaticTuringMachine<StaticHaltingStates<5>,
+        StaticDirection<1, '0', '1', 'r', 2>,
+        StaticDirection<1, '1', '1', 'l', 2>,
+        StaticDirection<2, '0', '1', 'l', 1>,
+        StaticDirection<2, '1', '0', 'l', 3>,
+        StaticDirection<3, '0', '1', 'r', 5>,
+        StaticDirection<3, '1', '1', 'l', 4>,
+        StaticDirection<4, '0', '1', 'r', 4>,
+        StaticDirection<4, '1', '0', 'r', 1>> BusyBeaver;
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    BusyBeaver static_turing_machine = BusyBeaver(1, {'0'}, '0');
+    const RunResult kResult = static_turing_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(static_turing_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(static_turing_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(static_turing_machine.GetConfigurationForConsole(kStates)
+        == turing_machine.GetConfigurationForConsole());
+    REQUIRE(static_turing_machine.GetConfigurationForMarkdown(kStates)
+        == turing_machine.GetConfigurationForMarkdown());
+  }
+
+  SECTION("Test Binary Counter With Step Budgets", "[run][left][right]") {
+    typedef StaticTuringMachine<StaticHaltingStates<5>,
+        StaticDirection<1, '0', '0', 'r', 1>,
+        StaticDirection<1, '1', '1', 'r', 1>,
+        StaticDirection<1, '-', '-', 'l', 2>,
+        StaticDirection<2, '1', '0', 'l', 2>,
+        StaticDirection<2, '0', '1', 'r', 1>,
+        StaticDirection<2, '-', '1', 'r', 1>> BinaryCounter;
+    const std::vector<Direction> kDirections = {
+        Direction('0', '0', 'r', kStateA, kStateA),
+        Direction('1', '1', 'r', kStateA, kStateA),
+        Direction('-', '-', 'l', kStateA, kStateB),
+        Direction('1', '0', 'l', kStateB, kStateB),
+        Direction('0', '1', 'r', kStateB, kStateA),
+        Direction('-', '1', 'r', kStateB, kStateA)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        {'0', '1', '1'}, '-', kHaltingStateNames);
+    BinaryCounter static_turing_machine = BinaryCounter(1, {'0', '1', '1'},
+        '-');
+    const uint64_t kBudgets[] = {1, 7, 100, 1234, 20000};
+    for (uint64_t budget : kBudgets) {
+      turing_machine.Run(budget);
+      const RunResult kResult = static_turing_machine.Run(budget);
+      REQUIRE(kResult.num_steps == budget);
+      REQUIRE(static_turing_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(static_turing_machine.GetIndexOfScanner()
+          == turing_machine.GetIndexOfScanner());
+      REQUIRE(static_turing_machine.GetCurrentStateId()
+          == turing_machine.GetCurrentState().GetId());
+    }
+  }
+
+  SECTION("Test Machine That Gets Stuck", "[run][stuck][no move]") {
+    typedef StaticTuringMachine<StaticHaltingStates<5>,
+        StaticDirection<1, '-', '1', 'l', 1>,
+        StaticDirection<1, 'x', 'y', 'n', 2>,
+        StaticDirection<2, 'y', 'z', 'n', 3>> StuckMachine;
+    StuckMachine static_turing_machine = StuckMachine(1, {'x', '-'}, '-');
+    const RunResult kResult = static_turing_machine.Run(50);
+    REQUIRE(kResult.num_steps == 2);
+    REQUIRE(kResult.final_state_id == kStateC.GetId());
+    REQUIRE(static_turing_machine.GetTape() == std::vector<char>({'z', '-'}));
+  }
+
+  SECTION("Test Halting State With Directions", "[run][halt]") {
+    typedef StaticTuringMachine<StaticHaltingStates<5>,
+        StaticDirection<1, '-', '1', 'r', 5>,
+        StaticDirection<5, '-', '2', 'l', 1>,
+        StaticDirection<1, '1', '3', 'r', 5>,
+        StaticDirection<5, '2', '4', 'r', 2>> HaltingMachine;
+    const std::vector<Direction> kDirections = {
+        Direction('-', '1', 'r', kStateA, kHaltingState),
+        Direction('-', '2', 'l', kHaltingState, kStateA),
+        Direction('1', '3', 'r', kStateA, kHaltingState),
+        Direction('2', '4', 'r', kHaltingState, kStateB)};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {},
+        '-', kHaltingStateNames);
+    HaltingMachine run_machine = HaltingMachine(1, {}, '-');
+    HaltingMachine halt_machine = HaltingMachine(1, {}, '-');
+    REQUIRE(halt_machine.RunUntilHalt(10).num_steps == 1);
+    REQUIRE(run_machine.Run(10).num_steps == 4);
+    turing_machine.Run(10);
+    REQUIRE(run_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(run_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(run_machine.GetCurrentStateId() == kStateB.GetId());
+    REQUIRE(run_machine.IsHalted());
+  }
+}
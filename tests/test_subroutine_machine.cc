@@ -0,0 +1,205 @@
+#include <catch2/catch.hpp>
+
+#include "subroutine_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Subroutine Machine Is Correctly Created
+ * Repeated Calls Are Replayed And Match The Turing Machine
+ * Calls Are Keyed By The Cells They Read
+ * Calls That Cannot Be Memoized Run Step By Step
+ */
+TEST_CASE("Test Subroutine Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(2, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[initialization][empty]") {
+    SubroutineMachine subroutine_machine = SubroutineMachine(TuringMachine(),
+        {});
+    REQUIRE(subroutine_machine.IsEmpty());
+    REQUIRE(subroutine_machine.Run(10).num_steps == 0);
+  }
+
+  SECTION("Test Halting Entry State Is Ignored", "[initialization]") {
+    const TuringMachine kTuringMachine = TuringMachine({kStartingState,
+        kHaltingState}, {Direction('-', '1', 'r', kStartingState,
+        kHaltingState)}, {}, '-', kHaltingStateNames);
+    Subroutine subroutine;
+    subroutine.entry_state = kHaltingState;
+    SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+        {subroutine});
+    REQUIRE(subroutine_machine.IsEmpty() == false);
+    REQUIRE(subroutine_machine.GetCurrentState().Equals(kStartingState));
+    REQUIRE(subroutine_machine.RunUntilHalt(10).num_steps == 1);
+    REQUIRE(subroutine_machine.GetTape() == std::vector<char>({'1', '-'}));
+    REQUIRE(subroutine_machine.GetNumberOfReplayedCalls() == 0);
+  }
+}
+
+TEST_CASE("Test Repeated Calls Are Replayed And Match The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kMainState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kSwapState = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kSecondSwapState = State(3, "q3", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(4, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // the main loop calls a gadget that swaps each "ab" into "ba" and returns
+  // to the main loop on the next pair
+  const std::vector<Direction> kDirections = {
+      Direction('a', 'a', 'n', kMainState, kSwapState),
+      Direction('-', '-', 'n', kMainState, kHaltingState),
+      Direction('a', 'b', 'r', kSwapState, kSecondSwapState),
+      Direction('b', 'a', 'r', kSecondSwapState, kMainState)};
+  std::vector<char> tape;
+  for (size_t pair = 0; pair < 100; pair++) {
+    tape.push_back('a');
+    tape.push_back('b');
+  }
+  const TuringMachine kTuringMachine = TuringMachine({kMainState, kSwapState,
+      kSecondSwapState, kHaltingState}, kDirections, tape, '-',
+      kHaltingStateNames);
+  Subroutine swap_subroutine;
+  swap_subroutine.entry_state = kSwapState;
+  swap_subroutine.states = {kSecondSwapState};
+  swap_subroutine.exit_states = {kMainState};
+  swap_subroutine.window_radius = 3;
+
+  SECTION("Test Run Until Halt", "[run][memoize]") {
+    SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+        {swap_subroutine});
+    TuringMachine turing_machine = kTuringMachine;
+    const RunResult kResult = subroutine_machine.RunUntilHalt(10000);
+    const RunResult kExpectedResult = turing_machine.RunUntilHalt(10000);
+    REQUIRE(kResult.num_steps == kExpectedResult.num_steps);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.index_of_scanner == kExpectedResult.index_of_scanner);
+    REQUIRE(subroutine_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(subroutine_machine.GetPositionOfScanner()
+        == turing_machine.GetPositionOfScanner());
+    // every call reads the same 2 cells, so only the first is simulated
+    REQUIRE(subroutine_machine.GetNumberOfReplayedCalls() == 99);
+    REQUIRE(subroutine_machine.GetNumberOfMemoizedEffects() == 1);
+  }
+
+  SECTION("Test Step Budgets Inside Calls", "[run][memoize]") {
+    for (uint64_t num_steps = 0; num_steps < 12; num_steps++) {
+      SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+          {swap_subroutine});
+      TuringMachine turing_machine = kTuringMachine;
+      REQUIRE(subroutine_machine.Run(num_steps).num_steps
+          == turing_machine.Run(num_steps).num_steps);
+      REQUIRE(subroutine_machine.GetCurrentState().Equals(
+          turing_machine.GetCurrentState()));
+      REQUIRE(subroutine_machine.GetTape() == turing_machine.GetTape());
+      REQUIRE(subroutine_machine.GetNumberOfSteps() == num_steps);
+    }
+  }
+}
+
+TEST_CASE("Test Calls Are Keyed By The Cells They Read") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kMainState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kIncrementState = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kReturnState = State(3, "q3", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // the main loop calls a gadget that increments a binary counter (least
+  // significant bit first, right of a '#') and returns to its first bit
+  const std::vector<Direction> kDirections = {
+      Direction('#', '#', 'r', kMainState, kMainState),
+      Direction('0', '0', 'n', kMainState, kIncrementState),
+      Direction('1', '1', 'n', kMainState, kIncrementState),
+      Direction('1', '0', 'r', kIncrementState, kIncrementState),
+      Direction('0', '1', 'l', kIncrementState, kReturnState),
+      Direction('-', '1', 'l', kIncrementState, kReturnState),
+      Direction('0', '0', 'l', kReturnState, kReturnState),
+      Direction('#', '#', 'r', kReturnState, kMainState)};
+  std::vector<char> tape = {'#', '0'};
+  tape.resize(200, '0');
+  const TuringMachine kTuringMachine = TuringMachine({kMainState,
+      kIncrementState, kReturnState}, kDirections, tape, '-',
+      kHaltingStateNames);
+  Subroutine increment_subroutine;
+  increment_subroutine.entry_state = kIncrementState;
+  increment_subroutine.states = {kReturnState};
+  increment_subroutine.exit_states = {kMainState};
+  increment_subroutine.window_radius = 64;
+
+  SECTION("Test Counter", "[run][memoize]") {
+    SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+        {increment_subroutine});
+    TuringMachine turing_machine = kTuringMachine;
+    REQUIRE(subroutine_machine.Run(1000000).num_steps == 1000000);
+    REQUIRE(turing_machine.Run(1000000).num_steps == 1000000);
+    REQUIRE(subroutine_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(subroutine_machine.GetCurrentState().Equals(
+        turing_machine.GetCurrentState()));
+    // the 200 cells of the counter differ on every call, but each call only
+    // reads its trailing 1s, the 0 after them, and the cells back to '#'
+    REQUIRE(subroutine_machine.GetNumberOfMemoizedEffects() <= 20);
+    REQUIRE(subroutine_machine.GetNumberOfReplayedCalls() > 100000);
+  }
+}
+
+TEST_CASE("Test Calls That Cannot Be Memoized Run Step By Step") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kMainState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kGadgetState = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // the gadget runs right to the end of the 1s, then returns
+  const TuringMachine kTuringMachine = TuringMachine({kMainState,
+      kGadgetState, kHaltingState}, {
+      Direction('0', '0', 'r', kMainState, kGadgetState),
+      Direction('1', '1', 'r', kGadgetState, kGadgetState),
+      Direction('0', '0', 'n', kGadgetState, kMainState),
+      Direction('-', '-', 'n', kMainState, kHaltingState)},
+      {'0', '1', '1', '1', '1', '1', '0', '1', '0', '1', '0'}, '-',
+      kHaltingStateNames);
+  Subroutine gadget_subroutine;
+  gadget_subroutine.entry_state = kGadgetState;
+  gadget_subroutine.exit_states = {kMainState};
+  gadget_subroutine.window_radius = 2;
+  TuringMachine turing_machine = kTuringMachine;
+  const RunResult kExpectedResult = turing_machine.RunUntilHalt(100);
+
+  SECTION("Test Call Leaving The Window", "[run][window]") {
+    SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+        {gadget_subroutine});
+    REQUIRE(subroutine_machine.RunUntilHalt(100).num_steps
+        == kExpectedResult.num_steps);
+    REQUIRE(subroutine_machine.GetTape() == turing_machine.GetTape());
+    // the call on the run of 5 1s leaves the window after 3 of them, and the
+    // gadget re-enters its entry state there for a call that fits; the 2
+    // runs of 1 1 read the same cells, so the second is replayed
+    REQUIRE(subroutine_machine.GetNumberOfReplayedCalls() == 1);
+    REQUIRE(subroutine_machine.GetNumberOfMemoizedEffects() == 2);
+  }
+
+  SECTION("Test Call Returning To A State That Is Not An Exit",
+      "[run][exit]") {
+    gadget_subroutine.exit_states.clear();
+    SubroutineMachine subroutine_machine = SubroutineMachine(kTuringMachine,
+        {gadget_subroutine});
+    REQUIRE(subroutine_machine.RunUntilHalt(100).num_steps
+        == kExpectedResult.num_steps);
+    REQUIRE(subroutine_machine.GetTape() == turing_machine.GetTape());
+    REQUIRE(subroutine_machine.GetNumberOfReplayedCalls() == 0);
+    REQUIRE(subroutine_machine.GetNumberOfMemoizedEffects() == 0);
+  }
+}
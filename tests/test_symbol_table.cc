@@ -0,0 +1,44 @@
+#include <catch2/catch.hpp>
+
+#include "symbol_table.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Symbols Are Interned To Dense Ids
+ */
+TEST_CASE("Test Symbols Are Interned To Dense Ids") {
+  SECTION("Test Empty Table", "[initialization][empty]") {
+    const SymbolTable kSymbolTable = SymbolTable();
+    REQUIRE(kSymbolTable.GetSize() == 0);
+    REQUIRE(kSymbolTable.GetId("a") == 0);
+  }
+
+  SECTION("Test Ids Are Given In Order", "[intern]") {
+    SymbolTable symbol_table = SymbolTable();
+    REQUIRE(symbol_table.Intern("_") == 0);
+    REQUIRE(symbol_table.Intern("a") == 1);
+    REQUIRE(symbol_table.Intern("track1:a|track2:b") == 2);
+    REQUIRE(symbol_table.GetSize() == 3);
+    REQUIRE(symbol_table.GetSymbol(2) == "track1:a|track2:b");
+  }
+
+  SECTION("Test Interning A Symbol Twice", "[intern]") {
+    SymbolTable symbol_table = SymbolTable();
+    symbol_table.Intern("a");
+    symbol_table.Intern("b");
+    REQUIRE(symbol_table.Intern("a") == 0);
+    REQUIRE(symbol_table.GetId("b") == 1);
+    REQUIRE(symbol_table.GetSize() == 2);
+  }
+
+  SECTION("Test More Than 256 Symbols", "[intern]") {
+    SymbolTable symbol_table = SymbolTable();
+    for (size_t i = 0; i < 1000; i++) {
+      REQUIRE(symbol_table.Intern("s" + std::to_string(i)) == i);
+    }
+    REQUIRE(symbol_table.GetId("s999") == 999);
+    REQUIRE(symbol_table.GetId("s1000") == 1000);
+  }
+}
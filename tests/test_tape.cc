@@ -0,0 +1,269 @@
+#include <catch2/catch.hpp>
+
+#include "symbol_table.h"
+#include "tape.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Tape Is Correctly Created
+ * Scanner Correctly Reads And Writes
+ * Tape Correctly Grows At Both Ends
+ * Tape Views Match The Cells Of The Tape
+ * Tapes Of Symbol Ids Behave Like Tapes Of Chars
+ * Runs Of Equal Cells Are Correctly Skipped
+ * Blank Margins Of The Tape Are Correctly Trimmed
+ */
+TEST_CASE("Test Tape Creation") {
+  SECTION("Test Empty Tape", "[initialization][empty]") {
+    const Tape kTape = Tape({}, '-');
+    REQUIRE(kTape.GetCells() == std::vector<char>({'-'}));
+    REQUIRE(kTape.GetSize() == 1);
+    REQUIRE(kTape.GetIndexOfScanner() == 0);
+    REQUIRE(kTape.GetPositionOfScanner() == 0);
+    REQUIRE(kTape.GetBlankCharacter() == '-');
+  }
+
+  SECTION("Test Non-Empty Tape", "[initialization]") {
+    const std::vector<char> kCells = {'0', '1', '-'};
+    const Tape kTape = Tape(kCells, '-');
+    REQUIRE(kTape.GetCells() == kCells);
+    REQUIRE(kTape.GetSize() == 3);
+    REQUIRE(kTape.GetCell(1) == '1');
+    REQUIRE(kTape.Read() == '0');
+  }
+}
+
+TEST_CASE("Test Scanner Correctly Reads And Writes") {
+  Tape tape = Tape({'a', 'b', 'c'}, '-');
+
+  SECTION("Test Write", "[write]") {
+    tape.Write('x');
+    REQUIRE(tape.Read() == 'x');
+    REQUIRE(tape.GetCells() == std::vector<char>({'x', 'b', 'c'}));
+  }
+
+  SECTION("Test Read After Moving", "[read][right][left]") {
+    tape.MoveRight();
+    tape.MoveRight();
+    REQUIRE(tape.Read() == 'c');
+    tape.MoveLeft();
+    REQUIRE(tape.Read() == 'b');
+    REQUIRE(tape.GetIndexOfScanner() == 1);
+    REQUIRE(tape.GetSize() == 3);
+  }
+}
+
+TEST_CASE("Test Tape Correctly Grows") {
+  Tape tape = Tape({'0', '1'}, '-');
+
+  SECTION("Test Growing At Front", "[tape expansion][left]") {
+    tape.MoveLeft();
+    REQUIRE(tape.GetCells() == std::vector<char>({'-', '0', '1'}));
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    REQUIRE(tape.GetPositionOfScanner() == -1);
+    REQUIRE(tape.Read() == '-');
+  }
+
+  SECTION("Test Growing At End", "[tape expansion][right]") {
+    tape.MoveRight();
+    tape.MoveRight();
+    REQUIRE(tape.GetCells() == std::vector<char>({'0', '1', '-'}));
+    REQUIRE(tape.GetIndexOfScanner() == 2);
+    REQUIRE(tape.GetPositionOfScanner() == 2);
+  }
+
+  SECTION("Test Growing Past The Headroom At Both Ends",
+      "[tape expansion][left][right]") {
+    const int kNumCellsToGrow = 1000;
+    for (int i = 0; i < kNumCellsToGrow; i++) {
+      tape.Write('x');
+      tape.MoveLeft();
+    }
+    REQUIRE(tape.GetSize() == 2 + kNumCellsToGrow);
+    REQUIRE(tape.GetPositionOfScanner() == -kNumCellsToGrow);
+    // the cells the tape started with must not move
+    REQUIRE(tape.GetCell(kNumCellsToGrow) == 'x');
+    REQUIRE(tape.GetCell(kNumCellsToGrow + 1) == '1');
+
+    for (int i = 0; i < 2 * kNumCellsToGrow; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.GetSize() == 1 + 2 * kNumCellsToGrow);
+    REQUIRE(tape.GetIndexOfScanner() == 2 * kNumCellsToGrow);
+    REQUIRE(tape.GetPositionOfScanner() == kNumCellsToGrow);
+    REQUIRE(tape.Read() == '-');
+    REQUIRE(tape.GetCell(0) == '-');
+  }
+}
+
+TEST_CASE("Test Tape Views Match The Cells Of The Tape") {
+  SECTION("Test View Of New Tape", "[view]") {
+    const Tape kTape = Tape({'a', 'b', 'c'}, '-');
+    const TapeView kTapeView = kTape.GetView();
+    REQUIRE(kTapeView.GetSize() == 3);
+    REQUIRE(kTapeView.GetIndexOfScanner() == 0);
+    REQUIRE(std::vector<char>(kTapeView.begin(), kTapeView.end())
+        == kTape.GetCells());
+    REQUIRE(kTapeView[1] == 'b');
+  }
+
+  SECTION("Test View After Growing At Both Ends", "[view][grow]") {
+    Tape tape = Tape({'a'}, '-');
+    for (size_t i = 0; i < 40; i++) {
+      tape.MoveLeft();
+    }
+    tape.Write('x');
+    for (size_t i = 0; i < 100; i++) {
+      tape.MoveRight();
+    }
+    const TapeView kTapeView = tape.GetView();
+    REQUIRE(kTapeView.GetSize() == tape.GetSize());
+    REQUIRE(kTapeView.GetIndexOfScanner() == tape.GetIndexOfScanner());
+    REQUIRE(std::vector<char>(kTapeView.begin(), kTapeView.end())
+        == tape.GetCells());
+    REQUIRE(kTapeView[0] == 'x');
+  }
+
+  SECTION("Test View Of Default Tape", "[view][empty]") {
+    const TapeView kTapeView = Tape().GetView();
+    REQUIRE(kTapeView.IsEmpty());
+    REQUIRE(kTapeView.begin() == kTapeView.end());
+  }
+}
+
+TEST_CASE("Test Tapes Of Symbol Ids Behave Like Tapes Of Chars") {
+  SECTION("Test Reading, Writing, And Growing", "[symbols][grow]") {
+    // ids past 255 do not fit in a char
+    BasicTape<SymbolId> tape = BasicTape<SymbolId>({300, 7}, 0);
+    REQUIRE(tape.Read() == 300);
+    tape.MoveLeft();
+    REQUIRE(tape.Read() == 0);
+    tape.Write(1000);
+    for (size_t i = 0; i < 3; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.GetCells() == std::vector<SymbolId>{1000, 300, 7, 0});
+    REQUIRE(tape.GetPositionOfScanner() == 2);
+    const BasicTapeView<SymbolId> kTapeView = tape.GetView();
+    REQUIRE(kTapeView[1] == 300);
+    REQUIRE(kTapeView.GetIndexOfScanner() == 3);
+  }
+}
+
+TEST_CASE("Test Runs Of Equal Cells Are Correctly Skipped") {
+  // runs long enough to be compared in blocks, with the other character at
+  // every offset within a block
+  SECTION("Test Skipping Right To Another Character", "[skip][right]") {
+    for (size_t run_length = 0; run_length < 100; run_length++) {
+      std::vector<char> cells(run_length, '1');
+      cells.push_back('0');
+      cells.push_back('1');
+      Tape tape = Tape(cells, '-');
+      REQUIRE(tape.SkipRight('1', 1000) == run_length);
+      REQUIRE(tape.Read() == '0');
+    }
+  }
+
+  SECTION("Test Skipping Left To Another Character", "[skip][left]") {
+    for (size_t run_length = 0; run_length < 100; run_length++) {
+      std::vector<char> cells = {'1', '0'};
+      cells.insert(cells.end(), run_length, '1');
+      Tape tape = Tape(cells, '-');
+      for (size_t i = 0; i < cells.size() - 1; i++) {
+        tape.MoveRight();
+      }
+      REQUIRE(tape.SkipLeft('1', 1000) == run_length);
+      REQUIRE(tape.Read() == '0');
+      REQUIRE(tape.GetIndexOfScanner() == 1);
+    }
+  }
+
+  SECTION("Test Skipping Stops After Max Cells", "[skip][right][left]") {
+    Tape tape = Tape(std::vector<char>(200, '1'), '-');
+    REQUIRE(tape.SkipRight('1', 150) == 150);
+    REQUIRE(tape.GetIndexOfScanner() == 150);
+    REQUIRE(tape.SkipLeft('1', 77) == 77);
+    REQUIRE(tape.GetIndexOfScanner() == 73);
+  }
+
+  SECTION("Test Skipping Stops At The Ends Of The Tape",
+      "[skip][right][left]") {
+    Tape tape = Tape(std::vector<char>(200, '1'), '-');
+    REQUIRE(tape.SkipRight('1', 1000) == 199);
+    REQUIRE(tape.GetIndexOfScanner() == 199);
+    REQUIRE(tape.SkipLeft('1', 1000) == 199);
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    REQUIRE(tape.GetSize() == 200);
+  }
+
+  SECTION("Test Skipping On A Tape Of Symbol Ids", "[skip][symbols]") {
+    BasicTape<SymbolId> tape = BasicTape<SymbolId>({400, 400, 400, 2, 400},
+        0);
+    REQUIRE(tape.SkipRight(400, 1000) == 3);
+    REQUIRE(tape.Read() == 2);
+    tape.MoveRight();
+    tape.MoveLeft();
+    tape.MoveLeft();
+    REQUIRE(tape.SkipLeft(400, 1000) == 2);
+  }
+}
+
+TEST_CASE("Test Blank Margins Of The Tape Are Correctly Trimmed") {
+  SECTION("Test Every Cell Is Kept Without A Margin", "[trim]") {
+    Tape tape = Tape({}, '-');
+    for (size_t i = 0; i < 1000; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.GetMaxBlankMargin() == 0);
+    REQUIRE(tape.GetSize() == 1001);
+    REQUIRE(tape.GetPositionOfFirstCell() == 0);
+  }
+
+  SECTION("Test Drifting Right Over Blanks", "[trim][grow]") {
+    Tape tape = Tape({}, '-');
+    tape.SetMaxBlankMargin(8);
+    for (size_t i = 0; i < 100000; i++) {
+      tape.MoveRight();
+      REQUIRE(tape.GetSize() <= 64);
+    }
+    REQUIRE(tape.GetPositionOfScanner() == 100000);
+    REQUIRE(tape.GetPositionOfFirstCell()
+        + static_cast<int64_t>(tape.GetIndexOfScanner()) == 100000);
+    REQUIRE(tape.GetIndexOfScanner() + 1 == tape.GetSize());
+  }
+
+  SECTION("Test Drifting Left Over Blanks", "[trim][grow]") {
+    Tape tape = Tape({'-', '-'}, '-', 1, 1);
+    tape.SetMaxBlankMargin(4);
+    for (size_t i = 0; i < 10000; i++) {
+      tape.MoveLeft();
+      REQUIRE(tape.GetSize() <= 64);
+    }
+    REQUIRE(tape.GetPositionOfScanner() == -9999);
+    REQUIRE(tape.GetIndexOfScanner() == 0);
+    REQUIRE(tape.GetPositionOfFirstCell() == -9999);
+  }
+
+  SECTION("Test Written Cells Are Kept", "[trim][write]") {
+    Tape tape = Tape({'a', '-', 'b'}, '-');
+    tape.SetMaxBlankMargin(2);
+    for (size_t i = 0; i < 100; i++) {
+      tape.MoveRight();
+    }
+    tape.Write('c');
+    for (size_t i = 0; i < 200; i++) {
+      tape.MoveLeft();
+    }
+    // the blanks between the written cells are kept, the blanks beyond 'c'
+    // are dropped
+    REQUIRE(tape.GetPositionOfFirstCell() <= -100);
+    REQUIRE(tape.GetCell(static_cast<size_t>(-tape.GetPositionOfFirstCell()))
+        == 'a');
+    REQUIRE(tape.GetPositionOfFirstCell()
+        + static_cast<int64_t>(tape.GetSize()) == 101);
+    REQUIRE(tape.GetCell(tape.GetSize() - 1) == 'c');
+    REQUIRE(tape.GetPositionOfScanner() == -100);
+  }
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include "tape.h"
+#include "tape_generator.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Tape Generators Give The Cells They Describe
+ * Tapes Generate Their Cells As They Grow
+ */
+TEST_CASE("Test Tape Generators Give The Cells They Describe") {
+  SECTION("Test Repeated Patterns", "[generate][pattern]") {
+    const TapeGenerator kTapeGenerator = TapeGenerator({{{'1'}, 3}, {{'0'},
+        1}, {{}, 5}, {{'a', 'b'}, 0}, {{'a', 'b', 'c'}, 2}});
+    REQUIRE(kTapeGenerator.GetNumberOfCells() == 10);
+    std::vector<char> cells(10);
+    kTapeGenerator.Generate(0, 10, cells.data());
+    REQUIRE(cells == std::vector<char>({'1', '1', '1', '0', 'a', 'b', 'c',
+        'a', 'b', 'c'}));
+    std::vector<char> middle_cells(4);
+    kTapeGenerator.Generate(5, 4, middle_cells.data());
+    REQUIRE(middle_cells == std::vector<char>({'b', 'c', 'a', 'b'}));
+  }
+
+  SECTION("Test Huge Repeated Patterns", "[generate][pattern]") {
+    const uint64_t kNumOnes = static_cast<uint64_t>(1) << 40;
+    const TapeGenerator kTapeGenerator = TapeGenerator({{{'1'}, kNumOnes},
+        {{'0'}, 1}, {{'1'}, kNumOnes}});
+    REQUIRE(kTapeGenerator.GetNumberOfCells() == 2 * kNumOnes + 1);
+    std::vector<char> cells(3);
+    kTapeGenerator.Generate(kNumOnes - 1, 3, cells.data());
+    REQUIRE(cells == std::vector<char>({'1', '0', '1'}));
+  }
+
+  SECTION("Test Function Of The Position", "[generate][function]") {
+    const TapeGenerator kTapeGenerator = TapeGenerator([](uint64_t position) {
+      return position % 3 == 0 ? 'x' : 'y';
+    }, 7);
+    REQUIRE(kTapeGenerator.GetNumberOfCells() == 7);
+    std::vector<char> cells(4);
+    kTapeGenerator.Generate(2, 4, cells.data());
+    REQUIRE(cells == std::vector<char>({'y', 'x', 'y', 'y'}));
+  }
+}
+
+TEST_CASE("Test Tapes Generate Their Cells As They Grow") {
+  const TapeGenerator kTapeGenerator = TapeGenerator({{{'1'}, 1000}, {{'0'},
+      1}, {{'1'}, 1000}});
+
+  SECTION("Test Only Reached Cells Are On The Tape", "[generate][tape]") {
+    Tape tape = Tape(kTapeGenerator, '-');
+    REQUIRE(tape.IsGenerated());
+    REQUIRE(tape.GetCells() == std::vector<char>({'1'}));
+    for (size_t i = 0; i < 1000; i++) {
+      tape.MoveRight();
+    }
+    REQUIRE(tape.Read() == '0');
+    REQUIRE(tape.GetSize() == 1001);
+    for (size_t i = 0; i < 1001; i++) {
+      tape.MoveRight();
+    }
+    // the cells after the generated tape are blank
+    REQUIRE(tape.Read() == '-');
+    REQUIRE(tape.GetCell(2000) == '1');
+  }
+
+  SECTION("Test Blank Cells Left Of The Tape", "[generate][tape]") {
+    Tape tape = Tape(kTapeGenerator, '-');
+    tape.MoveLeft();
+    REQUIRE(tape.Read() == '-');
+    REQUIRE(tape.GetCells() == std::vector<char>({'-', '1'}));
+  }
+
+  SECTION("Test Erased Cells Stay Erased", "[generate][trim]") {
+    Tape tape = Tape(kTapeGenerator, '-');
+    tape.SetMaxBlankMargin(4);
+    for (size_t i = 0; i < 500; i++) {
+      tape.Write('-');
+      tape.MoveRight();
+    }
+    for (size_t i = 0; i < 500; i++) {
+      tape.MoveLeft();
+    }
+    // the erased cells were dropped from the tape, and come back blank
+    // instead of generated again
+    REQUIRE(tape.GetPositionOfScanner() == 0);
+    REQUIRE(tape.Read() == '-');
+    REQUIRE(tape.GetCell(tape.GetSize() - 1) == '1');
+  }
+}
@@ -0,0 +1,285 @@
+#include <catch2/catch.hpp>
+
+#include "transition_table.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * States Are Given Dense Indices
+ * Transitions Are Correctly Compiled From Directions
+ * Halting States Are Correctly Marked
+ * Sweep Transitions Are Correctly Detected
+ * Chains Of Transitions Are Correctly Fused
+ * States Are Correctly Reordered
+ */
+TEST_CASE("Test States Are Given Dense Indices") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kStateTwo = State(20, "q2",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const State kHaltingState = State(7, "qh",
+      glm::vec2(5, 6), 3, kHaltingStateNames);
+
+  SECTION("Test Empty Table", "[initialization][empty]") {
+    const TransitionTable kTransitionTable = TransitionTable();
+    REQUIRE(kTransitionTable.IsEmpty());
+    REQUIRE(kTransitionTable.GetNumberOfStates() == 0);
+  }
+
+  SECTION("Test States Are Indexed In Order", "[initialization][state index]") {
+    const std::vector<State> kStates = {kStartingState, kStateTwo,
+        kHaltingState};
+    const TransitionTable kTransitionTable = TransitionTable(kStates, {},
+        kHaltingStateNames);
+    REQUIRE(kTransitionTable.IsEmpty() == false);
+    REQUIRE(kTransitionTable.GetNumberOfStates() == 3);
+    REQUIRE(kTransitionTable.GetStateIndex(kStartingState) == 0);
+    REQUIRE(kTransitionTable.GetStateIndex(kStateTwo) == 1);
+    REQUIRE(kTransitionTable.GetStateIndex(kHaltingState) == 2);
+    REQUIRE(kTransitionTable.GetState(1).Equals(kStateTwo));
+  }
+
+  SECTION("Test States Only In Directions Are Indexed",
+      "[initialization][state index]") {
+    const std::vector<State> kStates = {kStartingState};
+    const Direction kDirection = Direction('0', '1', 'r', kStartingState,
+        kStateTwo);
+    const TransitionTable kTransitionTable = TransitionTable(kStates,
+        {kDirection}, kHaltingStateNames);
+    REQUIRE(kTransitionTable.GetNumberOfStates() == 2);
+    REQUIRE(kTransitionTable.GetStateIndex(kStateTwo) == 1);
+  }
+
+  SECTION("Test Unknown State", "[state index]") {
+    const std::vector<State> kStates = {kStartingState, kStateTwo};
+    const TransitionTable kTransitionTable = TransitionTable(kStates, {},
+        kHaltingStateNames);
+    REQUIRE(kTransitionTable.GetStateIndex(kHaltingState) == 2);
+  }
+}
+
+TEST_CASE("Test Transitions Are Correctly Compiled") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kStateTwo = State(2, "q2",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const std::vector<State> kStates = {kStartingState, kStateTwo};
+  const Direction kDirectionOne = Direction('0', '1', 'l',
+      kStartingState, kStateTwo);
+  const Direction kDirectionTwo = Direction('1', 'x', 'R',
+      kStartingState, kStartingState);
+  const Direction kDirectionThree = Direction('0', '0', 'n',
+      kStateTwo, kStartingState);
+  const TransitionTable kTransitionTable = TransitionTable(kStates,
+      {kDirectionOne, kDirectionTwo, kDirectionThree}, kHaltingStateNames);
+
+  SECTION("Test Read Characters", "[initialization][columns]") {
+    REQUIRE(kTransitionTable.GetReadCharacters() == std::vector<char>({'0',
+        '1'}));
+  }
+
+  SECTION("Test Left Movement", "[transition][left]") {
+    const Transition &kTransition = kTransitionTable.GetTransition(0, '0');
+    REQUIRE(kTransition.is_defined);
+    REQUIRE(kTransition.write == '1');
+    REQUIRE(kTransition.scanner_offset == -1);
+    REQUIRE(kTransition.state_to_move_to == 1);
+  }
+
+  SECTION("Test Right Movement", "[transition][right]") {
+    const Transition &kTransition = kTransitionTable.GetTransition(0, '1');
+    REQUIRE(kTransition.is_defined);
+    REQUIRE(kTransition.write == 'x');
+    REQUIRE(kTransition.scanner_offset == 1);
+    REQUIRE(kTransition.state_to_move_to == 0);
+  }
+
+  SECTION("Test No Movement", "[transition][no move]") {
+    const Transition &kTransition = kTransitionTable.GetTransition(1, '0');
+    REQUIRE(kTransition.is_defined);
+    REQUIRE(kTransition.write == '0');
+    REQUIRE(kTransition.scanner_offset == 0);
+    REQUIRE(kTransition.state_to_move_to == 0);
+  }
+
+  SECTION("Test Read Character Without Direction From State",
+      "[transition][undefined]") {
+    REQUIRE(kTransitionTable.GetTransition(1, '1').is_defined == false);
+  }
+
+  SECTION("Test Character No Direction Reads", "[transition][undefined]") {
+    REQUIRE(kTransitionTable.GetTransition(0, '-').is_defined == false);
+    REQUIRE(kTransitionTable.GetTransition(1, '\xff').is_defined == false);
+  }
+}
+
+TEST_CASE("Test Halting States Are Correctly Marked") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kAcceptState = State(2, "qAccept",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const State kRejectState = State(3, "qReject",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+
+  SECTION("Test Halting And Non-Halting States", "[halting states]") {
+    const std::vector<State> kStates = {kStartingState, kAcceptState};
+    const TransitionTable kTransitionTable = TransitionTable(kStates, {},
+        kHaltingStateNames);
+    REQUIRE(kTransitionTable.IsHaltingState(0) == false);
+    REQUIRE(kTransitionTable.IsHaltingState(1));
+  }
+
+  SECTION("Test Halting State Only In Directions", "[halting states]") {
+    const std::vector<State> kStates = {kStartingState};
+    const Direction kDirection = Direction('0', '1', 'r', kStartingState,
+        kRejectState);
+    const TransitionTable kTransitionTable = TransitionTable(kStates,
+        {kDirection}, kHaltingStateNames);
+    REQUIRE(kTransitionTable.IsHaltingState(1));
+  }
+}
+
+TEST_CASE("Test Sweep Transitions Are Correctly Detected") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kStateTwo = State(2, "q2",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const State kHaltingState = State(3, "qh",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const TransitionTable kTransitionTable = TransitionTable({kStartingState,
+      kStateTwo, kHaltingState}, {
+      Direction('1', '1', 'r', kStartingState, kStartingState),
+      Direction('0', '0', 'l', kStartingState, kStartingState),
+      Direction('-', '-', 'n', kStartingState, kStartingState),
+      Direction('1', '0', 'r', kStateTwo, kStateTwo),
+      Direction('0', '0', 'r', kStateTwo, kStartingState),
+      Direction('1', '1', 'r', kHaltingState, kHaltingState)},
+      kHaltingStateNames);
+
+  SECTION("Test Sweeps In Both Directions", "[sweep]") {
+    REQUIRE(kTransitionTable.GetTransition(0, '1').is_sweep);
+    REQUIRE(kTransitionTable.GetTransition(0, '0').is_sweep);
+  }
+
+  SECTION("Test Transitions That Are Not Sweeps", "[sweep]") {
+    // no movement, a changed cell, a changed state, and a halting state
+    REQUIRE(kTransitionTable.GetTransition(0, '-').is_sweep == false);
+    REQUIRE(kTransitionTable.GetTransition(1, '1').is_sweep == false);
+    REQUIRE(kTransitionTable.GetTransition(1, '0').is_sweep == false);
+    REQUIRE(kTransitionTable.GetTransition(2, '1').is_sweep == false);
+  }
+}
+
+TEST_CASE("Test Chains Of Transitions Are Correctly Fused") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kJumpState = State(4, "q4", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kLoopState = State(5, "q5", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(6, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const TransitionTable kTransitionTable = TransitionTable({kStateA, kStateB,
+      kStateC, kJumpState, kLoopState, kHaltingState}, {
+      Direction('0', '1', 'n', kStateA, kStateB),
+      Direction('1', '1', 'r', kStateA, kStateA),
+      Direction('-', '-', 'n', kStateA, kHaltingState),
+      Direction('1', '0', 'n', kStateB, kStateC),
+      Direction('0', '1', 'r', kStateC, kJumpState),
+      Direction('0', '0', 'n', kJumpState, kStateA),
+      Direction('1', '1', 'n', kJumpState, kStateA),
+      Direction('-', '-', 'n', kJumpState, kStateA),
+      Direction('0', '0', 'n', kLoopState, kLoopState),
+      Direction('1', 'x', 'n', kLoopState, kLoopState)},
+      kHaltingStateNames);
+
+  SECTION("Test Chain Of Stays Into A Jump State", "[fuse][jump]") {
+    // A writes 1 and stays, B reads it, writes 0 and stays, C reads it,
+    // writes 1 and moves into the jump state, which goes back to A
+    const FusedTransition &kFusedTransition =
+        kTransitionTable.GetFusedTransition(0, '0');
+    REQUIRE(kFusedTransition.num_steps == 4);
+    REQUIRE(kFusedTransition.num_steps_before_jumps == 3);
+    REQUIRE(kFusedTransition.first_jump_state == 3);
+    REQUIRE(kFusedTransition.transition.write == '1');
+    REQUIRE(kFusedTransition.transition.scanner_offset == 1);
+    REQUIRE(kFusedTransition.transition.state_to_move_to == 0);
+  }
+
+  SECTION("Test Single Transitions Stay Single", "[fuse]") {
+    const FusedTransition &kSweep = kTransitionTable.GetFusedTransition(0,
+        '1');
+    REQUIRE(kSweep.num_steps == 1);
+    REQUIRE(kSweep.transition.is_sweep);
+    // a halting state ends the chain
+    const FusedTransition &kHalt = kTransitionTable.GetFusedTransition(0, '-');
+    REQUIRE(kHalt.num_steps == 1);
+    REQUIRE(kHalt.transition.state_to_move_to == 5);
+    REQUIRE(kTransitionTable.GetFusedTransition(1, '0').transition.is_defined
+        == false);
+  }
+
+  SECTION("Test Chain Starting In The Middle", "[fuse][jump]") {
+    const FusedTransition &kFusedTransition =
+        kTransitionTable.GetFusedTransition(1, '1');
+    REQUIRE(kFusedTransition.num_steps == 3);
+    REQUIRE(kFusedTransition.transition.state_to_move_to == 0);
+  }
+
+  SECTION("Test Chain Ending Without A Direction", "[fuse]") {
+    // no direction reads the x written, so the machine stops after 1 step
+    const FusedTransition &kFusedTransition =
+        kTransitionTable.GetFusedTransition(4, '1');
+    REQUIRE(kFusedTransition.num_steps == 1);
+    REQUIRE(kFusedTransition.transition.write == 'x');
+  }
+
+  SECTION("Test Endless Chain Is Cut Off", "[fuse]") {
+    const FusedTransition &kFusedTransition =
+        kTransitionTable.GetFusedTransition(4, '0');
+    REQUIRE(kFusedTransition.num_steps == 64);
+    REQUIRE(kFusedTransition.transition.state_to_move_to == 4);
+  }
+}
+
+TEST_CASE("Test States Are Correctly Reordered") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  TransitionTable transition_table = TransitionTable({kStateA, kStateB,
+      kHaltingState}, {Direction('0', '1', 'r', kStateA, kStateB),
+      Direction('1', '1', 'n', kStateB, kHaltingState)}, kHaltingStateNames);
+
+  SECTION("Test Rows And Targets Move Together", "[reorder]") {
+    transition_table.ReorderStates({2, 0, 1});
+    REQUIRE(transition_table.GetState(0).Equals(kHaltingState));
+    REQUIRE(transition_table.GetStateIndex(kStateA) == 1);
+    REQUIRE(transition_table.IsHaltingState(0));
+    REQUIRE(transition_table.GetTransition(1, '0').state_to_move_to == 2);
+    REQUIRE(transition_table.GetTransition(2, '1').state_to_move_to == 0);
+    REQUIRE(transition_table.GetFusedTransition(2, '1').transition
+        .state_to_move_to == 0);
+  }
+
+  SECTION("Test Order That Is Not A Permutation", "[reorder][invalid]") {
+    transition_table.ReorderStates({0, 0, 1});
+    transition_table.ReorderStates({0, 1});
+    REQUIRE(transition_table.GetState(0).Equals(kStateA));
+    REQUIRE(transition_table.GetTransition(0, '0').state_to_move_to == 1);
+  }
+}
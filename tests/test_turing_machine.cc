@@ -8,6 +8,10 @@ using namespace turingmachinesimulator;
  * Partitions testing as follows:
  * Constructor Properly Creates Turing Machine 
  * Turing Machine Correctly Updates
+ * Turing Machine Correctly Runs Batches Of Steps
+ * Views Of The Turing Machine Match The Copying Getters
+ * Blank Margins Keep The Tape Of A Drifting Machine Small
+ * Turing Machine Runs On Generated Tapes
  * Configuration Is Produced Correctly For The Console
  * Configuration Is Produced Correctly For Markdown Files
  */
@@ -47,6 +51,7 @@ TEST_CASE("Test Turing Machine Creation") {
     REQUIRE(kTuringMachine.IsEmpty());
     REQUIRE(kTuringMachine.GetErrorMessage() 
         == "Cannot Have More Than 1 Starting State");
+    REQUIRE(kTuringMachine.GetCurrentState().Equals(kStartingState));
   }
   
   SECTION("Test No States", "[initialization][empty][error]") {
@@ -75,6 +80,8 @@ TEST_CASE("Test Turing Machine Creation") {
     REQUIRE(kTuringMachine.IsEmpty());
     REQUIRE(kTuringMachine.GetErrorMessage() == "Must Not Have 2 Directions With"
         " Same Read Condition From The Same State");
+    // the starting state was found before the directions were rejected
+    REQUIRE(kTuringMachine.GetCurrentState().Equals(kStartingState));
   }
   
   SECTION("Test Correct Inputs", "[initialization][empty][direction map]") {
@@ -356,6 +363,26 @@ TEST_CASE("Test Turing Machine Correctly Updates") {
     REQUIRE(turing_machine.GetCurrentState().Equals(kStateTwo));
   }
   
+  SECTION("Test Turing Machine Where Tape Expands At Front Many Times",
+      "[update][tape expansion][left][self loop]") {
+    const std::vector<State> kStates = {kStartingState, kStateTwo, kHaltingState};
+    const Direction kDirectionOne = Direction('-', '1', 'l',
+        kStartingState, kStartingState);
+    const std::vector<Direction> kDirections = {kDirectionOne};
+    const std::vector<char> kTape = {'-'};
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+        kTape, kBlankChar, kHaltingStateNames);
+    const size_t kNumUpdates = 100000;
+    for (size_t i = 0; i < kNumUpdates; i++) {
+      turing_machine.Update();
+    }
+    const std::vector<char> kFinalTape = turing_machine.GetTape();
+    REQUIRE(kFinalTape.size() == kNumUpdates + 1);
+    REQUIRE(kFinalTape.front() == '-');
+    REQUIRE(kFinalTape.back() == '1');
+    REQUIRE(turing_machine.GetIndexOfScanner() == 0);
+  }
+  
   SECTION("Test Turing Machine Where Tape Needs To Expand At End", "[update]"
       "[right][tape expansion]") {
     const std::vector<State> kStates = {kStartingState, kStateTwo, kHaltingState};
@@ -455,6 +482,273 @@ TEST_CASE("Test Turing Machine Correctly Updates") {
   }
 }
 
+TEST_CASE("Test Turing Machine Correctly Runs Batches Of Steps") {
+  const char kBlankChar = '-';
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1",
+      glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kStateTwo = State(2, "q2",
+      glm::vec2(0, 0), 6, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh",
+      glm::vec2(5, 6), 3, kHaltingStateNames);
+  const std::vector<State> kStates = {kStartingState, kStateTwo, kHaltingState};
+  const Direction kDirectionOne = Direction('0', '1', 'l',
+      kStartingState, kStateTwo);
+  const Direction kDirectionTwo = Direction('1', '1', 'r',
+      kStartingState, kStartingState);
+  const Direction kDirectionThree = Direction('-', '1', 'r',
+      kStartingState, kHaltingState);
+  const Direction kDirectionFour= Direction('-', '1', 'n',
+      kStateTwo, kStartingState);
+  const std::vector<Direction> kDirections = {kDirectionOne, kDirectionTwo,
+      kDirectionThree, kDirectionFour};
+  const std::vector<char> kTape = {'0', '-'};
+  TuringMachine turing_machine = TuringMachine(kStates, kDirections,
+      kTape, kBlankChar, kHaltingStateNames);
+  
+  SECTION("Test Empty Turing Machine", "[run][empty]") {
+    TuringMachine empty_turing_machine = TuringMachine();
+    const RunResult kResult = empty_turing_machine.Run(10);
+    REQUIRE(kResult.num_steps == 0);
+    REQUIRE(kResult.is_halted == false);
+  }
+  
+  SECTION("Test Run Matches Updates", "[run][update]") {
+    TuringMachine updated_turing_machine = turing_machine;
+    for (int i = 0; i < 3; i++) {
+      updated_turing_machine.Update();
+    }
+    const RunResult kResult = turing_machine.Run(3);
+    REQUIRE(kResult.num_steps == 3);
+    REQUIRE(kResult.is_halted == false);
+    REQUIRE(kResult.final_state_id == kStartingState.GetId());
+    REQUIRE(kResult.index_of_scanner == 1);
+    REQUIRE(turing_machine.GetTape() == updated_turing_machine.GetTape());
+    REQUIRE(turing_machine.GetConfigurationForConsole() 
+        == updated_turing_machine.GetConfigurationForConsole());
+    REQUIRE(turing_machine.GetNumberOfSteps() == 3);
+    REQUIRE(updated_turing_machine.GetNumberOfSteps() == 3);
+  }
+  
+  SECTION("Test Run Stops When No Direction Applies", "[run][halt]") {
+    const RunResult kResult = turing_machine.Run(100);
+    REQUIRE(kResult.num_steps == 5);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(kResult.index_of_scanner == 3);
+    REQUIRE(turing_machine.GetTape() == std::vector<char>({'1', '1', '1', 
+        '-'}));
+  }
+  
+  SECTION("Test Run Continues After Multiple Batches", "[run]") {
+    turing_machine.Run(2);
+    const RunResult kResult = turing_machine.Run(2);
+    REQUIRE(kResult.num_steps == 2);
+    REQUIRE(turing_machine.GetNumberOfSteps() == 4);
+    REQUIRE(turing_machine.GetConfigurationForConsole() == ";11q1-");
+  }
+  
+  SECTION("Test Run Until Halt Stops At Halting State", "[run][halt]") {
+    // a halting state with a direction out of it keeps running with Run but
+    // not with RunUntilHalt
+    const Direction kDirectionFive = Direction('-', '-', 'r', kHaltingState,
+        kHaltingState);
+    TuringMachine looping_turing_machine = TuringMachine(kStates, {
+        kDirectionOne, kDirectionTwo, kDirectionThree, kDirectionFour, 
+        kDirectionFive}, kTape, kBlankChar, kHaltingStateNames);
+    TuringMachine running_turing_machine = looping_turing_machine;
+    
+    const RunResult kHaltResult = looping_turing_machine.RunUntilHalt(100);
+    REQUIRE(kHaltResult.num_steps == 5);
+    REQUIRE(kHaltResult.is_halted);
+    
+    const RunResult kRunResult = running_turing_machine.Run(100);
+    REQUIRE(kRunResult.num_steps == 100);
+    REQUIRE(kRunResult.is_halted);
+  }
+  
+  SECTION("Test Run Until Halt Respects Step Budget", "[run]") {
+    const RunResult kResult = turing_machine.RunUntilHalt(4);
+    REQUIRE(kResult.num_steps == 4);
+    REQUIRE(kResult.is_halted == false);
+    REQUIRE(turing_machine.GetConfigurationForConsole() == ";11q1-");
+  }
+
+  SECTION("Test Skipped Sweeps Match A Reference Stepper",
+      "[run][sweep][left][right]") {
+    // steps 1 cell at a time on an explicit vector and never skips a sweep,
+    // so it checks the run loop independently of its sweep skipping
+    const auto kRunReference = [&](const std::vector<Direction> &directions,
+        std::vector<char> &cells, size_t &index_of_scanner, State &state,
+        uint64_t num_steps) {
+      for (uint64_t step = 0; step < num_steps; step++) {
+        for (const Direction &kDirection : directions) {
+          if (!kDirection.GetStateToMoveFrom().Equals(state)
+              || kDirection.GetRead() != cells[index_of_scanner]) {
+            continue;
+          }
+          cells[index_of_scanner] = kDirection.GetWrite();
+          state = kDirection.GetStateToMoveTo();
+          if (kDirection.GetScannerMovement() == 'l') {
+            if (index_of_scanner == 0) {
+              cells.insert(cells.begin(), kBlankChar);
+            } else {
+              index_of_scanner -= 1;
+            }
+          } else if (kDirection.GetScannerMovement() == 'r') {
+            index_of_scanner += 1;
+            if (index_of_scanner == cells.size()) {
+              cells.push_back(kBlankChar);
+            }
+          }
+          break;
+        }
+      }
+    };
+    // the first machine sweeps back and forth over a growing block of 1s,
+    // the second bounces between the blank cells just past both edges of a
+    // fixed block, so most steps of a run are skipped sweep steps ending at
+    // the left or right edge of the tape
+    const std::vector<std::vector<Direction>> kMachines = {
+        {Direction('1', '1', 'r', kStartingState, kStartingState),
+        Direction('-', '1', 'l', kStartingState, kStateTwo),
+        Direction('1', '1', 'l', kStateTwo, kStateTwo),
+        Direction('-', '1', 'r', kStateTwo, kStartingState)},
+        {Direction('1', '1', 'r', kStartingState, kStartingState),
+        Direction('-', '-', 'l', kStartingState, kStateTwo),
+        Direction('1', '1', 'l', kStateTwo, kStateTwo),
+        Direction('-', '-', 'r', kStateTwo, kStartingState)}};
+    // odd budgets stopping just before, on, and just after each edge
+    const uint64_t kBudgets[] = {1, 3, 99, 101, 103, 199, 201, 203, 301, 303,
+        999, 2999};
+    for (const std::vector<Direction> &kDirections : kMachines) {
+      const std::vector<char> kTape = std::vector<char>(100, '1');
+      for (uint64_t budget : kBudgets) {
+        TuringMachine sweeping_turing_machine = TuringMachine(kStates,
+            kDirections, kTape, kBlankChar, kHaltingStateNames);
+        std::vector<char> reference_cells = kTape;
+        size_t reference_index_of_scanner = 0;
+        State reference_state = kStartingState;
+        kRunReference(kDirections, reference_cells,
+            reference_index_of_scanner, reference_state, budget);
+        const RunResult kResult = sweeping_turing_machine.Run(budget);
+        REQUIRE(kResult.num_steps == budget);
+        REQUIRE(sweeping_turing_machine.GetTape() == reference_cells);
+        REQUIRE(sweeping_turing_machine.GetIndexOfScanner()
+            == reference_index_of_scanner);
+        REQUIRE(sweeping_turing_machine.GetCurrentState().Equals(
+            reference_state));
+        REQUIRE(sweeping_turing_machine.GetNumberOfSteps() == budget);
+      }
+    }
+  }
+}
+
+TEST_CASE("Test Views Of The Turing Machine Match The Copying Getters") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(2, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Empty Turing Machine", "[view][empty]") {
+    const TuringMachine kTuringMachine = TuringMachine();
+    REQUIRE(kTuringMachine.GetCurrentStateId() == -1);
+    REQUIRE(kTuringMachine.GetTapeView().IsEmpty());
+    REQUIRE(kTuringMachine.GetHaltingStatesView().empty());
+    REQUIRE(kTuringMachine.GetDirectionsByStateMapView().empty());
+  }
+
+  SECTION("Test Views While Running", "[view][run]") {
+    TuringMachine turing_machine = TuringMachine({kStartingState,
+        kHaltingState}, {Direction('1', '0', 'l', kStartingState,
+        kStartingState), Direction('-', '1', 'n', kStartingState,
+        kHaltingState)}, {'1', '1'}, '-', kHaltingStateNames);
+    REQUIRE(turing_machine.GetCurrentStateId() == kStartingState.GetId());
+    REQUIRE(turing_machine.GetHaltingStatesView().size() == 1);
+    REQUIRE(&turing_machine.GetDirectionsByStateMapView()
+        == &turing_machine.GetProgram()->GetDirectionsByStateMap());
+    turing_machine.Run(3);
+    const TapeView kTapeView = turing_machine.GetTapeView();
+    REQUIRE(std::vector<char>(kTapeView.begin(), kTapeView.end())
+        == turing_machine.GetTape());
+    REQUIRE(kTapeView.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(turing_machine.GetCurrentStateId() == kHaltingState.GetId());
+  }
+}
+
+TEST_CASE("Test Blank Margins Keep The Tape Of A Drifting Machine Small") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kStateTwo = State(2, "q2", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // writes a 1, steps back to erase it, then moves on, so the machine drifts
+  // right forever leaving only blanks behind
+  TuringMachine turing_machine = TuringMachine({kStartingState, kStateTwo},
+      {Direction('-', '1', 'r', kStartingState, kStateTwo),
+      Direction('-', '-', 'l', kStateTwo, kStateTwo),
+      Direction('1', '-', 'r', kStateTwo, kStartingState)}, {}, '-',
+      kHaltingStateNames);
+  TuringMachine untrimmed_turing_machine = turing_machine;
+
+  SECTION("Test Tape Stays Small", "[trim][run]") {
+    turing_machine.SetMaxBlankMargin(16);
+    turing_machine.Run(300000);
+    untrimmed_turing_machine.Run(300000);
+    REQUIRE(turing_machine.GetTape().size() <= 128);
+    REQUIRE(untrimmed_turing_machine.GetTape().size() > 100000);
+    REQUIRE(turing_machine.GetPositionOfScanner()
+        == untrimmed_turing_machine.GetPositionOfScanner());
+    REQUIRE(turing_machine.GetCurrentStateId()
+        == untrimmed_turing_machine.GetCurrentStateId());
+  }
+}
+
+TEST_CASE("Test Turing Machine Runs On Generated Tapes") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(2, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  // appends a 1 to the end of a unary number
+  const std::vector<Direction> kDirections = {Direction('1', '1', 'r',
+      kStartingState, kStartingState), Direction('-', '1', 'n',
+      kStartingState, kHaltingState)};
+  const uint64_t kNumOnes = 100000;
+
+  SECTION("Test Generated Tape Matches The Stored Tape", "[generate][run]") {
+    TuringMachine turing_machine = TuringMachine({kStartingState,
+        kHaltingState}, kDirections, TapeGenerator({{{'1'}, kNumOnes}}), '-',
+        kHaltingStateNames);
+    REQUIRE(turing_machine.GetTape() == std::vector<char>({'1'}));
+    TuringMachine stored_turing_machine = TuringMachine({kStartingState,
+        kHaltingState}, kDirections, std::vector<char>(kNumOnes, '1'), '-',
+        kHaltingStateNames);
+    const RunResult kResult = turing_machine.RunUntilHalt(kNumOnes + 10);
+    stored_turing_machine.RunUntilHalt(kNumOnes + 10);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.num_steps == kNumOnes + 1);
+    REQUIRE(turing_machine.GetTape() == stored_turing_machine.GetTape());
+  }
+
+  SECTION("Test Proven Rules Fall Back To Steps", "[generate][run]") {
+    TuringMachine turing_machine = TuringMachine({kStartingState,
+        kHaltingState}, kDirections, TapeGenerator({{{'1'}, kNumOnes}}), '-',
+        kHaltingStateNames);
+    turing_machine.SetRunMode(RunMode::kProvenRules);
+    turing_machine.Run(10);
+    REQUIRE(turing_machine.GetPositionOfScanner() == 10);
+    REQUIRE(turing_machine.RunUntilHalt(kNumOnes).is_halted);
+    REQUIRE(turing_machine.GetTape().size() == kNumOnes + 1);
+  }
+}
+
 TEST_CASE("Test Configuration Output For Console") {
   const char kBlankChar = '-';
   const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
@@ -603,6 +897,17 @@ TEST_CASE("Test Configuration Output For Markdown Files") {
     REQUIRE(turing_machine.GetConfigurationForMarkdown()
         == kExpectedConfiguration);
   }
+
+  SECTION("Test State With An Empty Name", "[markdown configuration]") {
+    const State kUnnamedState = State(3, "", glm::vec2(2, 2), 5,
+        kHaltingStateNames);
+    TuringMachine unnamed_state_turing_machine = TuringMachine({kStartingState,
+        kUnnamedState}, {Direction('0', '0', 'n', kStartingState,
+        kUnnamedState)}, kTape, kBlankChar, kHaltingStateNames);
+    unnamed_state_turing_machine.Update();
+    REQUIRE(unnamed_state_turing_machine.GetConfigurationForMarkdown()
+        == ";q<sub></sub>0*");
+  }
   
   SECTION("Test Configuration Where State Name Is Just 'q'", 
       "[markdown configuration]") {
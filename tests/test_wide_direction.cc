@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+
+#include "wide_direction.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Wide Direction Is Correctly Created
+ */
+TEST_CASE("Test Wide Direction Is Correctly Created") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kState = State(1, "q1", glm::vec2(1, 1), 5, kHaltingStateNames);
+  const State kStateTwo = State(2, "q2", glm::vec2(1, 2), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Empty Symbol", "[initialization][empty]") {
+    REQUIRE(WideDirection("", "b", 'l', kState, kStateTwo).IsEmpty());
+    REQUIRE(WideDirection("a", "", 'l', kState, kStateTwo).IsEmpty());
+  }
+
+  SECTION("Test Scanner Movement Character Is Not l/r/n",
+      "[initialization][empty]") {
+    REQUIRE(WideDirection("a", "b", 'c', kState, kStateTwo).IsEmpty());
+  }
+
+  SECTION("Test Empty State", "[initialization][empty]") {
+    REQUIRE(WideDirection("a", "b", 'l', State(), kStateTwo).IsEmpty());
+    REQUIRE(WideDirection("a", "b", 'l', kState, State()).IsEmpty());
+  }
+
+  SECTION("Test All Information Is Correct", "[initialization]") {
+    const WideDirection kDirection = WideDirection("a0", "b1", 'R', kState,
+        kStateTwo);
+    REQUIRE(kDirection.IsEmpty() == false);
+    REQUIRE(kDirection.GetRead() == "a0");
+    REQUIRE(kDirection.GetWrite() == "b1");
+    REQUIRE(kDirection.GetScannerMovement() == 'r');
+    REQUIRE(kDirection.GetStateToMoveFrom().Equals(kState));
+    REQUIRE(kDirection.GetStateToMoveTo().Equals(kStateTwo));
+  }
+
+  SECTION("Test Widening A Direction", "[initialization]") {
+    const WideDirection kDirection = WideDirection(Direction('a', 'b', 'l',
+        kState, kStateTwo));
+    REQUIRE(kDirection.GetRead() == "a");
+    REQUIRE(kDirection.GetWrite() == "b");
+    REQUIRE(kDirection.GetScannerMovement() == 'l');
+    REQUIRE(WideDirection(Direction()).IsEmpty());
+  }
+}
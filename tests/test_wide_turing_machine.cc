@@ -0,0 +1,196 @@
+#include <catch2/catch.hpp>
+
+#include "turing_machine.h"
+#include "wide_turing_machine.h"
+
+using namespace turingmachinesimulator;
+
+/**
+ * Partitions Testing As Follows:
+ * Wide Turing Machine Is Correctly Created
+ * Wide Turing Machine Matches The Turing Machine
+ * Wide Turing Machine Runs Alphabets Of More Than 256 Symbols
+ */
+TEST_CASE("Test Wide Turing Machine Creation") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(1, 1), 5,
+      kHaltingStateNames);
+  const State kStateTwo = State(2, "q2", glm::vec2(1, 1), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(3, "qh", glm::vec2(1, 1), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Default Constructor", "[initialization][empty]") {
+    WideTuringMachine wide_turing_machine = WideTuringMachine();
+    REQUIRE(wide_turing_machine.IsEmpty());
+    REQUIRE(wide_turing_machine.GetTape().empty());
+    REQUIRE(wide_turing_machine.Run(10).num_steps == 0);
+  }
+
+  SECTION("Test No Starting State", "[initialization][empty]") {
+    const WideTuringMachine kWideTuringMachine = WideTuringMachine(
+        {kStateTwo}, {}, {}, "_", kHaltingStateNames);
+    REQUIRE(kWideTuringMachine.IsEmpty());
+    REQUIRE(kWideTuringMachine.GetErrorMessage() == "Must Have Starting State");
+  }
+
+  SECTION("Test 2 Directions With The Same Read Condition",
+      "[initialization][empty]") {
+    const WideTuringMachine kWideTuringMachine = WideTuringMachine(
+        {kStartingState}, {WideDirection("ab", "c", 'r', kStartingState,
+        kStartingState), WideDirection("ab", "d", 'l', kStartingState,
+        kStartingState)}, {}, "_", kHaltingStateNames);
+    REQUIRE(kWideTuringMachine.IsEmpty());
+    REQUIRE(kWideTuringMachine.GetErrorMessage() == "Must Not Have 2 "
+        "Directions With Same Read Condition From The Same State");
+  }
+
+  SECTION("Test Empty Direction", "[initialization][empty]") {
+    const WideTuringMachine kWideTuringMachine = WideTuringMachine(
+        {kStartingState}, {WideDirection()}, {}, "_", kHaltingStateNames);
+    REQUIRE(kWideTuringMachine.IsEmpty());
+  }
+
+  SECTION("Test Symbols Are Interned", "[initialization][symbols]") {
+    const WideTuringMachine kWideTuringMachine = WideTuringMachine(
+        {kStartingState, kHaltingState}, {WideDirection("1", "10", 'r',
+        kStartingState, kStartingState), WideDirection("_", "_", 'n',
+        kStartingState, kHaltingState)}, {"1", "x", "1"}, "_",
+        kHaltingStateNames);
+    const SymbolTable &kSymbolTable = kWideTuringMachine.GetSymbolTable();
+    REQUIRE(kWideTuringMachine.IsEmpty() == false);
+    REQUIRE(kSymbolTable.GetSize() == 4);
+    REQUIRE(kSymbolTable.GetId("_") == 0);
+    REQUIRE(kWideTuringMachine.GetBlankSymbol() == "_");
+    REQUIRE(kWideTuringMachine.GetTape() == std::vector<std::string>{"1", "x",
+        "1"});
+    // 4 symbols fit in the narrow cells
+    REQUIRE(kWideTuringMachine.IsTapeNarrow());
+    REQUIRE(kWideTuringMachine.GetTapeView().IsEmpty());
+    const BasicTapeView<NarrowSymbolId> kTapeView = kWideTuringMachine
+        .GetNarrowTapeView();
+    REQUIRE(kTapeView.GetSize() == 3);
+    REQUIRE(kTapeView[1] == kSymbolTable.GetId("x"));
+  }
+
+  SECTION("Test Configurations Print Symbols", "[configuration]") {
+    WideTuringMachine wide_turing_machine = WideTuringMachine(
+        {kStartingState, kStateTwo}, {WideDirection("ab", "cd", 'r',
+        kStartingState, kStateTwo)}, {"ab", "ef"}, "_", kHaltingStateNames);
+    REQUIRE(wide_turing_machine.GetConfigurationForConsole() == ";q1abef");
+    wide_turing_machine.Update();
+    REQUIRE(wide_turing_machine.GetConfigurationForConsole() == ";cdq2ef");
+    REQUIRE(wide_turing_machine.GetConfigurationForMarkdown()
+        == ";cdq<sub>2</sub>ef");
+  }
+}
+
+TEST_CASE("Test Wide Turing Machine Matches The Turing Machine") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStateA = State(1, "q1", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateB = State(2, "q2", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateC = State(3, "q3", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kStateD = State(4, "q4", glm::vec2(0, 0), 5, kHaltingStateNames);
+  const State kHaltingState = State(5, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const std::vector<State> kStates = {kStateA, kStateB, kStateC, kStateD,
+      kHaltingState};
+
+  SECTION("Test 4 State Busy Beaver", "[run][halt][left][right]") {
+    const std::vector<Direction> kDirections = {
+        Direction('0', '1', 'r', kStateA, kStateB),
+        Direction('1', '1', 'l', kStateA, kStateB),
+        Direction('0', '1', 'l', kStateB, kStateA),
+        Direction('1', '0', 'l', kStateB, kStateC),
+        Direction('0', '1', 'r', kStateC, kHaltingState),
+        Direction('1', '1', 'l', kStateC, kStateD),
+        Direction('0', '1', 'r', kStateD, kStateD),
+        Direction('1', '0', 'r', kStateD, kStateA)};
+    std::vector<WideDirection> wide_directions;
+    for (const Direction &kDirection : kDirections) {
+      wide_directions.push_back(WideDirection(kDirection));
+    }
+    TuringMachine turing_machine = TuringMachine(kStates, kDirections, {'0'},
+        '0', kHaltingStateNames);
+    WideTuringMachine wide_turing_machine = WideTuringMachine(kStates,
+        wide_directions, {"0"}, "0", kHaltingStateNames);
+    const RunResult kResult = wide_turing_machine.RunUntilHalt(1000);
+    turing_machine.RunUntilHalt(1000);
+    REQUIRE(kResult.num_steps == 107);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.final_state_id == kHaltingState.GetId());
+    REQUIRE(wide_turing_machine.GetConfigurationForConsole()
+        == turing_machine.GetConfigurationForConsole());
+    REQUIRE(wide_turing_machine.GetIndexOfScanner()
+        == turing_machine.GetIndexOfScanner());
+    REQUIRE(wide_turing_machine.GetNumberOfSteps() == 107);
+  }
+}
+
+TEST_CASE("Test Wide Turing Machine Runs Alphabets Of More Than 256 Symbols") {
+  const std::vector<std::string> kHaltingStateNames = {"qh", "qAccept",
+      "qReject"};
+  const State kStartingState = State(1, "q1", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+  const State kHaltingState = State(2, "qh", glm::vec2(0, 0), 5,
+      kHaltingStateNames);
+
+  SECTION("Test Counting Through 1000 Symbols", "[run][symbols]") {
+    // each cell counts up from s0 to s999 and the machine moves right after
+    // every step, halting on the blank at the end of the tape
+    const size_t kNumSymbols = 1000;
+    std::vector<WideDirection> directions;
+    for (size_t i = 0; i + 1 < kNumSymbols; i++) {
+      directions.push_back(WideDirection("s" + std::to_string(i), "s"
+          + std::to_string(i + 1), 'r', kStartingState, kStartingState));
+    }
+    directions.push_back(WideDirection("_", "_", 'n', kStartingState,
+        kHaltingState));
+    std::vector<std::string> tape;
+    for (size_t i = 0; i < kNumSymbols - 1; i++) {
+      tape.push_back("s" + std::to_string(i));
+    }
+    WideTuringMachine wide_turing_machine = WideTuringMachine(
+        {kStartingState, kHaltingState}, directions, tape, "_",
+        kHaltingStateNames);
+    REQUIRE(wide_turing_machine.GetSymbolTable().GetSize() == kNumSymbols + 1);
+    const RunResult kResult = wide_turing_machine.RunUntilHalt(10000);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.num_steps == kNumSymbols);
+    const std::vector<std::string> kTape = wide_turing_machine.GetTape();
+    REQUIRE(kTape.size() == kNumSymbols);
+    REQUIRE(kTape[0] == "s1");
+    REQUIRE(kTape[kNumSymbols - 2] == "s999");
+    REQUIRE(kTape[kNumSymbols - 1] == "_");
+  }
+
+  SECTION("Test Alphabets Too Large For Narrow Cells", "[run][symbols]") {
+    // each step writes the next of 70000 symbols, which do not fit in a
+    // NarrowSymbolId, moving right and halting on the blank at the end
+    const size_t kNumSymbols = 70000;
+    std::vector<WideDirection> directions;
+    for (size_t i = 0; i + 1 < kNumSymbols; i++) {
+      directions.push_back(WideDirection("s" + std::to_string(i), "s"
+          + std::to_string(i + 1), 'r', kStartingState, kStartingState));
+    }
+    directions.push_back(WideDirection("_", "_", 'n', kStartingState,
+        kHaltingState));
+    WideTuringMachine wide_turing_machine = WideTuringMachine(
+        {kStartingState, kHaltingState}, directions, {"s69998", "s0"}, "_",
+        kHaltingStateNames);
+    REQUIRE(wide_turing_machine.IsTapeNarrow() == false);
+    REQUIRE(wide_turing_machine.GetNarrowTapeView().IsEmpty());
+    REQUIRE(wide_turing_machine.GetConfigurationForConsole() == ";q1s69998s0");
+    const RunResult kResult = wide_turing_machine.RunUntilHalt(10);
+    REQUIRE(kResult.is_halted);
+    REQUIRE(kResult.num_steps == 3);
+    REQUIRE(wide_turing_machine.GetTape() == std::vector<std::string>{
+        "s69999", "s1", "_"});
+    REQUIRE(wide_turing_machine.GetTapeView()[0]
+        == wide_turing_machine.GetSymbolTable().GetId("s69999"));
+    REQUIRE(wide_turing_machine.GetConfigurationForMarkdown()
+        == ";s69999s1q<sub>h</sub>_");
+  }
+}